@@ -0,0 +1,471 @@
+#ifndef GREGJM_ATOMIC_PAIR_HPP
+#define GREGJM_ATOMIC_PAIR_HPP
+
+#include "pair.hpp"
+
+#include <atomic> // std::atomic, std::memory_order, std::atomic_thread_fence
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstring> // std::memcpy, std::memcmp
+#include <type_traits>
+
+#if defined(__x86_64__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+// cmpxchg16b is not part of the x86-64 baseline; the compiler only advertises
+// it with -mcx16 or a -march that implies it
+#if defined(__x86_64__) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define GREGJM_ATOMIC_PAIR_HAS_CAS16 1
+#else
+#define GREGJM_ATOMIC_PAIR_HAS_CAS16 0
+#endif
+
+namespace gregjm {
+namespace detail {
+
+#if GREGJM_ATOMIC_PAIR_HAS_CAS16
+__extension__ typedef unsigned __int128 AtomicWord16;
+#endif
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+enum class AtomicPairStrategy {
+    Word8,
+    Word16,
+    SeqLock
+};
+
+template <typename T>
+static constexpr inline AtomicPairStrategy atomic_pair_strategy_v =
+    sizeof(T) <= 8 ? AtomicPairStrategy::Word8
+    : sizeof(T) <= 16 && GREGJM_ATOMIC_PAIR_HAS_CAS16
+        ? AtomicPairStrategy::Word16
+        : AtomicPairStrategy::SeqLock;
+
+// value bytes are copied into a zeroed word, so the bytes past the end of a
+// value smaller than the word always compare equal
+template <typename Word, typename T>
+Word to_word(const T &value) noexcept {
+    Word word{ };
+    std::memcpy(static_cast<void*>(&word), static_cast<const void*>(&value),
+                sizeof(T));
+
+    return word;
+}
+
+template <typename T, typename Word>
+T from_word(const Word &word) noexcept {
+    T value;
+    std::memcpy(static_cast<void*>(&value), static_cast<const void*>(&word),
+                sizeof(T));
+
+    return value;
+}
+
+template <typename T, AtomicPairStrategy = atomic_pair_strategy_v<T>>
+class AtomicPairStorage;
+
+// values of up to eight bytes fit in a std::atomic<std::uint64_t>, which is
+// lock-free on every 64-bit target
+template <typename T>
+class AtomicPairStorage<T, AtomicPairStrategy::Word8> {
+public:
+    static constexpr inline bool is_always_lock_free =
+        std::atomic<std::uint64_t>::is_always_lock_free;
+
+    explicit AtomicPairStorage(const T &value) noexcept
+    : word_{ to_word<std::uint64_t>(value) } { }
+
+    T load(std::memory_order order) const noexcept {
+        return from_word<T>(word_.load(order));
+    }
+
+    void store(const T &desired, std::memory_order order) noexcept {
+        word_.store(to_word<std::uint64_t>(desired), order);
+    }
+
+    T exchange(const T &desired, std::memory_order order) noexcept {
+        return from_word<T>(
+            word_.exchange(to_word<std::uint64_t>(desired), order)
+        );
+    }
+
+    bool compare_exchange_weak(T &expected, const T &desired,
+                               std::memory_order success,
+                               std::memory_order failure) noexcept {
+        auto expected_word = to_word<std::uint64_t>(expected);
+
+        if (word_.compare_exchange_weak(expected_word,
+                                        to_word<std::uint64_t>(desired),
+                                        success, failure)) {
+            return true;
+        }
+
+        expected = from_word<T>(expected_word);
+
+        return false;
+    }
+
+    bool compare_exchange_strong(T &expected, const T &desired,
+                                 std::memory_order success,
+                                 std::memory_order failure) noexcept {
+        auto expected_word = to_word<std::uint64_t>(expected);
+
+        if (word_.compare_exchange_strong(expected_word,
+                                          to_word<std::uint64_t>(desired),
+                                          success, failure)) {
+            return true;
+        }
+
+        expected = from_word<T>(expected_word);
+
+        return false;
+    }
+
+private:
+    std::atomic<std::uint64_t> word_;
+};
+
+#if GREGJM_ATOMIC_PAIR_HAS_CAS16
+// lock cmpxchg16b through the __sync builtins, which gcc and clang inline;
+// std::atomic of a 16 byte type calls into libatomic instead. every write is
+// a full barrier, so the requested memory orders are always satisfied.
+// Intel and AMD guarantee that aligned 16 byte vector loads are atomic on
+// processors with AVX, so load is a single vmovdqa there; without AVX it is a
+// compare-exchange that writes back the value it found
+template <typename T>
+class AtomicPairStorage<T, AtomicPairStrategy::Word16> {
+public:
+    static constexpr inline bool is_always_lock_free = true;
+
+    explicit AtomicPairStorage(const T &value) noexcept
+    : word_{ to_word<AtomicWord16>(value) } { }
+
+    T load(std::memory_order) const noexcept {
+        return from_word<T>(load_word());
+    }
+
+    void store(const T &desired, std::memory_order order) noexcept {
+        exchange(desired, order);
+    }
+
+    T exchange(const T &desired, std::memory_order) noexcept {
+        const auto desired_word = to_word<AtomicWord16>(desired);
+        AtomicWord16 current = load_word();
+
+        for (;;) {
+            const AtomicWord16 found =
+                __sync_val_compare_and_swap(&word_, current, desired_word);
+
+            if (found == current) {
+                return from_word<T>(found);
+            }
+
+            current = found;
+        }
+    }
+
+    bool compare_exchange_weak(T &expected, const T &desired,
+                               std::memory_order success,
+                               std::memory_order failure) noexcept {
+        return compare_exchange_strong(expected, desired, success, failure);
+    }
+
+    bool compare_exchange_strong(T &expected, const T &desired,
+                                 std::memory_order,
+                                 std::memory_order) noexcept {
+        const auto expected_word = to_word<AtomicWord16>(expected);
+        const AtomicWord16 found = __sync_val_compare_and_swap(
+            &word_, expected_word, to_word<AtomicWord16>(desired)
+        );
+
+        if (found == expected_word) {
+            return true;
+        }
+
+        expected = from_word<T>(found);
+
+        return false;
+    }
+
+private:
+    AtomicWord16 load_word() const noexcept {
+#if defined(__AVX__)
+        __m128i vector;
+        __asm__ __volatile__("vmovdqa %1, %0"
+                             : "=x"(vector) : "m"(word_) : "memory");
+
+        return from_word<AtomicWord16>(vector);
+#else
+        return __sync_val_compare_and_swap(&word_, AtomicWord16{ },
+                                           AtomicWord16{ });
+#endif
+    }
+
+    alignas(16) mutable AtomicWord16 word_;
+};
+#endif
+
+// for values too large for a single compare-exchange. writers serialize on
+// the low bit of the sequence and bump it twice per write; readers copy the
+// value and retry if the sequence was odd or changed in the meantime. the
+// value is kept in relaxed atomic words so that racing reads are not data
+// races. a seq_cst operation makes its accesses to the sequence seq_cst, so
+// it is ordered with every other seq_cst operation; weaker orders get
+// acquire loads and acquire-release writes. nothing is lock-free
+template <typename T>
+class AtomicPairStorage<T, AtomicPairStrategy::SeqLock> {
+public:
+    static constexpr inline bool is_always_lock_free = false;
+
+    explicit AtomicPairStorage(const T &value) noexcept : sequence_{ 0 } {
+        write(to_words(value));
+    }
+
+    T load(std::memory_order order) const noexcept {
+        for (;;) {
+            const std::uint64_t before =
+                sequence_.load(at_least(order, std::memory_order_acquire));
+
+            if (before % 2 != 0) {
+                cpu_relax();
+
+                continue;
+            }
+
+            const Words words = read();
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                return from_words(words);
+            }
+        }
+    }
+
+    void store(const T &desired, std::memory_order order) noexcept {
+        const std::uint64_t sequence = lock(order);
+        write(to_words(desired));
+        unlock(sequence, order);
+    }
+
+    T exchange(const T &desired, std::memory_order order) noexcept {
+        const std::uint64_t sequence = lock(order);
+        const Words previous = read();
+        write(to_words(desired));
+        unlock(sequence, order);
+
+        return from_words(previous);
+    }
+
+    bool compare_exchange_weak(T &expected, const T &desired,
+                               std::memory_order success,
+                               std::memory_order failure) noexcept {
+        return compare_exchange_strong(expected, desired, success, failure);
+    }
+
+    bool compare_exchange_strong(T &expected, const T &desired,
+                                 std::memory_order success,
+                                 std::memory_order failure) noexcept {
+        const Words expected_words = to_words(expected);
+        const std::memory_order order =
+            failure == std::memory_order_seq_cst ? failure : success;
+
+        const std::uint64_t sequence = lock(order);
+        const Words current = read();
+        const bool matches = std::memcmp(&current, &expected_words,
+                                         sizeof(Words)) == 0;
+
+        if (matches) {
+            write(to_words(desired));
+        }
+
+        unlock(sequence, order);
+
+        if (!matches) {
+            expected = from_words(current);
+        }
+
+        return matches;
+    }
+
+private:
+    static constexpr inline std::size_t num_words =
+        (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    struct Words {
+        std::uint64_t words[num_words];
+    };
+
+    static Words to_words(const T &value) noexcept {
+        return to_word<Words>(value);
+    }
+
+    static T from_words(const Words &words) noexcept {
+        return from_word<T>(words);
+    }
+
+    // seq_cst if that was requested, and otherwise the order the seqlock
+    // needs
+    static constexpr std::memory_order
+    at_least(std::memory_order requested, std::memory_order order) noexcept {
+        return requested == std::memory_order_seq_cst ? requested : order;
+    }
+
+    // returns the even sequence number seen before the lock was taken
+    std::uint64_t lock(std::memory_order order) noexcept {
+        std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            if (sequence % 2 != 0) {
+                cpu_relax();
+                sequence = sequence_.load(std::memory_order_relaxed);
+            } else if (sequence_.compare_exchange_weak(
+                           sequence, sequence + 1,
+                           at_least(order, std::memory_order_acquire),
+                           std::memory_order_relaxed
+                       )) {
+                std::atomic_thread_fence(std::memory_order_release);
+
+                return sequence;
+            }
+        }
+    }
+
+    void unlock(std::uint64_t sequence, std::memory_order order) noexcept {
+        sequence_.store(sequence + 2,
+                        at_least(order, std::memory_order_release));
+    }
+
+    Words read() const noexcept {
+        Words result;
+
+        for (std::size_t i = 0; i < num_words; ++i) {
+            result.words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+
+        return result;
+    }
+
+    void write(const Words &values) noexcept {
+        for (std::size_t i = 0; i < num_words; ++i) {
+            words_[i].store(values.words[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<std::uint64_t> sequence_;
+    std::atomic<std::uint64_t> words_[num_words];
+};
+
+} // namespace detail
+
+// std::atomic for a whole Pair, such as a pointer and its version counter.
+// pairs of up to eight bytes use a std::atomic<std::uint64_t>, pairs of up to
+// sixteen bytes use cmpxchg16b where it is available, and anything else falls
+// back to a seqlock. like std::atomic, values are compared by their bytes, so
+// padding inside a member can make compare_exchange fail on equal values
+template <typename First, typename Second>
+class AtomicPair {
+public:
+    using value_type = Pair<First, Second>;
+
+    static_assert(std::is_trivially_copyable_v<value_type>,
+                  "AtomicPair requires trivially copyable members");
+
+    static constexpr inline bool is_always_lock_free =
+        detail::AtomicPairStorage<value_type>::is_always_lock_free;
+
+    // value-initializes the pair, like std::atomic in C++20
+    AtomicPair() noexcept : storage_{ value_type{ } } { }
+
+    AtomicPair(value_type desired) noexcept : storage_{ desired } { }
+
+    AtomicPair(const AtomicPair &other) = delete;
+
+    AtomicPair& operator=(const AtomicPair &other) = delete;
+
+    value_type operator=(value_type desired) noexcept {
+        store(desired);
+
+        return desired;
+    }
+
+    operator value_type() const noexcept {
+        return load();
+    }
+
+    bool is_lock_free() const noexcept {
+        return is_always_lock_free;
+    }
+
+    value_type load(std::memory_order order = std::memory_order_seq_cst) const
+    noexcept {
+        return storage_.load(order);
+    }
+
+    void store(value_type desired,
+               std::memory_order order = std::memory_order_seq_cst) noexcept {
+        storage_.store(desired, order);
+    }
+
+    value_type exchange(value_type desired,
+                        std::memory_order order = std::memory_order_seq_cst)
+    noexcept {
+        return storage_.exchange(desired, order);
+    }
+
+    bool compare_exchange_weak(value_type &expected, value_type desired,
+                               std::memory_order success,
+                               std::memory_order failure) noexcept {
+        return storage_.compare_exchange_weak(expected, desired, success,
+                                              failure);
+    }
+
+    bool compare_exchange_weak(
+        value_type &expected, value_type desired,
+        std::memory_order order = std::memory_order_seq_cst
+    ) noexcept {
+        return compare_exchange_weak(expected, desired, order,
+                                     failure_order(order));
+    }
+
+    bool compare_exchange_strong(value_type &expected, value_type desired,
+                                 std::memory_order success,
+                                 std::memory_order failure) noexcept {
+        return storage_.compare_exchange_strong(expected, desired, success,
+                                                failure);
+    }
+
+    bool compare_exchange_strong(
+        value_type &expected, value_type desired,
+        std::memory_order order = std::memory_order_seq_cst
+    ) noexcept {
+        return compare_exchange_strong(expected, desired, order,
+                                       failure_order(order));
+    }
+
+private:
+    // a failed compare-exchange is a load, which cannot have release
+    // semantics
+    static constexpr std::memory_order failure_order(std::memory_order order)
+    noexcept {
+        switch (order) {
+        case std::memory_order_acq_rel:
+            return std::memory_order_acquire;
+        case std::memory_order_release:
+            return std::memory_order_relaxed;
+        default:
+            return order;
+        }
+    }
+
+    detail::AtomicPairStorage<value_type> storage_;
+};
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef GREGJM_BENCH_HPP
+#define GREGJM_BENCH_HPP
+
+#include "perf_counters.hpp"
+
+#include <algorithm> // std::sort, std::max
+#include <array>
+#include <chrono> // std::chrono::steady_clock
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <cstdlib> // std::strtoul
+#include <iomanip> // std::setw, std::setprecision
+#include <iostream> // std::cout, std::cerr
+#include <memory> // std::unique_ptr, std::make_unique
+#include <string>
+#include <string_view>
+#include <utility> // std::forward
+#include <vector>
+
+namespace gregjm {
+namespace bench {
+
+// keeps the compiler from discarding the computation of value
+template <typename T>
+inline void do_not_optimize(const T &value) noexcept {
+    __asm__ __volatile__("" : : "r,m"(value) : "memory");
+}
+
+template <typename T>
+inline void do_not_optimize(T &value) noexcept {
+    __asm__ __volatile__("" : "+r,m"(value) : : "memory");
+}
+
+// forces all pending writes to memory to be considered observable
+inline void clobber_memory() noexcept {
+    __asm__ __volatile__("" : : : "memory");
+}
+
+// deterministic and cheap; benchmark inputs must not depend on the run
+class XorShift {
+public:
+    constexpr explicit XorShift(std::uint64_t seed = 0x9e3779b97f4a7c15)
+    noexcept : state_{ seed } { }
+
+    constexpr std::uint64_t operator()() noexcept {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 7;
+        state_ ^= state_ << 17;
+
+        return state_;
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+struct Options {
+    std::size_t warmup = 3;
+    std::size_t repetitions = 31;
+    bool counters = false;
+    std::string filter;
+};
+
+inline Options parse_options(int argc, const char *const argv[]) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+
+        if (arg.rfind("--warmup=", 0) == 0) {
+            options.warmup = std::strtoul(argv[i] + 9, nullptr, 10);
+        } else if (arg.rfind("--repetitions=", 0) == 0) {
+            options.repetitions = std::max<std::size_t>(
+                std::strtoul(argv[i] + 14, nullptr, 10), 1
+            );
+        } else if (arg == "--counters") {
+            options.counters = true;
+        } else {
+            options.filter = arg;
+        }
+    }
+
+    return options;
+}
+
+struct Summary {
+    double min;
+    double p10;
+    double median;
+    double p90;
+    double max;
+};
+
+// samples must be non-empty; uses nearest-rank percentiles
+inline Summary summarize(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+
+    const auto rank = [&samples](double percentile) {
+        const auto index = static_cast<std::size_t>(
+            percentile * static_cast<double>(samples.size() - 1) + 0.5
+        );
+
+        return samples[index];
+    };
+
+    return { samples.front(), rank(0.1), rank(0.5), rank(0.9),
+             samples.back() };
+}
+
+// runs each case warmup + repetitions times and reports the distribution of
+// the per-item cost, where a case processes `items` items per call. with
+// --counters, the median hardware counter values per item are reported too;
+// they cover every thread a case starts, provided it starts them after the
+// Runner is constructed
+class Runner {
+public:
+    explicit Runner(Options options) : options_{ std::move(options) } {
+        if (options_.counters) {
+            counters_ = std::make_unique<PerfCounters>();
+
+            if (!counters_->available()) {
+                std::cerr << "hardware counters are not available on this "
+                             "host; reporting timings only\n";
+                counters_.reset();
+            }
+        }
+
+        std::cout << std::left << std::setw(name_width) << "benchmark"
+                  << std::right << std::setw(column_width) << "median"
+                  << std::setw(column_width) << "p10"
+                  << std::setw(column_width) << "p90"
+                  << std::setw(column_width) << "min";
+
+        if (counters_) {
+            for (const char *name : counter_names) {
+                std::cout << std::setw(column_width) << name;
+            }
+
+            std::cout << "  (per item)\n";
+        } else {
+            std::cout << "  (ns/item)\n";
+        }
+    }
+
+    // whether run would run a case of this name, so that callers can skip
+    // building large inputs for cases that are filtered out
+    bool matches(std::string_view name) const noexcept {
+        return options_.filter.empty()
+               || name.find(options_.filter) != std::string_view::npos;
+    }
+
+    template <typename Body>
+    void run(std::string_view name, std::size_t items, Body &&body) {
+        run(name, items, [] { }, std::forward<Body>(body));
+    }
+
+    // setup is called before every timed call and is not timed itself
+    template <typename Setup, typename Body>
+    void run(std::string_view name, std::size_t items, Setup &&setup,
+             Body &&body) {
+        if (!matches(name)) {
+            return;
+        }
+
+        for (std::size_t i = 0; i < options_.warmup; ++i) {
+            setup();
+            body();
+        }
+
+        std::vector<double> samples;
+        samples.reserve(options_.repetitions);
+
+        std::array<std::vector<double>, num_counters> counter_samples;
+
+        for (std::size_t i = 0; i < options_.repetitions; ++i) {
+            setup();
+            clobber_memory();
+
+            if (counters_) {
+                counters_->start();
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            body();
+            clobber_memory();
+            const auto end = std::chrono::steady_clock::now();
+
+            if (counters_) {
+                counters_->stop();
+
+                const CounterValues values = counters_->read();
+
+                for (std::size_t j = 0; j < num_counters; ++j) {
+                    counter_samples[j].push_back(
+                        values[j] / static_cast<double>(items)
+                    );
+                }
+            }
+
+            const std::chrono::duration<double, std::nano> elapsed =
+                end - start;
+            samples.push_back(elapsed.count()
+                              / static_cast<double>(items));
+        }
+
+        report(name, summarize(std::move(samples)));
+
+        if (counters_) {
+            report_counters(counter_samples);
+        }
+
+        std::cout << '\n';
+    }
+
+private:
+    static constexpr inline int name_width = 40;
+    static constexpr inline int column_width = 10;
+
+    static void report(std::string_view name, const Summary &summary) {
+        std::cout << std::left << std::setw(name_width) << name << std::right
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(column_width) << summary.median
+                  << std::setw(column_width) << summary.p10
+                  << std::setw(column_width) << summary.p90
+                  << std::setw(column_width) << summary.min;
+    }
+
+    void report_counters(
+        std::array<std::vector<double>, num_counters> &samples
+    ) const {
+        std::cout << std::setprecision(2);
+
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            if (counters_->is_open(i)) {
+                std::cout << std::setw(column_width)
+                          << summarize(std::move(samples[i])).median;
+            } else {
+                std::cout << std::setw(column_width) << '-';
+            }
+        }
+    }
+
+    Options options_;
+    std::unique_ptr<PerfCounters> counters_;
+};
+
+} // namespace bench
+} // namespace gregjm
+
+#endif
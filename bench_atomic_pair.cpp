@@ -0,0 +1,147 @@
+#include "atomic_pair.hpp"
+#include "bench.hpp"
+#include "pair.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// every case runs a fixed number of operations on each of several threads
+// that share one pair, so the reported time per item is the inverse of the
+// aggregate throughput: ops/sec = 1e9 / (ns/item).
+//
+// std::atomic<std::pair<...>> does not compile, because std::pair's
+// assignment operators are user-provided and so it is not trivially copyable.
+// std::atomic<gregjm::Pair<...>> stands in for it; for sixteen bytes, gcc
+// implements it with calls into libatomic
+
+namespace {
+
+using gregjm::bench::do_not_optimize;
+using gregjm::bench::Runner;
+
+constexpr std::size_t ops_per_thread = 1 << 16;
+constexpr std::size_t loads_per_update = 7;
+
+using Versioned = gregjm::Pair<std::uint64_t, std::uint64_t>;
+
+constexpr Versioned next_version(const Versioned &current) noexcept {
+    return { current.first() + 1, current.second() + 3 };
+}
+
+class GregjmAtomic {
+public:
+    static constexpr const char *name = "gregjm::AtomicPair";
+
+    Versioned load() const noexcept {
+        return pair_.load();
+    }
+
+    void update() noexcept {
+        auto current = pair_.load();
+
+        while (!pair_.compare_exchange_weak(current, next_version(current))) { }
+    }
+
+private:
+    gregjm::AtomicPair<std::uint64_t, std::uint64_t> pair_;
+};
+
+class StdAtomic {
+public:
+    static constexpr const char *name = "std::atomic<Pair>";
+
+    Versioned load() const noexcept {
+        return pair_.load();
+    }
+
+    void update() noexcept {
+        auto current = pair_.load();
+
+        while (!pair_.compare_exchange_weak(current, next_version(current))) { }
+    }
+
+private:
+    std::atomic<Versioned> pair_{ Versioned{ 0, 0 } };
+};
+
+class Locked {
+public:
+    static constexpr const char *name = "std::mutex + Pair";
+
+    Versioned load() const {
+        const std::lock_guard<std::mutex> lock{ mutex_ };
+
+        return pair_;
+    }
+
+    void update() {
+        const std::lock_guard<std::mutex> lock{ mutex_ };
+
+        pair_ = next_version(pair_);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    Versioned pair_{ 0, 0 };
+};
+
+template <typename Shared, typename Operation>
+void bench_threads(Runner &runner, const char *operation,
+                   std::size_t num_threads, Operation op) {
+    const std::string name = std::string{ operation } + " x"
+                             + std::to_string(num_threads) + '/'
+                             + Shared::name;
+
+    runner.run(name, num_threads * ops_per_thread, [num_threads, &op] {
+        Shared shared;
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            threads.emplace_back([&shared, &op] {
+                for (std::size_t j = 0; j < ops_per_thread; ++j) {
+                    op(shared, j);
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        do_not_optimize(shared);
+    });
+}
+
+template <typename Shared>
+void bench_all(Runner &runner) {
+    for (const std::size_t num_threads : { 1, 2, 4 }) {
+        bench_threads<Shared>(runner, "update", num_threads,
+                              [](Shared &shared, std::size_t) {
+            shared.update();
+        });
+
+        bench_threads<Shared>(runner, "read-mostly", num_threads,
+                              [](Shared &shared, std::size_t i) {
+            if (i % (loads_per_update + 1) == 0) {
+                shared.update();
+            } else {
+                do_not_optimize(shared.load());
+            }
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Runner runner{ gregjm::bench::parse_options(argc, argv) };
+
+    bench_all<GregjmAtomic>(runner);
+    bench_all<StdAtomic>(runner);
+    bench_all<Locked>(runner);
+}
@@ -0,0 +1,149 @@
+#include "bench.hpp"
+#include "flat_map.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using gregjm::bench::do_not_optimize;
+using gregjm::bench::Runner;
+using gregjm::bench::XorShift;
+
+constexpr std::size_t map_size = 1 << 16;
+
+template <typename M>
+struct Named;
+
+template <typename K, typename V>
+struct Named<std::unordered_map<K, V>> {
+    static constexpr const char *name = "std::unordered_map";
+};
+
+template <typename K, typename V>
+struct Named<gregjm::FlatMap<K, V>> {
+    static constexpr const char *name = "gregjm::FlatMap";
+};
+
+template <typename M>
+std::string case_name(const char *operation) {
+    return std::string{ operation } + '/' + Named<M>::name;
+}
+
+// keys are below 2^24; offset lets two sets of keys be disjoint
+std::vector<std::uint64_t> random_keys(std::size_t size,
+                                       std::uint64_t offset) {
+    XorShift rng;
+    std::vector<std::uint64_t> keys;
+    keys.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        keys.push_back((rng() >> 40) + offset);
+    }
+
+    return keys;
+}
+
+template <typename M>
+M filled(const std::vector<std::uint64_t> &keys) {
+    M map;
+    map.reserve(keys.size());
+
+    for (const auto key : keys) {
+        map[key] = key;
+    }
+
+    return map;
+}
+
+template <typename M>
+void bench_insert(Runner &runner, const std::vector<std::uint64_t> &keys) {
+    runner.run(case_name<M>("insert"), keys.size(), [&keys] {
+        M map;
+
+        for (const auto key : keys) {
+            map.try_emplace(key, key);
+        }
+
+        do_not_optimize(map);
+    });
+
+    runner.run(case_name<M>("insert (reserved)"), keys.size(), [&keys] {
+        M map;
+        map.reserve(keys.size());
+
+        for (const auto key : keys) {
+            map.try_emplace(key, key);
+        }
+
+        do_not_optimize(map);
+    });
+}
+
+template <typename M>
+void bench_find(Runner &runner, const std::vector<std::uint64_t> &keys,
+                const std::vector<std::uint64_t> &misses) {
+    const M map = filled<M>(keys);
+
+    runner.run(case_name<M>("find (hit)"), keys.size(), [&map, &keys] {
+        std::uint64_t sum = 0;
+
+        for (const auto key : keys) {
+            using std::get;
+
+            sum += get<1>(*map.find(key));
+        }
+
+        do_not_optimize(sum);
+    });
+
+    runner.run(case_name<M>("find (miss)"), misses.size(),
+               [&map, &misses] {
+        std::size_t count = 0;
+
+        for (const auto key : misses) {
+            count += map.count(key);
+        }
+
+        do_not_optimize(count);
+    });
+}
+
+template <typename M>
+void bench_churn(Runner &runner, const std::vector<std::uint64_t> &keys) {
+    M map = filled<M>(keys);
+
+    runner.run(case_name<M>("erase + insert"), keys.size(), [&map, &keys] {
+        for (const auto key : keys) {
+            map.erase(key);
+            map.try_emplace(key + 1, key);
+            map.erase(key + 1);
+            map.try_emplace(key, key);
+        }
+
+        do_not_optimize(map);
+    });
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Runner runner{ gregjm::bench::parse_options(argc, argv) };
+
+    using StdMap = std::unordered_map<std::uint64_t, std::uint64_t>;
+    using FlatMap = gregjm::FlatMap<std::uint64_t, std::uint64_t>;
+
+    const auto keys = random_keys(map_size, 0);
+    const auto misses = random_keys(map_size, std::uint64_t{ 1 } << 24);
+
+    bench_insert<StdMap>(runner, keys);
+    bench_insert<FlatMap>(runner, keys);
+    bench_find<StdMap>(runner, keys, misses);
+    bench_find<FlatMap>(runner, keys, misses);
+    bench_churn<StdMap>(runner, keys);
+    bench_churn<FlatMap>(runner, keys);
+}
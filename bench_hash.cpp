@@ -0,0 +1,110 @@
+#include "bench.hpp"
+#include "hash.hpp"
+#include "pair.hpp"
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+using gregjm::bench::do_not_optimize;
+using gregjm::bench::Runner;
+using gregjm::bench::XorShift;
+
+constexpr std::size_t batch_size = 1 << 16;
+constexpr std::uint32_t grid_size = 128;
+
+using WordPair = gregjm::Pair<std::uint64_t, std::uint64_t>;
+using IntPair = gregjm::Pair<std::uint32_t, std::uint32_t>;
+
+// the combiner this replaces; (a, b) and (b, a) collide, as do all (a, a)
+struct XorHash {
+    template <typename First, typename Second>
+    std::size_t operator()(const gregjm::Pair<First, Second> &pair) const
+    noexcept {
+        return std::hash<First>{ }(pair.first())
+               ^ std::hash<Second>{ }(pair.second());
+    }
+};
+
+template <typename P>
+std::vector<P> random_pairs() {
+    using First = typename P::first_type;
+    using Second = typename P::second_type;
+
+    XorShift rng;
+    std::vector<P> pairs;
+    pairs.reserve(batch_size);
+
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        pairs.emplace_back(static_cast<First>(rng()),
+                           static_cast<Second>(rng()));
+    }
+
+    return pairs;
+}
+
+template <typename P>
+void bench_batch(Runner &runner, const char *type_name) {
+    const auto pairs = random_pairs<P>();
+    std::vector<std::size_t> hashes(batch_size);
+
+    runner.run(std::string{ "hash " } + type_name + "/XorHash", batch_size,
+               [&pairs, &hashes] {
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            hashes[i] = XorHash{ }(pairs[i]);
+        }
+
+        do_not_optimize(hashes.data());
+    });
+
+    runner.run(std::string{ "hash " } + type_name + "/std::hash<Pair>",
+               batch_size, [&pairs, &hashes] {
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            hashes[i] = std::hash<P>{ }(pairs[i]);
+        }
+
+        do_not_optimize(hashes.data());
+    });
+
+    runner.run(std::string{ "hash " } + type_name + "/hash_batch",
+               batch_size, [&pairs, &hashes] {
+        gregjm::hash_batch(gregjm::Span<const P>{ pairs },
+                           gregjm::Span<std::size_t>{ hashes });
+        do_not_optimize(hashes.data());
+    });
+}
+
+// every (i, j) on a grid, which XorHash maps onto only grid_size values
+template <typename Hash>
+void bench_grid(Runner &runner, const char *hash_name) {
+    runner.run(std::string{ "insert grid/" } + hash_name,
+               grid_size * grid_size, [] {
+        std::unordered_set<IntPair, Hash> set;
+        set.reserve(grid_size * grid_size);
+
+        for (std::uint32_t i = 0; i < grid_size; ++i) {
+            for (std::uint32_t j = 0; j < grid_size; ++j) {
+                set.emplace(i, j);
+            }
+        }
+
+        do_not_optimize(set.size());
+    });
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Runner runner{ gregjm::bench::parse_options(argc, argv) };
+
+    bench_batch<WordPair>(runner, "(u64, u64)");
+    bench_batch<IntPair>(runner, "(u32, u32)");
+
+    bench_grid<XorHash>(runner, "XorHash");
+    bench_grid<std::hash<IntPair>>(runner, "std::hash<Pair>");
+}
@@ -1,124 +1,367 @@
+#include "bench.hpp"
+#include "packed_pair.hpp"
 #include "pair.hpp"
+#include "uninitialized.hpp"
+#include "zip.hpp"
 
 #include <algorithm>
-#include <chrono>
-#include <functional>
-#include <sstream>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
-template <typename I, typename ...As, typename =
-              std::enable_if_t<std::is_invocable_v<I, As...>>>
-std::chrono::nanoseconds time(I &&invocable, As &&...args) {
-    const auto start = std::chrono::high_resolution_clock::now();
-    std::invoke(std::forward<I>(invocable), std::forward<As>(args)...);
-    const auto end = std::chrono::high_resolution_clock::now();
+namespace {
 
-    return end - start;
+using gregjm::bench::clobber_memory;
+using gregjm::bench::do_not_optimize;
+using gregjm::bench::Runner;
+using gregjm::bench::XorShift;
+
+constexpr std::size_t small_size = 4096;
+constexpr std::size_t sort_size = 1 << 16;
+
+template <std::size_t I, typename P>
+decltype(auto) element(P &&pair) {
+    using std::get;
+
+    return get<I>(std::forward<P>(pair));
 }
 
-template <typename CharT, typename Traits, typename T>
-std::basic_ostream<CharT, Traits>&
-operator<<(std::basic_ostream<CharT, Traits> &os, const std::vector<T> &vec) {
-    os << '[';
+template <template <typename, typename> class P>
+struct Named;
 
-    {
-    bool is_first = true;
-    for (const auto &elem : vec) {
-        if (is_first) {
-            is_first = false;
-        } else {
-            os << ", ";
-        }
+template <>
+struct Named<gregjm::Pair> {
+    static constexpr const char *name = "gregjm::Pair";
+};
+
+template <>
+struct Named<std::pair> {
+    static constexpr const char *name = "std::pair";
+};
+
+template <typename First, typename Second>
+using StdTuple = std::tuple<First, Second>;
+
+template <>
+struct Named<StdTuple> {
+    static constexpr const char *name = "std::tuple";
+};
+
+template <template <typename, typename> class P>
+std::string case_name(const char *operation) {
+    return std::string{ operation } + '/' + Named<P>::name;
+}
 
-        os << elem;
+template <template <typename, typename> class P>
+std::vector<P<std::uint32_t, std::uint32_t>> random_integers(std::size_t size) {
+    XorShift rng;
+    std::vector<P<std::uint32_t, std::uint32_t>> pairs;
+    pairs.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto bits = rng();
+
+        pairs.emplace_back(static_cast<std::uint32_t>(bits >> 48),
+                           static_cast<std::uint32_t>(bits));
     }
+
+    return pairs;
+}
+
+template <template <typename, typename> class P>
+std::vector<P<std::string, int>> random_strings(std::size_t size) {
+    XorShift rng;
+    std::vector<P<std::string, int>> pairs;
+    pairs.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto bits = rng();
+
+        pairs.emplace_back("key-" + std::to_string(bits % 4096)
+                               + "-padding-past-sso",
+                           static_cast<int>(bits >> 40));
     }
 
-    return os << ']';
+    return pairs;
 }
 
-template <typename CharT, typename Traits>
-std::basic_ostream<CharT, Traits>& nl(std::basic_ostream<CharT, Traits> &os) {
-    return os << '\n';
+template <template <typename, typename> class P>
+void bench_access(Runner &runner) {
+    const auto pairs = random_integers<P>(small_size);
+
+    runner.run(case_name<P>("access"), small_size, [&pairs] {
+        std::uint64_t sum = 0;
+
+        for (const auto &pair : pairs) {
+            sum += element<0>(pair) + element<1>(pair);
+        }
+
+        do_not_optimize(sum);
+    });
 }
 
-std::string std_vector_bench() {
-    std::ostringstream oss;
-    std::pair<std::vector<int>, std::vector<int>> pair;
+template <template <typename, typename> class P>
+void bench_construct(Runner &runner) {
+    using PairT = P<std::uint32_t, std::uint32_t>;
 
-    for (int i = 0; i < 64; ++i) {
-        pair.first.push_back(i);
-        pair.second.insert(pair.second.cbegin(), i);
+    std::allocator<PairT> alloc;
+    PairT *const buffer = alloc.allocate(small_size);
 
-        oss << pair.first << ", " << pair.second << nl;
-    }
+    runner.run(case_name<P>("construct"), small_size, [buffer] {
+        for (std::uint32_t i = 0; i < small_size; ++i) {
+            ::new (static_cast<void*>(buffer + i)) PairT{ i, i * 2 };
+        }
+
+        do_not_optimize(buffer);
+        clobber_memory();
+    });
 
-    return oss.str();
+    alloc.deallocate(buffer, small_size);
 }
 
-std::string ebo_vector_bench() {
-    std::ostringstream oss;
-    gregjm::Pair<std::vector<int>, std::vector<int>> pair;
+// value-initializing a vector zero fills it before it is overwritten;
+// DefaultInitAllocator skips that pass for gregjm::Pair, but not for
+// std::pair, whose default constructor value-initializes its members
+template <template <typename, typename> class P>
+void bench_allocate(Runner &runner) {
+    using PairT = P<std::uint32_t, float>;
 
-    for (int i = 0; i < 64; ++i) {
-        pair.first().push_back(i);
-        pair.second().insert(pair.second().cbegin(), i);
+    runner.run(case_name<P>("allocate"), sort_size, [] {
+        std::vector<PairT> pairs(sort_size);
+        do_not_optimize(pairs.data());
+    });
 
-        oss << pair.first() << ", " << pair.second() << nl;
-    }
+    runner.run(case_name<P>("allocate (default-init)"), sort_size, [] {
+        std::vector<PairT, gregjm::DefaultInitAllocator<PairT>>
+            pairs(sort_size);
+        do_not_optimize(pairs.data());
+    });
+}
 
-    return oss.str();
+template <template <typename, typename> class P>
+void bench_copy(Runner &runner) {
+    const auto source = random_integers<P>(small_size);
+    auto destination = source;
+
+    runner.run(case_name<P>("copy"), small_size, [&source, &destination] {
+        std::copy(source.cbegin(), source.cend(), destination.begin());
+        do_not_optimize(destination.data());
+        clobber_memory();
+    });
 }
 
-std::string std_size_t_bench() {
-    const std::hash<std::string> hash;
+template <template <typename, typename> class P>
+void bench_move(Runner &runner) {
+    using PairT = P<std::string, int>;
 
-    std::ostringstream oss;
-    std::string to_hash = "this is a hashable string";
-    std::pair<std::size_t, std::size_t> pair;
+    std::vector<PairT> source;
+    std::vector<PairT> destination;
+    destination.reserve(small_size);
 
-    for (int i = 0; i < 512; ++i) {
-        pair.first = hash(to_hash);
-        std::next_permutation(to_hash.begin(), to_hash.end());
-        pair.second = hash(to_hash);
-        std::next_permutation(to_hash.begin(), to_hash.end());
+    runner.run(
+        case_name<P>("move (string)"), small_size,
+        [&source, &destination] {
+            source = random_strings<P>(small_size);
+            destination.clear();
+        },
+        [&source, &destination] {
+            for (auto &pair : source) {
+                destination.push_back(std::move(pair));
+            }
 
-        oss << pair.first << ", " << pair.second << nl;
-    }
+            do_not_optimize(destination.data());
+        }
+    );
+}
+
+template <template <typename, typename> class P>
+void bench_swap(Runner &runner) {
+    auto pairs = random_integers<P>(small_size);
 
-    return oss.str();
+    runner.run(case_name<P>("swap"), small_size / 2, [&pairs] {
+        using std::swap;
+
+        for (std::size_t i = 0; i < small_size / 2; ++i) {
+            swap(pairs[i], pairs[small_size - 1 - i]);
+        }
+
+        do_not_optimize(pairs.data());
+        clobber_memory();
+    });
 }
 
-std::string ebo_size_t_bench() {
-    const std::hash<std::string> hash;
+template <template <typename, typename> class P>
+void bench_compare(Runner &runner) {
+    const auto integers = random_integers<P>(small_size);
+    const auto strings = random_strings<P>(small_size);
+
+    runner.run(case_name<P>("compare"), small_size - 1, [&integers] {
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i + 1 < small_size; ++i) {
+            count += integers[i] < integers[i + 1];
+        }
 
-    std::ostringstream oss;
-    std::string to_hash = "this is a hashable string";
-    gregjm::Pair<std::size_t, std::size_t> pair;
+        do_not_optimize(count);
+    });
 
-    for (int i = 0; i < 512; ++i) {
-        pair.first() = hash(to_hash);
-        std::next_permutation(to_hash.begin(), to_hash.end());
-        pair.second() = hash(to_hash);
-        std::next_permutation(to_hash.begin(), to_hash.end());
+    runner.run(case_name<P>("compare (string)"), small_size - 1, [&strings] {
+        std::size_t count = 0;
 
-        oss << pair.first() << ", " << pair.second() << nl;
+        for (std::size_t i = 0; i + 1 < small_size; ++i) {
+            count += strings[i] < strings[i + 1];
+        }
+
+        do_not_optimize(count);
+    });
+}
+
+template <template <typename, typename> class P>
+void bench_sort(Runner &runner) {
+    const auto integers = random_integers<P>(sort_size);
+    auto integers_copy = integers;
+
+    runner.run(
+        case_name<P>("sort"), sort_size,
+        [&integers, &integers_copy] { integers_copy = integers; },
+        [&integers_copy] {
+            std::sort(integers_copy.begin(), integers_copy.end());
+            do_not_optimize(integers_copy.data());
+        }
+    );
+
+    const auto strings = random_strings<P>(sort_size);
+    auto strings_copy = strings;
+
+    runner.run(
+        case_name<P>("sort (string)"), sort_size,
+        [&strings, &strings_copy] { strings_copy = strings; },
+        [&strings_copy] {
+            std::sort(strings_copy.begin(), strings_copy.end());
+            do_not_optimize(strings_copy.data());
+        }
+    );
+}
+
+// values that fit in 20 and 12 bits, sorted as Pair<u32, u32> and as a
+// PackedPair half its size
+void bench_packed(Runner &runner) {
+    using Packed = gregjm::PackedPair<std::uint32_t, 20, std::uint32_t, 12>;
+    using Unpacked = gregjm::Pair<std::uint32_t, std::uint32_t>;
+
+    std::vector<Unpacked> unpacked;
+    std::vector<Packed> packed;
+    unpacked.reserve(sort_size);
+    packed.reserve(sort_size);
+
+    XorShift rng;
+
+    for (std::size_t i = 0; i < sort_size; ++i) {
+        const auto bits = rng();
+        const auto first = static_cast<std::uint32_t>(bits >> 44);
+        const auto second = static_cast<std::uint32_t>(bits & 0xfff);
+
+        unpacked.emplace_back(first, second);
+        packed.emplace_back(first, second);
     }
 
-    return oss.str();
+    auto unpacked_copy = unpacked;
+    auto packed_copy = packed;
+
+    runner.run(
+        "sort (20 + 12 bits)/gregjm::Pair", sort_size,
+        [&unpacked, &unpacked_copy] { unpacked_copy = unpacked; },
+        [&unpacked_copy] {
+            std::sort(unpacked_copy.begin(), unpacked_copy.end());
+            do_not_optimize(unpacked_copy.data());
+        }
+    );
+
+    runner.run(
+        "sort (20 + 12 bits)/gregjm::PackedPair", sort_size,
+        [&packed, &packed_copy] { packed_copy = packed; },
+        [&packed_copy] {
+            std::sort(packed_copy.begin(), packed_copy.end());
+            do_not_optimize(packed_copy.data());
+        }
+    );
 }
 
-int main() {
-    for (int i = 0; i < 512; ++i) {
-        const auto std_size_t_ns = time(std_size_t_bench).count();
-        const auto ebo_size_t_ns = time(ebo_size_t_bench).count();
+// two parallel arrays sorted by key, either copied into a vector of Pairs
+// and back or sorted in place through a zip view
+void bench_zip(Runner &runner) {
+    std::vector<std::uint32_t> keys;
+    std::vector<std::uint64_t> values;
+    keys.reserve(sort_size);
+    values.reserve(sort_size);
 
-        const auto std_vector_ns = time(std_vector_bench).count();
-        const auto ebo_vector_ns = time(ebo_vector_bench).count();
+    XorShift rng;
 
-        std::cout << std_size_t_ns << ", " << ebo_size_t_ns << ", "
-                  << std_vector_ns << ", " << ebo_vector_ns << nl;
+    for (std::size_t i = 0; i < sort_size; ++i) {
+        keys.push_back(static_cast<std::uint32_t>(rng()));
+        values.push_back(rng());
     }
+
+    auto keys_copy = keys;
+    auto values_copy = values;
+    const auto reset = [&] {
+        keys_copy = keys;
+        values_copy = values;
+    };
+
+    runner.run("sort parallel arrays/copy through Pair", sort_size, reset,
+               [&keys_copy, &values_copy] {
+        std::vector<gregjm::Pair<std::uint32_t, std::uint64_t>> pairs;
+        pairs.reserve(sort_size);
+
+        for (std::size_t i = 0; i < sort_size; ++i) {
+            pairs.emplace_back(keys_copy[i], values_copy[i]);
+        }
+
+        std::sort(pairs.begin(), pairs.end());
+
+        for (std::size_t i = 0; i < sort_size; ++i) {
+            keys_copy[i] = pairs[i].first();
+            values_copy[i] = pairs[i].second();
+        }
+
+        do_not_optimize(keys_copy.data());
+        do_not_optimize(values_copy.data());
+    });
+
+    runner.run("sort parallel arrays/gregjm::zip", sort_size, reset,
+               [&keys_copy, &values_copy] {
+        auto zipped = gregjm::zip(keys_copy, values_copy);
+
+        std::sort(zipped.begin(), zipped.end());
+        do_not_optimize(keys_copy.data());
+        do_not_optimize(values_copy.data());
+    });
+}
+
+template <template <typename, typename> class ...Ps>
+void bench_all(Runner &runner) {
+    (bench_access<Ps>(runner), ...);
+    (bench_construct<Ps>(runner), ...);
+    (bench_allocate<Ps>(runner), ...);
+    (bench_copy<Ps>(runner), ...);
+    (bench_move<Ps>(runner), ...);
+    (bench_swap<Ps>(runner), ...);
+    (bench_compare<Ps>(runner), ...);
+    (bench_sort<Ps>(runner), ...);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Runner runner{ gregjm::bench::parse_options(argc, argv) };
+
+    bench_all<gregjm::Pair, std::pair, StdTuple>(runner);
+    bench_packed(runner);
+    bench_zip(runner);
 }
@@ -0,0 +1,106 @@
+#include "bench.hpp"
+#include "pair.hpp"
+#include "parallel_sort.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using gregjm::bench::do_not_optimize;
+using gregjm::bench::Runner;
+using gregjm::bench::XorShift;
+
+using StringPair = gregjm::Pair<std::string, std::uint64_t>;
+
+constexpr std::size_t sort_size = 1 << 18;
+
+// keys of 8 to 23 letters, so some fit in the small string buffer and some
+// do not
+std::vector<StringPair> random_pairs(std::size_t size, XorShift &rng) {
+    std::vector<StringPair> pairs;
+    pairs.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        std::string key(8 + rng() % 16, 'a');
+
+        for (char &c : key) {
+            c = static_cast<char>('a' + rng() % 26);
+        }
+
+        pairs.emplace_back(std::move(key), rng());
+    }
+
+    return pairs;
+}
+
+void bench_sort(Runner &runner, const std::vector<StringPair> &input) {
+    std::vector<StringPair> pairs;
+    const auto reset = [&input, &pairs] { pairs = input; };
+
+    runner.run("sort (string, u64)/std::sort", sort_size, reset, [&pairs] {
+        std::sort(pairs.begin(), pairs.end());
+        do_not_optimize(pairs.data());
+    });
+
+    runner.run("sort (string, u64)/std::stable_sort", sort_size, reset,
+               [&pairs] {
+        std::stable_sort(pairs.begin(), pairs.end());
+        do_not_optimize(pairs.data());
+    });
+
+    for (const std::size_t num_threads : { 1, 2, 4, 8, 16, 32, 64 }) {
+        gregjm::ThreadPool pool{ num_threads };
+
+        runner.run("sort (string, u64)/parallel_sort x"
+                       + std::to_string(num_threads),
+                   sort_size, reset, [&pool, &pairs] {
+            gregjm::parallel_sort(pool, pairs.begin(), pairs.end());
+            do_not_optimize(pairs.data());
+        });
+    }
+}
+
+void bench_merge(Runner &runner, std::vector<StringPair> lhs,
+                 std::vector<StringPair> rhs) {
+    std::sort(lhs.begin(), lhs.end());
+    std::sort(rhs.begin(), rhs.end());
+
+    std::vector<StringPair> merged(lhs.size() + rhs.size());
+    const std::size_t size = merged.size();
+
+    runner.run("merge (string, u64)/std::merge", size, [&] {
+        std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                   merged.begin());
+        do_not_optimize(merged.data());
+    });
+
+    for (const std::size_t num_threads : { 1, 2, 4, 8, 16, 32, 64 }) {
+        gregjm::ThreadPool pool{ num_threads };
+
+        runner.run("merge (string, u64)/parallel_merge x"
+                       + std::to_string(num_threads),
+                   size, [&] {
+            gregjm::parallel_merge(pool, lhs.begin(), lhs.end(), rhs.begin(),
+                                   rhs.end(), merged.begin());
+            do_not_optimize(merged.data());
+        });
+    }
+}
+
+} // namespace
+
+// thread counts past the number of hardware threads show the cost of
+// oversubscription rather than any speedup
+int main(int argc, char *argv[]) {
+    Runner runner{ gregjm::bench::parse_options(argc, argv) };
+    XorShift rng;
+
+    bench_sort(runner, random_pairs(sort_size, rng));
+    bench_merge(runner, random_pairs(sort_size, rng),
+                random_pairs(sort_size, rng));
+}
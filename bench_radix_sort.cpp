@@ -0,0 +1,144 @@
+#include "bench.hpp"
+#include "pair.hpp"
+#include "radix_sort.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using gregjm::bench::do_not_optimize;
+using gregjm::bench::Runner;
+using gregjm::bench::XorShift;
+
+using IntPair = gregjm::Pair<std::uint32_t, std::uint32_t>;
+using FloatPair = gregjm::Pair<float, std::int32_t>;
+
+// each case sorts a fresh copy of the same input; copying is not timed. no
+// input is built when the filter leaves none of the cases
+template <typename P>
+void bench_sorts(Runner &runner, const std::string &type_name,
+                 std::size_t size) {
+    const std::string prefix = "sort " + type_name + " x"
+                               + std::to_string(size >> 20) + "M/";
+    const std::string names[] = {
+        prefix + "std::sort", prefix + "radix_sort",
+        prefix + "radix_sort parallel", prefix + "stable_sort by first",
+        prefix + "radix_sort_by_first"
+    };
+
+    if (std::none_of(std::begin(names), std::end(names),
+                     [&runner](const std::string &name) {
+        return runner.matches(name);
+    })) {
+        return;
+    }
+
+    XorShift rng;
+    std::vector<P> input;
+    input.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        input.emplace_back(static_cast<typename P::first_type>(rng() >> 40),
+                           static_cast<typename P::second_type>(rng()));
+    }
+
+    std::vector<P> pairs(size);
+    const auto reset = [&input, &pairs] {
+        std::copy(input.begin(), input.end(), pairs.begin());
+    };
+
+    runner.run(names[0], size, reset, [&pairs] {
+        std::sort(pairs.begin(), pairs.end());
+        do_not_optimize(pairs.data());
+    });
+
+    runner.run(names[1], size, reset, [&pairs] {
+        gregjm::radix_sort(pairs.begin(), pairs.end());
+        do_not_optimize(pairs.data());
+    });
+
+    runner.run(names[2], size, reset, [&pairs] {
+        gregjm::radix_sort(gregjm::parallel, pairs.begin(), pairs.end());
+        do_not_optimize(pairs.data());
+    });
+
+    runner.run(names[3], size, reset, [&pairs] {
+        std::stable_sort(pairs.begin(), pairs.end(),
+                         [](const P &lhs, const P &rhs) {
+            return lhs.first() < rhs.first();
+        });
+        do_not_optimize(pairs.data());
+    });
+
+    runner.run(names[4], size, reset, [&pairs] {
+        gregjm::radix_sort_by_first(pairs.begin(), pairs.end());
+        do_not_optimize(pairs.data());
+    });
+}
+
+// the size of the largest input, in elements, from --max-size=, with an
+// optional K, M or G suffix for powers of 1024
+std::size_t parse_size(const char *text) {
+    char *suffix = nullptr;
+    std::size_t size = std::strtoull(text, &suffix, 10);
+
+    switch (*suffix) {
+    case 'G':
+        size <<= 10;
+        [[fallthrough]];
+    case 'M':
+        size <<= 10;
+        [[fallthrough]];
+    case 'K':
+        size <<= 10;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+} // namespace
+
+// sorts inputs of 1M, 16M, 256M and 1G elements, up to --max-size=, which
+// defaults to 16M. each size needs three copies of the input in memory, so
+// 1G pairs of 32-bit members need 24 GiB; run large sizes alone with a
+// filter such as "x1024M" and a small --repetitions
+int main(int argc, char *argv[]) {
+    std::size_t max_size = std::size_t{ 1 } << 24;
+    std::vector<const char*> args;
+
+    for (int i = 0; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+
+        if (arg.rfind("--max-size=", 0) == 0) {
+            max_size = parse_size(argv[i] + 11);
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+
+    Runner runner{ gregjm::bench::parse_options(
+        static_cast<int>(args.size()), args.data()
+    ) };
+
+    for (const std::size_t size : { std::size_t{ 1 } << 20,
+                                    std::size_t{ 1 } << 24,
+                                    std::size_t{ 1 } << 28,
+                                    std::size_t{ 1 } << 30 }) {
+        if (size > max_size) {
+            break;
+        }
+
+        bench_sorts<IntPair>(runner, "(u32, u32)", size);
+        bench_sorts<FloatPair>(runner, "(float, i32)", size);
+    }
+}
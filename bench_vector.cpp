@@ -0,0 +1,159 @@
+#include "bench.hpp"
+#include "pair.hpp"
+#include "unique_ptr.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using gregjm::bench::do_not_optimize;
+using gregjm::bench::Runner;
+using gregjm::bench::XorShift;
+
+constexpr std::size_t grow_size = 1 << 16;
+constexpr std::size_t ingest_chunk = 4096;
+constexpr std::size_t small_count = 4096;
+constexpr std::size_t small_size = 8;
+
+template <typename V>
+struct Named;
+
+template <typename T, typename A>
+struct Named<std::vector<T, A>> {
+    static constexpr const char *name = "std::vector";
+};
+
+template <typename T, typename A, std::size_t N>
+struct Named<gregjm::Vector<T, A, N>> {
+    static constexpr const char *name = N == 0 ? "gregjm::Vector"
+                                               : "gregjm::Vector (inline)";
+};
+
+template <typename V>
+std::string case_name(const char *operation) {
+    return std::string{ operation } + '/' + Named<V>::name;
+}
+
+using IntPair = gregjm::Pair<std::uint32_t, std::uint32_t>;
+using StringPair = gregjm::Pair<std::string, int>;
+
+// growth without reserve, so most of the time goes to moving old elements
+template <typename V, typename Make>
+void bench_grow(Runner &runner, const char *operation, Make make) {
+    runner.run(case_name<V>(operation), grow_size, [&make] {
+        V vec;
+
+        for (std::size_t i = 0; i < grow_size; ++i) {
+            vec.push_back(make(i));
+        }
+
+        do_not_optimize(vec.data());
+    });
+}
+
+template <typename V>
+void bench_grow_all(Runner &runner) {
+    using ValueT = typename V::value_type;
+
+    if constexpr (std::is_same_v<ValueT, IntPair>) {
+        bench_grow<V>(runner, "grow (Pair<u32, u32>)", [](std::size_t i) {
+            return IntPair{ static_cast<std::uint32_t>(i),
+                            static_cast<std::uint32_t>(i * 7) };
+        });
+    } else if constexpr (std::is_same_v<ValueT, StringPair>) {
+        bench_grow<V>(runner, "grow (Pair<string, int>)", [](std::size_t i) {
+            return StringPair{ "value-past-the-small-buffer",
+                               static_cast<int>(i) };
+        });
+    } else {
+        bench_grow<V>(runner, "grow (unique pointer)", [](std::size_t i) {
+            return ValueT{ new std::size_t{ i } };
+        });
+    }
+}
+
+void bench_ingest(Runner &runner) {
+    XorShift rng;
+    std::vector<IntPair> source;
+
+    for (std::size_t i = 0; i < ingest_chunk; ++i) {
+        const auto bits = rng();
+        source.emplace_back(static_cast<std::uint32_t>(bits),
+                            static_cast<std::uint32_t>(bits >> 32));
+    }
+
+    runner.run(case_name<std::vector<IntPair>>("ingest"), 16 * ingest_chunk,
+               [&source] {
+        std::vector<IntPair> vec;
+
+        for (std::size_t chunk = 0; chunk < 16; ++chunk) {
+            const std::size_t offset = vec.size();
+            vec.resize(offset + ingest_chunk);
+            std::copy(source.cbegin(), source.cend(), vec.begin()
+                      + static_cast<std::ptrdiff_t>(offset));
+        }
+
+        do_not_optimize(vec.data());
+    });
+
+    runner.run(case_name<gregjm::Vector<IntPair>>("ingest"),
+               16 * ingest_chunk, [&source] {
+        gregjm::Vector<IntPair> vec;
+
+        for (std::size_t chunk = 0; chunk < 16; ++chunk) {
+            IntPair *const out = vec.reserve_uninitialized(ingest_chunk);
+            std::uninitialized_copy(source.cbegin(), source.cend(), out);
+            vec.append_uninitialized(ingest_chunk);
+        }
+
+        do_not_optimize(vec.data());
+    });
+}
+
+template <typename V>
+void bench_small(Runner &runner) {
+    runner.run(case_name<V>("small"), small_count, [] {
+        std::uint64_t sum = 0;
+
+        for (std::size_t i = 0; i < small_count; ++i) {
+            V vec;
+
+            for (std::size_t j = 0; j < small_size; ++j) {
+                vec.push_back(static_cast<std::uint32_t>(i + j));
+            }
+
+            sum += vec.back();
+        }
+
+        do_not_optimize(sum);
+    });
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Runner runner{ gregjm::bench::parse_options(argc, argv) };
+
+    bench_grow_all<std::vector<IntPair>>(runner);
+    bench_grow_all<gregjm::Vector<IntPair>>(runner);
+    bench_grow_all<std::vector<StringPair>>(runner);
+    bench_grow_all<gregjm::Vector<StringPair>>(runner);
+    bench_grow_all<std::vector<std::unique_ptr<std::size_t>>>(runner);
+    bench_grow_all<gregjm::Vector<gregjm::UniquePtr<std::size_t>>>(runner);
+
+    bench_ingest(runner);
+
+    bench_small<std::vector<std::uint32_t>>(runner);
+    bench_small<gregjm::Vector<std::uint32_t>>(runner);
+    bench_small<gregjm::Vector<std::uint32_t,
+                               std::allocator<std::uint32_t>, small_size>>(
+        runner
+    );
+}
@@ -0,0 +1,424 @@
+#ifndef GREGJM_CONST_MAP_HPP
+#define GREGJM_CONST_MAP_HPP
+
+#include "constexpr_sort.hpp"
+#include "pair.hpp"
+#include "pair_detail.hpp"
+
+#include <array> // std::array
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint16_t, std::uint32_t, ...
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <type_traits>
+
+namespace gregjm {
+
+// how a ConstMap finds a key. LinearScan compares every key, PerfectHash
+// looks up the one slot that the key can be in, and Eytzinger runs a binary
+// search over the keys stored in breadth-first order
+enum class ConstMapStrategy {
+    LinearScan,
+    PerfectHash,
+    Eytzinger
+};
+
+namespace detail {
+
+// integers and enums are compared and hashed as 64-bit words
+template <typename K>
+static constexpr inline bool is_const_map_word_v =
+    (std::is_integral_v<K> || std::is_enum_v<K>)
+    && sizeof(K) <= sizeof(std::uint64_t);
+
+template <typename K>
+constexpr std::uint64_t const_map_word(K key) noexcept {
+    if constexpr (std::is_enum_v<K>) {
+        return static_cast<std::uint64_t>(
+            static_cast<std::underlying_type_t<K>>(key)
+        );
+    } else {
+        return static_cast<std::uint64_t>(key);
+    }
+}
+
+// up to this many word keys fit in a few vector registers, so comparing
+// all of them beats any search
+static constexpr inline std::size_t const_map_scan_words = 16;
+
+// other keys are scanned only while there are too few for a binary search
+// to skip many comparisons
+static constexpr inline std::size_t const_map_scan_keys = 8;
+
+template <typename K, std::size_t N>
+constexpr ConstMapStrategy const_map_strategy() noexcept {
+    if constexpr (is_const_map_word_v<K>) {
+        return N <= const_map_scan_words ? ConstMapStrategy::LinearScan
+                                         : ConstMapStrategy::PerfectHash;
+    } else {
+        return N <= const_map_scan_keys ? ConstMapStrategy::LinearScan
+                                        : ConstMapStrategy::Eytzinger;
+    }
+}
+
+constexpr std::size_t bit_ceil(std::size_t n) noexcept {
+    std::size_t power = 1;
+
+    while (power < n) {
+        power *= 2;
+    }
+
+    return power;
+}
+
+// the smallest unsigned type that holds every index up to and including N,
+// which marks an empty slot
+template <std::size_t N>
+using ConstMapIndexT = std::conditional_t<
+    N < 0xff, std::uint8_t,
+    std::conditional_t<N < 0xffff, std::uint16_t, std::uint32_t>
+>;
+
+// the largest displacement tried for one bucket before giving up on a
+// perfect hash; a map that gives up falls back to a binary search
+static constexpr inline std::uint32_t const_map_max_displacement = 1 << 16;
+
+constexpr std::uint64_t const_map_hash(std::uint64_t word) noexcept {
+    return multiply_fold(word ^ hash_seed_first, hash_seed_second);
+}
+
+constexpr std::uint64_t const_map_slot_hash(std::uint64_t hash,
+                                            std::uint32_t displacement)
+noexcept {
+    return multiply_fold(hash ^ displacement, hash_seed_first);
+}
+
+} // namespace detail
+
+// an immutable map that is built from a std::array of Pair<K, V> with a
+// constexpr constructor, so a constexpr ConstMap is constant initialized:
+// it costs nothing at startup and never allocates. the lookup strategy is
+// chosen from N and K:
+//
+// * integer and enum keys are scanned with a branch-free loop that the
+//   compiler vectorizes when there are at most 16 of them, and otherwise
+//   found with a perfect hash made up at compile time
+// * other keys, which need operator< and operator==, are scanned when there
+//   are at most 8 of them and otherwise found by an Eytzinger search
+//
+// keys must be unique; a duplicate key throws std::invalid_argument, which
+// is a compile error when the map is constexpr. K and V must be literal,
+// default constructible and copy assignable
+template <typename K, typename V, std::size_t N>
+class ConstMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using size_type = std::size_t;
+
+    static constexpr inline ConstMapStrategy strategy =
+        detail::const_map_strategy<K, N>();
+
+private:
+    using IndexT = detail::ConstMapIndexT<N>;
+
+    static constexpr inline bool is_hashed =
+        strategy == ConstMapStrategy::PerfectHash;
+
+    // at most half of the slots are used, and buckets average four keys
+    static constexpr inline std::size_t num_slots =
+        is_hashed ? detail::bit_ceil(2 * N) : 0;
+    static constexpr inline std::size_t num_buckets =
+        is_hashed ? detail::bit_ceil(N / 4 + 1) : 0;
+
+public:
+    constexpr explicit ConstMap(const std::array<Pair<K, V>, N> &entries) {
+        if constexpr (strategy == ConstMapStrategy::LinearScan) {
+            for (std::size_t i = 0; i < N; ++i) {
+                keys_[i] = entries[i].first();
+                values_[i] = entries[i].second();
+
+                for (std::size_t j = 0; j < i; ++j) {
+                    if (keys_[j] == keys_[i]) {
+                        throw std::invalid_argument{
+                            "gregjm::ConstMap: duplicate key"
+                        };
+                    }
+                }
+            }
+        } else {
+            const std::array<std::size_t, N> order = sorted_order(entries);
+
+            if constexpr (strategy == ConstMapStrategy::Eytzinger) {
+                std::size_t next = 0;
+                place_eytzinger(entries, order, next, 1);
+            } else {
+                for (std::size_t i = 0; i < N; ++i) {
+                    keys_[i] = entries[order[i]].first();
+                    values_[i] = entries[order[i]].second();
+                }
+
+                is_perfect_ = build_perfect_hash();
+            }
+        }
+    }
+
+    constexpr size_type size() const noexcept {
+        return N;
+    }
+
+    constexpr bool empty() const noexcept {
+        return N == 0;
+    }
+
+    // a pointer to the value of key, or nullptr if there is none
+    constexpr const V* find(const K &key) const noexcept {
+        const std::size_t index = index_of(key);
+
+        return index == N ? nullptr : &values_[index];
+    }
+
+    constexpr bool contains(const K &key) const noexcept {
+        return index_of(key) != N;
+    }
+
+    constexpr const V& at(const K &key) const {
+        const std::size_t index = index_of(key);
+
+        if (index == N) {
+            throw std::out_of_range{ "gregjm::ConstMap::at" };
+        }
+
+        return values_[index];
+    }
+
+private:
+    constexpr std::size_t index_of(const K &key) const noexcept {
+        if constexpr (strategy == ConstMapStrategy::LinearScan) {
+            return scan(key);
+        } else if constexpr (strategy == ConstMapStrategy::Eytzinger) {
+            return eytzinger_search(key);
+        } else {
+            return is_perfect_ ? hash_lookup(key) : binary_search(key);
+        }
+    }
+
+    // word keys are all compared and the matches gathered into a mask, with
+    // no early exit, so the loop becomes a few vector compares
+    constexpr std::size_t scan(const K &key) const noexcept {
+        if constexpr (detail::is_const_map_word_v<K>) {
+            std::uint32_t matches = 0;
+
+            for (std::size_t i = 0; i < N; ++i) {
+                matches |= std::uint32_t{ keys_[i] == key } << i;
+            }
+
+            return matches == 0
+                   ? N : static_cast<std::size_t>(__builtin_ctz(matches));
+        } else {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (keys_[i] == key) {
+                    return i;
+                }
+            }
+
+            return N;
+        }
+    }
+
+    // keys_[k - 1] holds node k of a complete binary search tree whose
+    // children are 2k and 2k + 1. the descent has no data-dependent branch,
+    // and the nodes visited next are adjacent, so they share cache lines
+    constexpr std::size_t eytzinger_search(const K &key) const noexcept {
+        std::size_t node = 1;
+
+        while (node <= N) {
+            node = 2 * node + static_cast<std::size_t>(keys_[node - 1] < key);
+        }
+
+        // the last node at which the search went left is the lower bound
+        while (node % 2 == 1) {
+            node /= 2;
+        }
+
+        node /= 2;
+
+        return node != 0 && !(key < keys_[node - 1]) ? node - 1 : N;
+    }
+
+    constexpr std::size_t binary_search(const K &key) const noexcept {
+        std::size_t first = 0;
+        std::size_t count = N;
+
+        while (count > 0) {
+            const std::size_t half = count / 2;
+
+            if (keys_[first + half] < key) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+
+        return first != N && !(key < keys_[first]) ? first : N;
+    }
+
+    constexpr std::size_t hash_lookup(const K &key) const noexcept {
+        const std::uint64_t hash =
+            detail::const_map_hash(detail::const_map_word(key));
+        const std::size_t index =
+            slots_[slot_of(hash, displacements_[hash & (num_buckets - 1)])];
+
+        return index != N && keys_[index] == key ? index : N;
+    }
+
+    static constexpr std::array<std::size_t, N>
+    sorted_order(const std::array<Pair<K, V>, N> &entries) {
+        std::array<std::size_t, N> order{ };
+
+        for (std::size_t i = 0; i < N; ++i) {
+            order[i] = i;
+        }
+
+        constexpr_sort(order.begin(), order.end(),
+                       [&entries](std::size_t lhs, std::size_t rhs) {
+            return entries[lhs].first() < entries[rhs].first();
+        });
+
+        for (std::size_t i = 1; i < N; ++i) {
+            if (!(entries[order[i - 1]].first()
+                  < entries[order[i]].first())) {
+                throw std::invalid_argument{
+                    "gregjm::ConstMap: duplicate key"
+                };
+            }
+        }
+
+        return order;
+    }
+
+    // an in-order walk of the tree visits the nodes in sorted order
+    constexpr void place_eytzinger(const std::array<Pair<K, V>, N> &entries,
+                                   const std::array<std::size_t, N> &order,
+                                   std::size_t &next, std::size_t node) {
+        if (node > N) {
+            return;
+        }
+
+        place_eytzinger(entries, order, next, 2 * node);
+        keys_[node - 1] = entries[order[next]].first();
+        values_[node - 1] = entries[order[next]].second();
+        ++next;
+        place_eytzinger(entries, order, next, 2 * node + 1);
+    }
+
+    // hash and displace: keys are split into buckets by their hash, and each
+    // bucket, largest first, gets the first displacement that sends all of
+    // its keys to free slots. returns false if some bucket has none, which
+    // is vanishingly unlikely for distinct keys
+    constexpr bool build_perfect_hash() {
+        std::array<std::uint64_t, N> hashes{ };
+        std::array<std::size_t, num_buckets + 1> starts{ };
+
+        for (std::size_t i = 0; i < N; ++i) {
+            hashes[i] =
+                detail::const_map_hash(detail::const_map_word(keys_[i]));
+            ++starts[(hashes[i] & (num_buckets - 1)) + 1];
+        }
+
+        for (std::size_t bucket = 0; bucket < num_buckets; ++bucket) {
+            starts[bucket + 1] += starts[bucket];
+        }
+
+        std::array<std::size_t, N> members{ };
+        std::array<std::size_t, num_buckets> filled{ };
+
+        for (std::size_t i = 0; i < N; ++i) {
+            const std::size_t bucket = hashes[i] & (num_buckets - 1);
+            members[starts[bucket] + filled[bucket]++] = i;
+        }
+
+        std::array<std::size_t, num_buckets> buckets{ };
+
+        for (std::size_t bucket = 0; bucket < num_buckets; ++bucket) {
+            buckets[bucket] = bucket;
+        }
+
+        constexpr_sort(buckets.begin(), buckets.end(),
+                       [&starts](std::size_t lhs, std::size_t rhs) {
+            return starts[lhs + 1] - starts[lhs]
+                   > starts[rhs + 1] - starts[rhs];
+        });
+
+        for (std::size_t slot = 0; slot < num_slots; ++slot) {
+            slots_[slot] = static_cast<IndexT>(N);
+        }
+
+        for (const std::size_t bucket : buckets) {
+            const std::size_t first = starts[bucket];
+            const std::size_t last = starts[bucket + 1];
+
+            if (first == last) {
+                break;
+            }
+
+            std::uint32_t displacement = 0;
+
+            while (!try_displacement(hashes, members, first, last,
+                                     displacement)) {
+                if (++displacement == detail::const_map_max_displacement) {
+                    return false;
+                }
+            }
+
+            displacements_[bucket] = displacement;
+        }
+
+        return true;
+    }
+
+    // claims the slots of members[first, last) under displacement if they
+    // are all free and distinct
+    constexpr bool try_displacement(const std::array<std::uint64_t, N> &hashes,
+                                    const std::array<std::size_t, N> &members,
+                                    std::size_t first, std::size_t last,
+                                    std::uint32_t displacement) {
+        for (std::size_t i = first; i < last; ++i) {
+            const std::size_t slot = slot_of(hashes[members[i]],
+                                             displacement);
+
+            if (slots_[slot] != N) {
+                for (std::size_t j = first; j < i; ++j) {
+                    slots_[slot_of(hashes[members[j]], displacement)] =
+                        static_cast<IndexT>(N);
+                }
+
+                return false;
+            }
+
+            slots_[slot] = static_cast<IndexT>(members[i]);
+        }
+
+        return true;
+    }
+
+    static constexpr std::size_t slot_of(std::uint64_t hash,
+                                         std::uint32_t displacement) noexcept {
+        return static_cast<std::size_t>(
+            detail::const_map_slot_hash(hash, displacement) & (num_slots - 1)
+        );
+    }
+
+    std::array<K, N> keys_{ };
+    std::array<V, N> values_{ };
+    std::array<IndexT, num_slots> slots_{ };
+    std::array<std::uint32_t, num_buckets> displacements_{ };
+    bool is_perfect_ = false;
+};
+
+template <typename K, typename V, std::size_t N>
+ConstMap(const std::array<Pair<K, V>, N>&) -> ConstMap<K, V, N>;
+
+} // namespace gregjm
+
+#endif
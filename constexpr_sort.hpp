@@ -0,0 +1,77 @@
+#ifndef GREGJM_CONSTEXPR_SORT_HPP
+#define GREGJM_CONSTEXPR_SORT_HPP
+
+#include "pair_detail.hpp"
+
+#include <array> // std::array
+#include <cstddef> // std::size_t
+#include <functional> // std::less
+#include <iterator> // std::iterator_traits
+
+namespace gregjm {
+namespace detail {
+
+template <typename RandomIt, typename Compare>
+constexpr void sift_down(
+    RandomIt first,
+    typename std::iterator_traits<RandomIt>::difference_type root,
+    typename std::iterator_traits<RandomIt>::difference_type size,
+    Compare &comp
+) {
+    while (true) {
+        auto child = 2 * root + 1;
+
+        if (child >= size) {
+            return;
+        }
+
+        if (child + 1 < size && comp(first[child], first[child + 1])) {
+            ++child;
+        }
+
+        if (!comp(first[root], first[child])) {
+            return;
+        }
+
+        swap_values(first[root], first[child]);
+        root = child;
+    }
+}
+
+} // namespace detail
+
+// a heapsort that can be evaluated in a constant expression, since std::sort
+// is only constexpr from C++20. this is for building sorted lookup tables at
+// compile time; like std::sort, it is not stable
+template <typename RandomIt, typename Compare>
+constexpr void constexpr_sort(RandomIt first, RandomIt last, Compare comp) {
+    const auto size = last - first;
+
+    for (auto root = size / 2; root > 0; --root) {
+        detail::sift_down(first, root - 1, size, comp);
+    }
+
+    for (auto end = size - 1; end > 0; --end) {
+        detail::swap_values(first[0], first[end]);
+        detail::sift_down(first, 0, end, comp);
+    }
+}
+
+template <typename RandomIt>
+constexpr void constexpr_sort(RandomIt first, RandomIt last) {
+    constexpr_sort(first, last, std::less<>{ });
+}
+
+// a sorted copy of array, so a table can be declared constexpr in any order:
+// constexpr auto table = gregjm::sorted(std::array{ ... });
+template <typename T, std::size_t N, typename Compare = std::less<>>
+constexpr std::array<T, N> sorted(std::array<T, N> array,
+                                  Compare comp = Compare{ }) {
+    constexpr_sort(array.begin(), array.end(), comp);
+
+    return array;
+}
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,1002 @@
+#ifndef GREGJM_FLAT_MAP_HPP
+#define GREGJM_FLAT_MAP_HPP
+
+#include "pair.hpp"
+#include "relocate.hpp"
+#include "tuple.hpp"
+
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstring> // std::memcpy, std::memset
+#include <functional> // std::hash, std::equal_to
+#include <initializer_list>
+#include <iterator> // std::forward_iterator_tag
+#include <memory> // std::allocator, std::allocator_traits
+#include <new> // ::new
+#include <stdexcept> // std::out_of_range
+#include <tuple> // std::forward_as_tuple
+#include <type_traits>
+#include <utility> // std::forward, std::move, std::swap
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace gregjm {
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+class FlatMap;
+
+namespace detail {
+
+// one control byte per slot: empty and deleted slots are negative, and a
+// full slot holds the low seven bits of its key's hash. the sentinel follows
+// the last slot and stops iteration
+using ControlByte = signed char;
+
+static constexpr inline ControlByte control_empty = -128;
+static constexpr inline ControlByte control_deleted = -2;
+static constexpr inline ControlByte control_sentinel = -1;
+
+// the positions in a group that matched, one bit each
+class BitMask {
+public:
+    constexpr explicit BitMask(std::uint32_t bits) noexcept : bits_{ bits } { }
+
+    constexpr explicit operator bool() const noexcept {
+        return bits_ != 0;
+    }
+
+    int lowest() const noexcept {
+        return __builtin_ctz(bits_);
+    }
+
+    int trailing_zeros() const noexcept {
+        return __builtin_ctz(bits_);
+    }
+
+    // leading zeros among the low width bits
+    template <std::size_t Width>
+    int leading_zeros() const noexcept {
+        return __builtin_clz(bits_) - static_cast<int>(32 - Width);
+    }
+
+    constexpr BitMask& operator++() noexcept {
+        bits_ &= bits_ - 1;
+
+        return *this;
+    }
+
+    int operator*() const noexcept {
+        return lowest();
+    }
+
+    constexpr BitMask begin() const noexcept {
+        return *this;
+    }
+
+    constexpr BitMask end() const noexcept {
+        return BitMask{ 0 };
+    }
+
+    constexpr bool operator!=(const BitMask &other) const noexcept {
+        return bits_ != other.bits_;
+    }
+
+private:
+    std::uint32_t bits_;
+};
+
+// a window of control bytes that are matched at once: 32 with AVX2, 16 with
+// SSE2, and 8 one byte at a time elsewhere
+class Group {
+public:
+#if defined(__AVX2__)
+    static constexpr inline std::size_t width = 32;
+
+    explicit Group(const ControlByte *control) noexcept
+    : control_{ _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(control)
+      ) } { }
+
+    BitMask match(ControlByte hash) const noexcept {
+        return mask(_mm256_cmpeq_epi8(_mm256_set1_epi8(hash), control_));
+    }
+
+    BitMask match_empty() const noexcept {
+        return match(control_empty);
+    }
+
+    BitMask match_empty_or_deleted() const noexcept {
+        return mask(_mm256_cmpgt_epi8(_mm256_set1_epi8(control_sentinel),
+                                      control_));
+    }
+
+private:
+    static BitMask mask(__m256i bytes) noexcept {
+        return BitMask{
+            static_cast<std::uint32_t>(_mm256_movemask_epi8(bytes))
+        };
+    }
+
+    __m256i control_;
+#elif defined(__SSE2__)
+    static constexpr inline std::size_t width = 16;
+
+    explicit Group(const ControlByte *control) noexcept
+    : control_{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(control)) }
+    { }
+
+    BitMask match(ControlByte hash) const noexcept {
+        return mask(_mm_cmpeq_epi8(_mm_set1_epi8(hash), control_));
+    }
+
+    BitMask match_empty() const noexcept {
+        return match(control_empty);
+    }
+
+    BitMask match_empty_or_deleted() const noexcept {
+        return mask(_mm_cmplt_epi8(control_, _mm_set1_epi8(control_sentinel)));
+    }
+
+private:
+    static BitMask mask(__m128i bytes) noexcept {
+        return BitMask{
+            static_cast<std::uint32_t>(_mm_movemask_epi8(bytes))
+        };
+    }
+
+    __m128i control_;
+#else
+    static constexpr inline std::size_t width = 8;
+
+    explicit Group(const ControlByte *control) noexcept {
+        std::memcpy(control_, control, width);
+    }
+
+    BitMask match(ControlByte hash) const noexcept {
+        std::uint32_t bits = 0;
+
+        for (std::size_t i = 0; i < width; ++i) {
+            bits |= static_cast<std::uint32_t>(control_[i] == hash) << i;
+        }
+
+        return BitMask{ bits };
+    }
+
+    BitMask match_empty() const noexcept {
+        return match(control_empty);
+    }
+
+    BitMask match_empty_or_deleted() const noexcept {
+        std::uint32_t bits = 0;
+
+        for (std::size_t i = 0; i < width; ++i) {
+            bits |= static_cast<std::uint32_t>(
+                control_[i] < control_sentinel
+            ) << i;
+        }
+
+        return BitMask{ bits };
+    }
+
+private:
+    ControlByte control_[width];
+#endif
+};
+
+// visits every group of a table whose capacity is one less than a power of
+// two exactly once
+class ProbeSequence {
+public:
+    constexpr ProbeSequence(std::size_t hash, std::size_t mask) noexcept
+    : mask_{ mask }, offset_{ hash & mask } { }
+
+    constexpr std::size_t offset() const noexcept {
+        return offset_;
+    }
+
+    constexpr std::size_t offset(std::size_t i) const noexcept {
+        return (offset_ + i) & mask_;
+    }
+
+    constexpr void next() noexcept {
+        index_ += Group::width;
+        offset_ = (offset_ + index_) & mask_;
+    }
+
+private:
+    std::size_t mask_;
+    std::size_t offset_;
+    std::size_t index_ = 0;
+};
+
+// std::hash is the identity for integers, which would put every small key
+// in the same group; this spreads the bits over the whole word first
+constexpr std::uint64_t mix_hash(std::uint64_t hash) noexcept {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccd;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+template <typename T, typename = void>
+struct IsTransparent : std::false_type { };
+
+template <typename T>
+struct IsTransparent<T, std::void_t<typename T::is_transparent>>
+: std::true_type { };
+
+template <typename T>
+static constexpr inline bool is_transparent_v = IsTransparent<T>::value;
+
+template <typename Key, typename Value, bool IsConst>
+class FlatMapIterator {
+private:
+    using SlotT = Pair<Key, Value>;
+    using ValueRefT = std::conditional_t<IsConst, const Value&, Value&>;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Pair<Key, Value>;
+    using difference_type = std::ptrdiff_t;
+    using reference = Pair<const Key&, ValueRefT>;
+    using pointer = ArrowProxy<reference>;
+
+    FlatMapIterator() noexcept = default;
+
+    FlatMapIterator(const ControlByte *control, SlotT *slot) noexcept
+    : control_{ control }, slot_{ slot } {
+        skip_empty();
+    }
+
+    template <bool C = IsConst, typename = std::enable_if_t<C>>
+    FlatMapIterator(const FlatMapIterator<Key, Value, false> &other) noexcept
+    : control_{ other.control_ }, slot_{ other.slot_ } { }
+
+    reference operator*() const noexcept {
+        return reference{ slot_->first(), slot_->second() };
+    }
+
+    pointer operator->() const noexcept {
+        return pointer{ **this };
+    }
+
+    FlatMapIterator& operator++() noexcept {
+        ++control_;
+        ++slot_;
+        skip_empty();
+
+        return *this;
+    }
+
+    FlatMapIterator operator++(int) noexcept {
+        FlatMapIterator previous = *this;
+        ++*this;
+
+        return previous;
+    }
+
+    friend bool operator==(const FlatMapIterator &lhs,
+                           const FlatMapIterator &rhs) noexcept {
+        return lhs.slot_ == rhs.slot_;
+    }
+
+    friend bool operator!=(const FlatMapIterator &lhs,
+                           const FlatMapIterator &rhs) noexcept {
+        return lhs.slot_ != rhs.slot_;
+    }
+
+private:
+    template <typename K, typename V, bool C>
+    friend class FlatMapIterator;
+
+    template <typename K, typename V, typename H, typename E, typename A>
+    friend class gregjm::FlatMap;
+
+    // the control bytes end in a sentinel, so this stops at end()
+    void skip_empty() noexcept {
+        while (*control_ < control_sentinel) {
+            ++control_;
+            ++slot_;
+        }
+    }
+
+    const ControlByte *control_ = nullptr;
+    SlotT *slot_ = nullptr;
+};
+
+} // namespace detail
+
+// open addressing hash map in the style of Swiss tables. each slot is a
+// Pair<Key, Value>, so an empty Value costs nothing per slot and turns the
+// map into a set; the hasher, key equality and allocator share a Tuple with
+// the control byte pointer, so stateless policies cost nothing either.
+//
+// lookups compare a whole group of control bytes against seven bits of the
+// hash at once with SSE2 or AVX2. iterators are invalidated by any insertion
+// that grows the table, and dereference to Pair<const Key&, Value&>. Key and
+// Value must be nothrow move constructible
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Pair<Key, Value>>>
+class FlatMap {
+private:
+    using SlotT = Pair<Key, Value>;
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using SlotAllocator = typename AllocTraits::template rebind_alloc<SlotT>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+    using ControlAllocator =
+        typename AllocTraits::template rebind_alloc<detail::ControlByte>;
+    using ControlTraits = std::allocator_traits<ControlAllocator>;
+    using ControlByte = detail::ControlByte;
+    using Group = detail::Group;
+
+    static_assert(std::is_nothrow_move_constructible_v<SlotT>,
+                  "FlatMap relocates slots when it grows");
+
+    template <typename K>
+    static constexpr inline bool is_lookup_key_v =
+        std::is_convertible_v<const K&, const Key&>
+        || (detail::is_transparent_v<Hash>
+            && detail::is_transparent_v<KeyEqual>);
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = Pair<Key, Value>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using iterator = detail::FlatMapIterator<Key, Value, false>;
+    using const_iterator = detail::FlatMapIterator<Key, Value, true>;
+
+    FlatMap() : FlatMap(0) { }
+
+    explicit FlatMap(size_type bucket_count, const Hash &hash = Hash(),
+                     const KeyEqual &equal = KeyEqual(),
+                     const Allocator &alloc = Allocator())
+    : policies_and_control_(Tuple<Hash, KeyEqual, SlotAllocator>(
+          hash, equal, SlotAllocator(alloc)
+      ), empty_group()) {
+        reserve(bucket_count);
+    }
+
+    explicit FlatMap(const Allocator &alloc)
+    : FlatMap(0, Hash(), KeyEqual(), alloc) { }
+
+    FlatMap(std::initializer_list<value_type> init, size_type bucket_count = 0,
+            const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(),
+            const Allocator &alloc = Allocator())
+    : FlatMap(bucket_count, hash, equal, alloc) {
+        reserve(init.size());
+
+        for (const value_type &value : init) {
+            insert(value);
+        }
+    }
+
+    FlatMap(const FlatMap &other)
+    : FlatMap(0, other.hash_function(), other.key_eq(),
+              AllocTraits::select_on_container_copy_construction(
+                  other.get_allocator()
+              )) {
+        reserve(other.size());
+
+        for (auto it = other.slot_begin(); it != other.slot_end(); ++it) {
+            const SlotT &slot = *it.slot_;
+            emplace_new(hash_of(slot.first()), slot.first(), slot.second());
+        }
+    }
+
+    FlatMap(FlatMap &&other) noexcept
+    : policies_and_control_(std::move(other.policies_and_control_.first()),
+                            other.control()),
+      slots_{ other.slots_ }, size_{ other.size_ },
+      capacity_{ other.capacity_ }, growth_left_{ other.growth_left_ } {
+        other.reset_to_empty();
+    }
+
+    ~FlatMap() {
+        destroy_slots();
+        deallocate();
+    }
+
+    FlatMap& operator=(const FlatMap &other) {
+        if (this != &other) {
+            FlatMap copy = other;
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    // the allocator is always moved along with the elements
+    FlatMap& operator=(FlatMap &&other) noexcept {
+        if (this != &other) {
+            FlatMap moved = std::move(other);
+            swap(moved);
+        }
+
+        return *this;
+    }
+
+    iterator begin() noexcept {
+        return iterator{ control(), slots_ };
+    }
+
+    const_iterator begin() const noexcept {
+        return slot_begin();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return slot_begin();
+    }
+
+    iterator end() noexcept {
+        return iterator{ control() + capacity_, slots_ + capacity_ };
+    }
+
+    const_iterator end() const noexcept {
+        return slot_end();
+    }
+
+    const_iterator cend() const noexcept {
+        return slot_end();
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    // the number of slots, zero or one less than a power of two; at most 7/8
+    // of them are filled before growing
+    size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    hasher hash_function() const {
+        return policies().template get<0>();
+    }
+
+    key_equal key_eq() const {
+        return policies().template get<1>();
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_type(policies().template get<2>());
+    }
+
+    void clear() noexcept {
+        destroy_slots();
+
+        if (capacity_ != 0) {
+            reset_control();
+            size_ = 0;
+            growth_left_ = growth_for(capacity_);
+        }
+    }
+
+    // makes room for count elements without growing again
+    void reserve(size_type count) {
+        if (count > growth_for(capacity_)) {
+            rehash(capacity_for(count));
+        }
+    }
+
+    template <typename ...Args>
+    Pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+        return find_or_emplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename ...Args>
+    Pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+        return find_or_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    Pair<iterator, bool> insert(const value_type &value) {
+        return find_or_emplace(value.first(), value.second());
+    }
+
+    Pair<iterator, bool> insert(value_type &&value) {
+        return find_or_emplace(std::move(value.first()),
+                               std::move(value.second()));
+    }
+
+    template <typename V>
+    Pair<iterator, bool> insert_or_assign(const Key &key, V &&value) {
+        auto result = find_or_emplace(key, std::forward<V>(value));
+
+        if (!result.second()) {
+            result.first()->second() = std::forward<V>(value);
+        }
+
+        return result;
+    }
+
+    Value& operator[](const Key &key) {
+        return find_or_emplace(key).first()->second();
+    }
+
+    Value& operator[](Key &&key) {
+        return find_or_emplace(std::move(key)).first()->second();
+    }
+
+    template <typename K, typename = std::enable_if_t<is_lookup_key_v<K>>>
+    Value& at(const K &key) {
+        const auto index = find_index(key);
+
+        if (index == capacity_) {
+            throw std::out_of_range{ "gregjm::FlatMap::at" };
+        }
+
+        return slots_[index].second();
+    }
+
+    template <typename K, typename = std::enable_if_t<is_lookup_key_v<K>>>
+    const Value& at(const K &key) const {
+        const auto index = find_index(key);
+
+        if (index == capacity_) {
+            throw std::out_of_range{ "gregjm::FlatMap::at" };
+        }
+
+        return slots_[index].second();
+    }
+
+    // K is either Key or, when Hash and KeyEqual are both transparent, any
+    // type they accept
+    template <typename K, typename = std::enable_if_t<is_lookup_key_v<K>>>
+    iterator find(const K &key) {
+        return iterator_at(find_index(key));
+    }
+
+    template <typename K, typename = std::enable_if_t<is_lookup_key_v<K>>>
+    const_iterator find(const K &key) const {
+        return const_iterator_at(find_index(key));
+    }
+
+    template <typename K, typename = std::enable_if_t<is_lookup_key_v<K>>>
+    bool contains(const K &key) const {
+        return find_index(key) != capacity_;
+    }
+
+    template <typename K, typename = std::enable_if_t<is_lookup_key_v<K>>>
+    size_type count(const K &key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    // iterators are never keys, so erase(begin()) erases by position even
+    // when the hasher and key equality accept any type
+    template <typename K, typename = std::enable_if_t<
+        is_lookup_key_v<K> && !std::is_convertible_v<K, iterator>
+        && !std::is_convertible_v<K, const_iterator>
+    >>
+    size_type erase(const K &key) {
+        const auto index = find_index(key);
+
+        if (index == capacity_) {
+            return 0;
+        }
+
+        erase_at(index);
+
+        return 1;
+    }
+
+    // returns the iterator following position
+    iterator erase(const_iterator position) noexcept {
+        const auto index = static_cast<size_type>(position.slot_ - slots_);
+        erase_at(index);
+
+        return iterator_at(index + 1);
+    }
+
+    iterator erase(iterator position) noexcept {
+        return erase(const_iterator{ position });
+    }
+
+    void swap(FlatMap &other) noexcept {
+        using std::swap;
+
+        swap(policies_and_control_, other.policies_and_control_);
+        swap(slots_, other.slots_);
+        swap(size_, other.size_);
+        swap(capacity_, other.capacity_);
+        swap(growth_left_, other.growth_left_);
+    }
+
+private:
+    // shared by every map with no slots, which only needs the sentinel
+    static ControlByte* empty_group() noexcept {
+        static ControlByte sentinel = detail::control_sentinel;
+
+        return &sentinel;
+    }
+
+    // always leaves an empty slot, so every probe sequence terminates
+    static constexpr size_type growth_for(size_type capacity) noexcept {
+        return capacity - (capacity + 1) / 8;
+    }
+
+    static size_type capacity_for(size_type count) noexcept {
+        size_type capacity = Group::width - 1;
+
+        while (growth_for(capacity) < count) {
+            capacity = capacity * 2 + 1;
+        }
+
+        return capacity;
+    }
+
+    Tuple<Hash, KeyEqual, SlotAllocator>& policies() noexcept {
+        return policies_and_control_.first();
+    }
+
+    const Tuple<Hash, KeyEqual, SlotAllocator>& policies() const noexcept {
+        return policies_and_control_.first();
+    }
+
+    ControlByte* control() const noexcept {
+        return policies_and_control_.second();
+    }
+
+    SlotAllocator& slot_allocator() noexcept {
+        return policies().template get<2>();
+    }
+
+    const_iterator slot_begin() const noexcept {
+        return const_iterator{ control(), slots_ };
+    }
+
+    const_iterator slot_end() const noexcept {
+        return const_iterator{ control() + capacity_, slots_ + capacity_ };
+    }
+
+    iterator iterator_at(size_type index) noexcept {
+        return iterator{ control() + index, slots_ + index };
+    }
+
+    const_iterator const_iterator_at(size_type index) const noexcept {
+        return const_iterator{ control() + index, slots_ + index };
+    }
+
+    template <typename K>
+    std::size_t hash_of(const K &key) const {
+        return static_cast<std::size_t>(detail::mix_hash(
+            static_cast<std::uint64_t>(policies().template get<0>()(key))
+        ));
+    }
+
+    static ControlByte low_bits(std::size_t hash) noexcept {
+        return static_cast<ControlByte>(hash & 0x7f);
+    }
+
+    // the sentinel is followed by copies of the first Group::width - 1
+    // control bytes, so a group can be loaded starting from any slot
+    void set_control(size_type index, ControlByte value) noexcept {
+        control()[index] = value;
+
+        if (index < Group::width - 1) {
+            control()[capacity_ + 1 + index] = value;
+        }
+    }
+
+    // capacity_ when not found
+    template <typename K>
+    size_type find_index(const K &key) const {
+        return capacity_ == 0 ? capacity_ : find_index(key, hash_of(key));
+    }
+
+    template <typename K>
+    size_type find_index(const K &key, std::size_t hash) const {
+        if (capacity_ == 0) {
+            return capacity_;
+        }
+
+        detail::ProbeSequence probe{ hash >> 7, capacity_ };
+
+        while (true) {
+            const Group group{ control() + probe.offset() };
+
+            for (const int i : group.match(low_bits(hash))) {
+                const size_type index =
+                    probe.offset(static_cast<std::size_t>(i));
+
+                if (policies().template get<1>()(slots_[index].first(),
+                                                  key)) {
+                    return index;
+                }
+            }
+
+            if (group.match_empty()) {
+                return capacity_;
+            }
+
+            probe.next();
+        }
+    }
+
+    size_type find_free(std::size_t hash) const noexcept {
+        detail::ProbeSequence probe{ hash >> 7, capacity_ };
+
+        while (true) {
+            const Group group{ control() + probe.offset() };
+
+            if (const auto free = group.match_empty_or_deleted()) {
+                return probe.offset(
+                    static_cast<std::size_t>(free.lowest())
+                );
+            }
+
+            probe.next();
+        }
+    }
+
+    template <typename K, typename ...Args>
+    Pair<iterator, bool> find_or_emplace(K &&key, Args &&...args) {
+        const std::size_t hash = hash_of(key);
+        const size_type index = find_index(key, hash);
+
+        if (index != capacity_) {
+            return { iterator_at(index), false };
+        }
+
+        return { emplace_new(hash, std::forward<K>(key),
+                             std::forward<Args>(args)...), true };
+    }
+
+    // the key must not be present yet
+    template <typename K, typename ...Args>
+    iterator emplace_new(std::size_t hash, K &&key, Args &&...args) {
+        const size_type index = capacity_ == 0 ? 0 : find_free(hash);
+
+        if (growth_left_ == 0 && control()[index] != detail::control_deleted) {
+            return grow_and_emplace(hash, std::forward<K>(key),
+                                    std::forward<Args>(args)...);
+        }
+
+        construct_at(index, hash, std::forward<K>(key),
+                     std::forward<Args>(args)...);
+
+        return iterator_at(index);
+    }
+
+    // key and args may refer to elements of this map, so the new element is
+    // constructed in the new table before the old slots are relocated
+    template <typename K, typename ...Args>
+    iterator grow_and_emplace(std::size_t hash, K &&key, Args &&...args) {
+        const Table old = replace_table(grown_capacity());
+        const size_type index = find_free(hash);
+
+        try {
+            construct_at(index, hash, std::forward<K>(key),
+                         std::forward<Args>(args)...);
+        } catch (...) {
+            restore_table(old);
+
+            throw;
+        }
+
+        relocate_from(old);
+
+        return iterator_at(index);
+    }
+
+    template <typename K, typename ...Args>
+    void construct_at(size_type index, std::size_t hash, K &&key,
+                      Args &&...args) {
+        SlotTraits::construct(slot_allocator(), slots_ + index,
+                              std::piecewise_construct,
+                              std::forward_as_tuple(std::forward<K>(key)),
+                              std::forward_as_tuple(
+                                  std::forward<Args>(args)...
+                              ));
+
+        if (control()[index] == detail::control_empty) {
+            --growth_left_;
+        }
+
+        set_control(index, low_bits(hash));
+        ++size_;
+    }
+
+    // a slot can go straight back to empty when no probe sequence could
+    // have passed over it, which is when the run of full slots around it is
+    // shorter than a group; otherwise it becomes a tombstone
+    void erase_at(size_type index) noexcept {
+        SlotTraits::destroy(slot_allocator(), slots_ + index);
+        --size_;
+
+        const size_type before = (index - Group::width) & capacity_;
+        const auto empty_after = Group{ control() + index }.match_empty();
+        const auto empty_before = Group{ control() + before }.match_empty();
+
+        const bool was_never_full =
+            empty_before && empty_after
+            && static_cast<std::size_t>(
+                   empty_after.trailing_zeros()
+                   + empty_before.template leading_zeros<Group::width>()
+               ) < Group::width;
+
+        if (was_never_full) {
+            set_control(index, detail::control_empty);
+            ++growth_left_;
+        } else {
+            set_control(index, detail::control_deleted);
+        }
+    }
+
+    // the storage of a table that has been replaced but not yet freed
+    struct Table {
+        ControlByte *control;
+        SlotT *slots;
+        size_type capacity;
+        size_type growth_left;
+    };
+
+    // doubles the table, or rehashes it at the same size when at least half
+    // of the used capacity is tombstones
+    size_type grown_capacity() const noexcept {
+        if (capacity_ != 0 && size_ * 2 <= growth_for(capacity_)) {
+            return capacity_;
+        }
+
+        return capacity_ == 0 ? Group::width - 1 : capacity_ * 2 + 1;
+    }
+
+    void rehash(size_type new_capacity) {
+        relocate_from(replace_table(new_capacity));
+    }
+
+    // makes an empty table of new_capacity slots current and returns the
+    // old one, whose slots are still full
+    Table replace_table(size_type new_capacity) {
+        ControlAllocator control_allocator{ slot_allocator() };
+
+        SlotT *const new_slots =
+            SlotTraits::allocate(slot_allocator(), new_capacity);
+        ControlByte *new_control = nullptr;
+
+        try {
+            new_control = ControlTraits::allocate(control_allocator,
+                                                  control_size(new_capacity));
+        } catch (...) {
+            SlotTraits::deallocate(slot_allocator(), new_slots, new_capacity);
+
+            throw;
+        }
+
+        const Table old{ control(), slots_, capacity_, growth_left_ };
+
+        policies_and_control_.second() = new_control;
+        slots_ = new_slots;
+        capacity_ = new_capacity;
+        reset_control();
+        growth_left_ = growth_for(new_capacity) - size_;
+
+        return old;
+    }
+
+    // moves every full slot of old into the current table and frees old
+    void relocate_from(const Table &old) {
+        for (size_type i = 0; i < old.capacity; ++i) {
+            if (old.control[i] >= 0) {
+                const std::size_t hash = hash_of(old.slots[i].first());
+                const size_type index = find_free(hash);
+
+                relocate_at(old.slots + i, slots_ + index);
+                set_control(index, low_bits(hash));
+            }
+        }
+
+        if (old.capacity != 0) {
+            ControlAllocator control_allocator{ slot_allocator() };
+
+            ControlTraits::deallocate(control_allocator, old.control,
+                                      control_size(old.capacity));
+            SlotTraits::deallocate(slot_allocator(), old.slots, old.capacity);
+        }
+    }
+
+    // frees the current table, which must hold no elements, and makes old
+    // current again
+    void restore_table(const Table &old) noexcept {
+        deallocate();
+
+        policies_and_control_.second() = old.control;
+        slots_ = old.slots;
+        capacity_ = old.capacity;
+        growth_left_ = old.growth_left;
+    }
+
+    // one byte per slot, the sentinel, and the cloned bytes
+    static constexpr size_type control_size(size_type capacity) noexcept {
+        return capacity + Group::width;
+    }
+
+    void reset_control() noexcept {
+        std::memset(control(), detail::control_empty,
+                    control_size(capacity_));
+        control()[capacity_] = detail::control_sentinel;
+    }
+
+    void destroy_slots() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<SlotT>) {
+            for (size_type i = 0; i < capacity_; ++i) {
+                if (control()[i] >= 0) {
+                    SlotTraits::destroy(slot_allocator(), slots_ + i);
+                }
+            }
+        }
+    }
+
+    void deallocate() noexcept {
+        if (capacity_ != 0) {
+            ControlAllocator control_allocator{ slot_allocator() };
+
+            ControlTraits::deallocate(control_allocator, control(),
+                                      control_size(capacity_));
+            SlotTraits::deallocate(slot_allocator(), slots_, capacity_);
+        }
+    }
+
+    void reset_to_empty() noexcept {
+        policies_and_control_.second() = empty_group();
+        slots_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+        growth_left_ = 0;
+    }
+
+    Pair<Tuple<Hash, KeyEqual, SlotAllocator>, ControlByte*>
+        policies_and_control_;
+    SlotT *slots_ = nullptr;
+    size_type size_ = 0;
+    size_type capacity_ = 0;
+    size_type growth_left_ = 0;
+};
+
+template <typename K, typename V, typename H, typename E, typename A>
+void swap(FlatMap<K, V, H, E, A> &lhs, FlatMap<K, V, H, E, A> &rhs)
+noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool operator==(const FlatMap<K, V, H, E, A> &lhs,
+                const FlatMap<K, V, H, E, A> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+
+    for (const auto [key, value] : lhs) {
+        const auto it = rhs.find(key);
+
+        if (it == rhs.end() || !(it->second() == value)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool operator!=(const FlatMap<K, V, H, E, A> &lhs,
+                const FlatMap<K, V, H, E, A> &rhs) {
+    return !(lhs == rhs);
+}
+
+} // namespace gregjm
+
+#endif
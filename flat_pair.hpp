@@ -0,0 +1,476 @@
+#ifndef GREGJM_FLAT_PAIR_HPP
+#define GREGJM_FLAT_PAIR_HPP
+
+#include "pair.hpp"
+#include "relocate.hpp"
+#include "tuple.hpp"
+
+#include <cstddef> // std::size_t
+#include <iostream> // std::basic_ostream
+#include <tuple> // std::tuple_cat, std::forward_as_tuple, std::get
+#include <type_traits>
+#include <utility> // std::forward, std::index_sequence, std::swap
+
+namespace gregjm {
+
+template <typename First, typename Second>
+class FlatPair;
+
+namespace detail {
+
+template <typename Lhs, typename Rhs>
+struct ConcatTypeLists;
+
+template <typename ...Ts, typename ...Us>
+struct ConcatTypeLists<TypeList<Ts...>, TypeList<Us...>> {
+    using type = TypeList<Ts..., Us...>;
+};
+
+// the non-Pair members of T in declaration order, looking through nested
+// Pairs. only Pairs held by value are flattened; references to Pairs and
+// const Pairs are kept as leaves
+template <typename T>
+struct FlatLeaves {
+    using type = TypeList<T>;
+};
+
+template <typename First, typename Second>
+struct FlatLeaves<Pair<First, Second>> {
+    using type = typename ConcatTypeLists<
+        typename FlatLeaves<First>::type,
+        typename FlatLeaves<Second>::type
+    >::type;
+};
+
+template <typename T>
+using FlatLeavesT = typename FlatLeaves<T>::type;
+
+template <typename List>
+struct TypeListSize;
+
+template <typename ...Ts>
+struct TypeListSize<TypeList<Ts...>>
+: std::integral_constant<std::size_t, sizeof...(Ts)> { };
+
+template <typename T>
+static constexpr inline std::size_t flat_size_v =
+    TypeListSize<FlatLeavesT<T>>::value;
+
+template <std::size_t I, typename List>
+struct TypeListElement;
+
+template <std::size_t I, typename ...Ts>
+struct TypeListElement<I, TypeList<Ts...>> {
+    using type = NthTypeT<I, Ts...>;
+};
+
+template <std::size_t I, typename List>
+using TypeListElementT = typename TypeListElement<I, List>::type;
+
+// all leaves in one block, ordered by decreasing alignment so that no
+// padding is needed between them
+template <typename List>
+struct FlatStorage;
+
+template <typename ...Ts>
+struct FlatStorage<TypeList<Ts...>> {
+    using type = TupleStorage<AlignmentOrderT<Ts...>, Ts...>;
+};
+
+template <typename T>
+using FlatStorageT = typename FlatStorage<FlatLeavesT<T>>::type;
+
+template <typename Storage, typename Node, std::size_t Offset>
+class FlatView;
+
+// the node of type Node whose first leaf is leaf Offset of storage: a
+// reference to the leaf itself, or a view if Node is a flattened Pair
+template <typename Node, std::size_t Offset, typename Storage>
+constexpr decltype(auto) flat_node(Storage &storage) noexcept {
+    if constexpr (IsPair<Node>::value) {
+        return FlatView<Storage, Node, Offset>{ storage };
+    } else {
+        return storage.template element<Offset>();
+    }
+}
+
+template <std::size_t I, typename T>
+constexpr decltype(auto) flat_child(T &&node) noexcept {
+    if constexpr (is_pair_v<T>) {
+        return gregjm::get<I>(std::forward<T>(node));
+    } else if constexpr (I == 0) {
+        return node.first();
+    } else {
+        return node.second();
+    }
+}
+
+// a tuple of references to the leaves of value, which is a Pair or a
+// FlatView if Node is a Pair and is otherwise the leaf itself
+template <typename Node, typename T>
+constexpr auto flat_leaf_refs(T &&value) noexcept {
+    if constexpr (IsPair<Node>::value) {
+        return std::tuple_cat(
+            flat_leaf_refs<std::tuple_element_t<0, Node>>(
+                flat_child<0>(std::forward<T>(value))
+            ),
+            flat_leaf_refs<std::tuple_element_t<1, Node>>(
+                flat_child<1>(std::forward<T>(value))
+            )
+        );
+    } else {
+        return std::forward_as_tuple(std::forward<T>(value));
+    }
+}
+
+// stands in for a nested Pair<First, Second> inside a FlatPair, whose
+// members are no longer stored together. like Pair<First&, Second&>, a view
+// is a reference: assigning to it assigns to the leaves it refers to
+template <typename Storage, typename First, typename Second,
+          std::size_t Offset>
+class FlatView<Storage, Pair<First, Second>, Offset> {
+public:
+    using first_type = First;
+    using second_type = Second;
+
+    constexpr explicit FlatView(Storage &storage) noexcept
+    : storage_{ &storage } { }
+
+    constexpr FlatView(const FlatView &other) noexcept = default;
+
+    constexpr const FlatView& operator=(const FlatView &other) const {
+        return assign(other);
+    }
+
+    template <typename OtherStorage, std::size_t OtherOffset>
+    constexpr const FlatView& operator=(
+        const FlatView<OtherStorage, Pair<First, Second>, OtherOffset> &other
+    ) const {
+        return assign(other);
+    }
+
+    constexpr const FlatView& operator=(const Pair<First, Second> &other)
+    const {
+        return assign(other);
+    }
+
+    constexpr decltype(auto) first() const noexcept {
+        return flat_node<First, Offset>(*storage_);
+    }
+
+    constexpr decltype(auto) second() const noexcept {
+        return flat_node<Second, Offset + flat_size_v<First>>(*storage_);
+    }
+
+    constexpr operator Pair<First, Second>() const {
+        return Pair<First, Second>{ first(), second() };
+    }
+
+    friend constexpr bool operator==(const FlatView &lhs,
+                                     const Pair<First, Second> &rhs) {
+        return lhs.first() == rhs.first() && lhs.second() == rhs.second();
+    }
+
+    friend constexpr bool operator==(const Pair<First, Second> &lhs,
+                                     const FlatView &rhs) {
+        return rhs == lhs;
+    }
+
+    friend constexpr bool operator!=(const FlatView &lhs,
+                                     const Pair<First, Second> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator!=(const Pair<First, Second> &lhs,
+                                     const FlatView &rhs) {
+        return !(rhs == lhs);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits>&
+    operator<<(std::basic_ostream<CharT, Traits> &os, const FlatView &view) {
+        return os << '(' << view.first() << ", " << view.second() << ')';
+    }
+
+private:
+    template <typename Other>
+    constexpr const FlatView& assign(const Other &other) const {
+        first() = other.first();
+        second() = other.second();
+
+        return *this;
+    }
+
+    Storage *storage_;
+};
+
+template <typename T>
+struct FlatPairOf;
+
+template <typename First, typename Second>
+struct FlatPairOf<Pair<First, Second>> {
+    using type = FlatPair<First, Second>;
+};
+
+template <typename Leaves>
+struct IsNothrowFlatLessThanComparable;
+
+template <typename ...Ts>
+struct IsNothrowFlatLessThanComparable<TypeList<Ts...>>
+: std::bool_constant<(is_nothrow_three_way_comparable_v<Ts, Ts> && ...)> { };
+
+template <typename Leaves>
+struct IsNothrowFlatSwappable;
+
+template <typename ...Ts>
+struct IsNothrowFlatSwappable<TypeList<Ts...>>
+: std::conjunction<std::is_nothrow_swappable<Ts>...> { };
+
+template <typename T, std::size_t ...Is>
+constexpr bool flat_equal(const T &lhs, const T &rhs,
+                          std::index_sequence<Is...>) {
+    return ((lhs.template leaf<Is>() == rhs.template leaf<Is>()) && ...);
+}
+
+template <std::size_t I, std::size_t N, typename T>
+constexpr bool flat_less(const T &lhs, const T &rhs) {
+    if constexpr (I + 1 == N) {
+        return lhs.template leaf<I>() < rhs.template leaf<I>();
+    } else {
+        if (const int result = compare_three_way(lhs.template leaf<I>(),
+                                                 rhs.template leaf<I>());
+            result != 0) {
+            return result < 0;
+        }
+
+        return flat_less<I + 1, N>(lhs, rhs);
+    }
+}
+
+} // namespace detail
+
+// a Pair<First, Second> whose nested Pairs are flattened into one block of
+// storage. Pair<std::uint8_t, Pair<std::uint64_t, std::uint8_t>> pads both
+// the inner and the outer Pair and takes 24 bytes, where
+// FlatPair<std::uint8_t, Pair<std::uint64_t, std::uint8_t>> takes 16. the
+// leaves are laid out by decreasing alignment, but first() and second() keep
+// the nested structure: a nested Pair is returned as a view that has its own
+// first() and second() and converts to the Pair it stands for. comparisons
+// are lexicographic over the leaves, which orders the same as the nested
+// Pairs would
+template <typename First, typename Second>
+class FlatPair {
+private:
+    using NodeT = Pair<First, Second>;
+    using LeavesT = detail::FlatLeavesT<NodeT>;
+    using StorageT = detail::FlatStorageT<NodeT>;
+
+    template <std::size_t I>
+    using LeafT = detail::TypeListElementT<I, LeavesT>;
+
+public:
+    using first_type = First;
+    using second_type = Second;
+
+    static constexpr inline std::size_t num_leaves = detail::flat_size_v<NodeT>;
+
+    constexpr FlatPair()
+    noexcept(std::is_nothrow_default_constructible_v<First>
+             && std::is_nothrow_default_constructible_v<Second>) = default;
+
+    constexpr FlatPair(const First &first, const Second &second)
+    noexcept(std::is_nothrow_copy_constructible_v<First>
+             && std::is_nothrow_copy_constructible_v<Second>)
+    : FlatPair(detail::from_tuple,
+               std::tuple_cat(detail::flat_leaf_refs<First>(first),
+                              detail::flat_leaf_refs<Second>(second)),
+               std::make_index_sequence<num_leaves>{ }) { }
+
+    // a nested Pair argument may be a Pair of any types that its leaves can
+    // be constructed from, or a view of a nested Pair in another FlatPair
+    template <typename F, typename S,
+              typename = std::enable_if_t<
+                  std::is_constructible_v<First, F>
+                  && std::is_constructible_v<Second, S>
+              >>
+    constexpr FlatPair(F &&first, S &&second)
+    noexcept(std::is_nothrow_constructible_v<First, F>
+             && std::is_nothrow_constructible_v<Second, S>)
+    : FlatPair(detail::from_tuple,
+               std::tuple_cat(
+                   detail::flat_leaf_refs<First>(std::forward<F>(first)),
+                   detail::flat_leaf_refs<Second>(std::forward<S>(second))
+               ),
+               std::make_index_sequence<num_leaves>{ }) { }
+
+    constexpr FlatPair(const NodeT &pair)
+    noexcept(std::is_nothrow_copy_constructible_v<NodeT>)
+    : FlatPair(pair.first(), pair.second()) { }
+
+    constexpr FlatPair(NodeT &&pair)
+    noexcept(std::is_nothrow_move_constructible_v<NodeT>)
+    : FlatPair(gregjm::get<0>(std::move(pair)),
+               gregjm::get<1>(std::move(pair))) { }
+
+    // the I-th leaf in declaration order, counting through nested Pairs
+    template <std::size_t I>
+    constexpr inline LeafT<I>& leaf() noexcept {
+        return storage_.template element<I>();
+    }
+
+    template <std::size_t I>
+    constexpr inline const LeafT<I>& leaf() const noexcept {
+        return storage_.template element<I>();
+    }
+
+    constexpr decltype(auto) first() noexcept {
+        return detail::flat_node<First, 0>(storage_);
+    }
+
+    constexpr decltype(auto) first() const noexcept {
+        return detail::flat_node<First, 0>(storage_);
+    }
+
+    constexpr decltype(auto) second() noexcept {
+        return detail::flat_node<Second, detail::flat_size_v<First>>(storage_);
+    }
+
+    constexpr decltype(auto) second() const noexcept {
+        return detail::flat_node<Second, detail::flat_size_v<First>>(storage_);
+    }
+
+    explicit constexpr operator NodeT() const {
+        return NodeT{ first(), second() };
+    }
+
+    constexpr void swap(FlatPair &other)
+    noexcept(detail::IsNothrowFlatSwappable<LeavesT>::value) {
+        swap_leaves(other, std::make_index_sequence<num_leaves>{ });
+    }
+
+private:
+    template <typename LeafTuple, std::size_t ...Is>
+    constexpr FlatPair(detail::FromTupleT, LeafTuple &&leaves,
+                       std::index_sequence<Is...>)
+    : storage_(std::in_place, std::get<Is>(std::move(leaves))...) { }
+
+    template <std::size_t ...Is>
+    constexpr void swap_leaves(FlatPair &other, std::index_sequence<Is...>) {
+        (swap_leaf<Is>(other), ...);
+    }
+
+    template <std::size_t I>
+    constexpr void swap_leaf(FlatPair &other) {
+        if constexpr (!detail::TupleElementStorage<I, LeavesT>::is_shared) {
+            detail::swap_values(leaf<I>(), other.template leaf<I>());
+        }
+    }
+
+    StorageT storage_;
+};
+
+template <typename CharT, typename Traits, typename First, typename Second>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits> &os,
+           const FlatPair<First, Second> &pair) {
+    return os << '(' << pair.first() << ", " << pair.second() << ')';
+}
+
+template <typename First, typename Second>
+constexpr inline void swap(FlatPair<First, Second> &lhs,
+                           FlatPair<First, Second> &rhs)
+noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_equality_comparable_v<First>
+              && detail::is_equality_comparable_v<Second>
+          >>
+constexpr inline bool operator==(const FlatPair<First, Second> &lhs,
+                                 const FlatPair<First, Second> &rhs) {
+    return detail::flat_equal(
+        lhs, rhs,
+        std::make_index_sequence<FlatPair<First, Second>::num_leaves>{ }
+    );
+}
+
+template <typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_equality_comparable_v<First>
+              && detail::is_equality_comparable_v<Second>
+          >>
+constexpr inline bool operator!=(const FlatPair<First, Second> &lhs,
+                                 const FlatPair<First, Second> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_less_than_comparable_v<First>
+              && detail::is_less_than_comparable_v<Second>
+          >>
+constexpr inline bool operator<(
+    const FlatPair<First, Second> &lhs, const FlatPair<First, Second> &rhs
+) noexcept(detail::IsNothrowFlatLessThanComparable<
+               detail::FlatLeavesT<Pair<First, Second>>
+           >::value) {
+    return detail::flat_less<0, FlatPair<First, Second>::num_leaves>(lhs, rhs);
+}
+
+template <typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_less_than_comparable_v<First>
+              && detail::is_less_than_comparable_v<Second>
+          >>
+constexpr inline bool operator<=(
+    const FlatPair<First, Second> &lhs, const FlatPair<First, Second> &rhs
+) noexcept(noexcept(rhs < lhs)) {
+    return !(rhs < lhs);
+}
+
+template <typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_less_than_comparable_v<First>
+              && detail::is_less_than_comparable_v<Second>
+          >>
+constexpr inline bool operator>(
+    const FlatPair<First, Second> &lhs, const FlatPair<First, Second> &rhs
+) noexcept(noexcept(rhs < lhs)) {
+    return rhs < lhs;
+}
+
+template <typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_less_than_comparable_v<First>
+              && detail::is_less_than_comparable_v<Second>
+          >>
+constexpr inline bool operator>=(
+    const FlatPair<First, Second> &lhs, const FlatPair<First, Second> &rhs
+) noexcept(noexcept(lhs < rhs)) {
+    return !(lhs < rhs);
+}
+
+// the FlatPair with the same structure as Pair P
+template <typename P>
+using flat_pair_t = typename detail::FlatPairOf<P>::type;
+
+template <typename First, typename Second>
+constexpr FlatPair<First, Second> flatten(const Pair<First, Second> &pair) {
+    return FlatPair<First, Second>{ pair };
+}
+
+template <typename First, typename Second>
+constexpr FlatPair<First, Second> flatten(Pair<First, Second> &&pair) {
+    return FlatPair<First, Second>{ std::move(pair) };
+}
+
+template <typename First, typename Second>
+struct is_trivially_relocatable<FlatPair<First, Second>>
+: std::bool_constant<is_trivially_relocatable_v<First>
+                     && is_trivially_relocatable_v<Second>> { };
+
+} // namespace gregjm
+
+#endif
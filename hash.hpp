@@ -0,0 +1,169 @@
+#ifndef GREGJM_HASH_HPP
+#define GREGJM_HASH_HPP
+
+#include "pair.hpp"
+#include "span.hpp"
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <functional> // std::hash
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace gregjm {
+namespace detail {
+
+// the batch hash loads whole pairs as vectors, so the members must be laid
+// out back to back and either both be 64-bit words or both be unsigned 32-bit
+// integers, which are widened by masking and shifting
+template <typename First, typename Second>
+static constexpr inline bool is_vector_hashable_64_v =
+    is_hash_word_v<First> && is_hash_word_v<Second>
+    && sizeof(First) == 8 && sizeof(Second) == 8
+    && sizeof(Pair<First, Second>) == 16;
+
+template <typename First, typename Second>
+static constexpr inline bool is_vector_hashable_32_v =
+    std::is_integral_v<First> && std::is_unsigned_v<First>
+    && std::is_integral_v<Second> && std::is_unsigned_v<Second>
+    && sizeof(First) == 4 && sizeof(Second) == 4
+    && sizeof(Pair<First, Second>) == 8;
+
+template <typename First, typename Second>
+static constexpr inline bool is_vector_hashable_v =
+    (is_vector_hashable_64_v<First, Second>
+     || is_vector_hashable_32_v<First, Second>)
+    && sizeof(std::size_t) == 8;
+
+#if defined(__AVX2__)
+// multiply_fold on four lanes. AVX2 only multiplies 32-bit halves, so each
+// 128-bit product is put together from four partial products
+inline __m256i multiply_fold(__m256i lhs, __m256i rhs) noexcept {
+    const __m256i low_mask = _mm256_set1_epi64x(0xffffffff);
+
+    const __m256i lhs_high = _mm256_srli_epi64(lhs, 32);
+    const __m256i rhs_high = _mm256_srli_epi64(rhs, 32);
+
+    const __m256i low_low = _mm256_mul_epu32(lhs, rhs);
+    const __m256i middle = _mm256_add_epi64(_mm256_mul_epu32(lhs_high, rhs),
+                                            _mm256_srli_epi64(low_low, 32));
+    const __m256i other_middle = _mm256_add_epi64(
+        _mm256_mul_epu32(lhs, rhs_high), _mm256_and_si256(middle, low_mask)
+    );
+
+    const __m256i high = _mm256_add_epi64(
+        _mm256_add_epi64(_mm256_mul_epu32(lhs_high, rhs_high),
+                         _mm256_srli_epi64(middle, 32)),
+        _mm256_srli_epi64(other_middle, 32)
+    );
+    const __m256i low = _mm256_or_si256(_mm256_slli_epi64(other_middle, 32),
+                                        _mm256_and_si256(low_low, low_mask));
+
+    return _mm256_xor_si256(low, high);
+}
+
+// hash_words on four lanes, for members that are already xored with their
+// seeds
+inline __m256i hash_seeded_words(__m256i lhs, __m256i rhs) noexcept {
+    const __m256i mixed = _mm256_xor_si256(multiply_fold(lhs, rhs),
+                                           _mm256_xor_si256(lhs, rhs));
+
+    return multiply_fold(
+        mixed, _mm256_set1_epi64x(static_cast<long long>(hash_seed_third))
+    );
+}
+
+template <typename First, typename Second>
+std::size_t hash_batch_avx2(const Pair<First, Second> *pairs,
+                            std::size_t size, std::size_t *hashes) noexcept {
+    const __m256i seed_first =
+        _mm256_set1_epi64x(static_cast<long long>(hash_seed_first));
+    const __m256i seed_second =
+        _mm256_set1_epi64x(static_cast<long long>(hash_seed_second));
+
+    std::size_t i = 0;
+
+    for (; i + 4 <= size; i += 4) {
+        __m256i hashed;
+
+        if constexpr (sizeof(Pair<First, Second>) == 16) {
+            // lanes hold (first, second) of pairs i, i + 1 and i + 2, i + 3
+            const __m256i front = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(pairs + i)
+            );
+            const __m256i back = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(pairs + i + 2)
+            );
+
+            // unpacking works within 128-bit halves, so the lanes come out
+            // in the order i, i + 2, i + 1, i + 3 and are put back below
+            const __m256i firsts = _mm256_xor_si256(
+                _mm256_unpacklo_epi64(front, back), seed_first
+            );
+            const __m256i seconds = _mm256_xor_si256(
+                _mm256_unpackhi_epi64(front, back), seed_second
+            );
+
+            hashed = _mm256_permute4x64_epi64(
+                hash_seeded_words(firsts, seconds), 0xd8
+            );
+        } else {
+            // each lane holds one whole pair, first in the low half
+            const __m256i packed = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(pairs + i)
+            );
+
+            const __m256i firsts = _mm256_xor_si256(
+                _mm256_and_si256(packed, _mm256_set1_epi64x(0xffffffff)),
+                seed_first
+            );
+            const __m256i seconds = _mm256_xor_si256(
+                _mm256_srli_epi64(packed, 32), seed_second
+            );
+
+            hashed = hash_seeded_words(firsts, seconds);
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(hashes + i), hashed);
+    }
+
+    return i;
+}
+#endif
+
+} // namespace detail
+
+// sets hashes[i] to std::hash<Pair<First, Second>>{ }(pairs[i]) for every
+// pair. hashes must be at least as long as pairs. with AVX2, pairs of two
+// 64-bit integers or pointers, or of two unsigned 32-bit integers, are
+// hashed four at a time
+template <typename First, typename Second>
+void hash_batch(Span<const Pair<First, Second>> pairs,
+                Span<std::size_t> hashes)
+noexcept(noexcept(std::hash<Pair<First, Second>>{ }(pairs[0]))) {
+    assert(hashes.size() >= pairs.size()
+           && "hash_batch needs one output per pair");
+
+    std::size_t i = 0;
+
+#if defined(__AVX2__)
+    if constexpr (detail::is_vector_hashable_v<First, Second>) {
+        i = detail::hash_batch_avx2(pairs.data(), pairs.size(),
+                                    hashes.data());
+    }
+#endif
+
+    const std::hash<Pair<First, Second>> hasher;
+
+    for (; i < pairs.size(); ++i) {
+        hashes[i] = hasher(pairs[i]);
+    }
+}
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,332 @@
+#ifndef GREGJM_PACKED_PAIR_HPP
+#define GREGJM_PACKED_PAIR_HPP
+
+#include "pair.hpp"
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int64_t, std::uint8_t, std::uint16_t, ...
+#include <iostream> // std::basic_ostream
+#include <type_traits>
+#include <utility> // std::as_const
+
+namespace gregjm {
+namespace detail {
+
+// the smallest unsigned integer type with at least Bits bits
+template <std::size_t Bits>
+using PackedWordT = std::conditional_t<
+    Bits <= 8, std::uint8_t,
+    std::conditional_t<
+        Bits <= 16, std::uint16_t,
+        std::conditional_t<Bits <= 32, std::uint32_t, std::uint64_t>
+    >
+>;
+
+template <typename T, typename = void>
+struct PackedUnderlying {
+    using type = T;
+};
+
+template <typename T>
+struct PackedUnderlying<T, std::enable_if_t<std::is_enum_v<T>>> {
+    using type = std::underlying_type_t<T>;
+};
+
+template <typename T>
+using PackedUnderlyingT = typename PackedUnderlying<T>::type;
+
+template <typename T>
+static constexpr inline bool is_packable_v =
+    (std::is_integral_v<T> || std::is_enum_v<T>)
+    && !std::is_const_v<T> && !std::is_volatile_v<T>;
+
+// converts a field of type T to and from its low Bits bits. signed fields
+// are stored in two's complement and sign extended when decoded
+template <typename T, std::size_t Bits>
+struct PackedField {
+    using Underlying = PackedUnderlyingT<T>;
+
+    static constexpr inline bool is_signed = std::is_signed_v<Underlying>;
+    static constexpr inline std::uint64_t mask =
+        Bits == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << Bits) - 1;
+
+    static constexpr bool fits(T value) noexcept {
+        const auto underlying = static_cast<Underlying>(value);
+
+        if constexpr (Bits == 64) {
+            return true;
+        } else if constexpr (is_signed) {
+            const auto extended = static_cast<std::int64_t>(underlying);
+            const auto limit = std::int64_t{ 1 } << (Bits - 1);
+
+            return extended >= -limit && extended < limit;
+        } else {
+            return (static_cast<std::uint64_t>(underlying) & ~mask) == 0;
+        }
+    }
+
+    static constexpr std::uint64_t encode(T value) noexcept {
+        return static_cast<std::uint64_t>(static_cast<Underlying>(value))
+               & mask;
+    }
+
+    static constexpr T decode(std::uint64_t bits) noexcept {
+        bits &= mask;
+
+        if constexpr (is_signed) {
+            const std::uint64_t sign = std::uint64_t{ 1 } << (Bits - 1);
+            bits = (bits ^ sign) - sign;
+        }
+
+        return static_cast<T>(static_cast<Underlying>(bits));
+    }
+};
+
+// returned by the non-const first() and second() of PackedPair. it reads
+// and writes its field in place, but only supports conversion and assignment
+template <typename Packed, std::size_t Index>
+class PackedFieldReference {
+public:
+    using value_type = std::conditional_t<Index == 0,
+                                          typename Packed::first_type,
+                                          typename Packed::second_type>;
+
+    constexpr explicit PackedFieldReference(Packed &packed) noexcept
+    : packed_{ &packed } { }
+
+    constexpr PackedFieldReference(const PackedFieldReference&) noexcept =
+        default;
+
+    constexpr operator value_type() const noexcept {
+        return get();
+    }
+
+    constexpr value_type get() const noexcept {
+        if constexpr (Index == 0) {
+            return std::as_const(*packed_).first();
+        } else {
+            return std::as_const(*packed_).second();
+        }
+    }
+
+    constexpr const PackedFieldReference& operator=(value_type value) const
+    noexcept {
+        if constexpr (Index == 0) {
+            packed_->set_first(value);
+        } else {
+            packed_->set_second(value);
+        }
+
+        return *this;
+    }
+
+    constexpr const PackedFieldReference&
+    operator=(const PackedFieldReference &other) const noexcept {
+        return *this = other.get();
+    }
+
+private:
+    Packed *packed_;
+};
+
+} // namespace detail
+
+// a pair of integers or enums packed into the smallest unsigned word that
+// holds FirstBits + SecondBits bits. first is stored above second, so when
+// neither field is signed the packed words order the same way as the pairs
+// and comparisons are a single integer compare. values that do not fit in
+// their field are truncated; debug builds assert that they fit
+template <typename First, std::size_t FirstBits, typename Second,
+          std::size_t SecondBits>
+class PackedPair {
+private:
+    using FirstField = detail::PackedField<First, FirstBits>;
+    using SecondField = detail::PackedField<Second, SecondBits>;
+
+    static_assert(detail::is_packable_v<First>
+                  && detail::is_packable_v<Second>,
+                  "PackedPair members must be integral or enumeration types");
+    static_assert(FirstBits > 0 && SecondBits > 0,
+                  "PackedPair fields must be at least one bit wide");
+    static_assert(FirstBits <= sizeof(First) * 8
+                  && SecondBits <= sizeof(Second) * 8,
+                  "PackedPair fields cannot be wider than their types");
+    static_assert(FirstBits + SecondBits <= 64,
+                  "PackedPair fields must fit in 64 bits");
+
+public:
+    using first_type = First;
+    using second_type = Second;
+    using word_type = detail::PackedWordT<FirstBits + SecondBits>;
+
+    static constexpr inline std::size_t first_bits = FirstBits;
+    static constexpr inline std::size_t second_bits = SecondBits;
+
+    // true when comparing packed words gives the same result as comparing
+    // the members one by one
+    static constexpr inline bool is_word_ordered =
+        !FirstField::is_signed && !SecondField::is_signed;
+
+    constexpr PackedPair() noexcept = default;
+
+    constexpr PackedPair(First first, Second second) noexcept
+    : word_{ encode(first, second) } { }
+
+    constexpr explicit PackedPair(const Pair<First, Second> &pair) noexcept
+    : PackedPair(pair.first(), pair.second()) { }
+
+    constexpr explicit operator Pair<First, Second>() const noexcept {
+        return { first(), second() };
+    }
+
+    static constexpr bool fits(First first, Second second) noexcept {
+        return FirstField::fits(first) && SecondField::fits(second);
+    }
+
+    static constexpr word_type encode(First first, Second second) noexcept {
+        assert(fits(first, second)
+               && "PackedPair member does not fit in its field");
+
+        return static_cast<word_type>(
+            (FirstField::encode(first) << SecondBits)
+            | SecondField::encode(second)
+        );
+    }
+
+    static constexpr Pair<First, Second> decode(word_type word) noexcept {
+        return { FirstField::decode(shifted_first(word)),
+                 SecondField::decode(word) };
+    }
+
+    // word must have been produced by encode or word()
+    static constexpr PackedPair from_word(word_type word) noexcept {
+        return PackedPair{ FromWord{ }, word };
+    }
+
+    constexpr word_type word() const noexcept {
+        return word_;
+    }
+
+    constexpr detail::PackedFieldReference<PackedPair, 0> first() noexcept {
+        return detail::PackedFieldReference<PackedPair, 0>{ *this };
+    }
+
+    constexpr First first() const noexcept {
+        return FirstField::decode(shifted_first(word_));
+    }
+
+    constexpr detail::PackedFieldReference<PackedPair, 1> second() noexcept {
+        return detail::PackedFieldReference<PackedPair, 1>{ *this };
+    }
+
+    constexpr Second second() const noexcept {
+        return SecondField::decode(word_);
+    }
+
+    constexpr void set_first(First first) noexcept {
+        word_ = encode(first, second());
+    }
+
+    constexpr void set_second(Second second) noexcept {
+        word_ = encode(first(), second);
+    }
+
+    constexpr void swap(PackedPair &other) noexcept {
+        const word_type word = word_;
+        word_ = other.word_;
+        other.word_ = word;
+    }
+
+private:
+    struct FromWord { };
+
+    constexpr PackedPair(FromWord, word_type word) noexcept : word_{ word } { }
+
+    static constexpr std::uint64_t shifted_first(word_type word) noexcept {
+        return static_cast<std::uint64_t>(word) >> SecondBits;
+    }
+
+    word_type word_;
+};
+
+template <typename CharT, typename Traits, typename First,
+          std::size_t FirstBits, typename Second, std::size_t SecondBits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits> &os,
+           const PackedPair<First, FirstBits, Second, SecondBits> &pair) {
+    return os << static_cast<Pair<First, Second>>(pair);
+}
+
+template <typename First, std::size_t FirstBits, typename Second,
+          std::size_t SecondBits>
+constexpr void swap(PackedPair<First, FirstBits, Second, SecondBits> &lhs,
+                    PackedPair<First, FirstBits, Second, SecondBits> &rhs)
+noexcept {
+    lhs.swap(rhs);
+}
+
+// unused bits are always zero, so equal pairs have equal words
+template <typename First, std::size_t FirstBits, typename Second,
+          std::size_t SecondBits>
+constexpr bool operator==(
+    const PackedPair<First, FirstBits, Second, SecondBits> &lhs,
+    const PackedPair<First, FirstBits, Second, SecondBits> &rhs
+) noexcept {
+    return lhs.word() == rhs.word();
+}
+
+template <typename First, std::size_t FirstBits, typename Second,
+          std::size_t SecondBits>
+constexpr bool operator!=(
+    const PackedPair<First, FirstBits, Second, SecondBits> &lhs,
+    const PackedPair<First, FirstBits, Second, SecondBits> &rhs
+) noexcept {
+    return lhs.word() != rhs.word();
+}
+
+template <typename First, std::size_t FirstBits, typename Second,
+          std::size_t SecondBits>
+constexpr bool operator<(
+    const PackedPair<First, FirstBits, Second, SecondBits> &lhs,
+    const PackedPair<First, FirstBits, Second, SecondBits> &rhs
+) noexcept {
+    if constexpr (PackedPair<First, FirstBits, Second,
+                             SecondBits>::is_word_ordered) {
+        return lhs.word() < rhs.word();
+    } else {
+        return static_cast<Pair<First, Second>>(lhs)
+               < static_cast<Pair<First, Second>>(rhs);
+    }
+}
+
+template <typename First, std::size_t FirstBits, typename Second,
+          std::size_t SecondBits>
+constexpr bool operator<=(
+    const PackedPair<First, FirstBits, Second, SecondBits> &lhs,
+    const PackedPair<First, FirstBits, Second, SecondBits> &rhs
+) noexcept {
+    return !(rhs < lhs);
+}
+
+template <typename First, std::size_t FirstBits, typename Second,
+          std::size_t SecondBits>
+constexpr bool operator>(
+    const PackedPair<First, FirstBits, Second, SecondBits> &lhs,
+    const PackedPair<First, FirstBits, Second, SecondBits> &rhs
+) noexcept {
+    return rhs < lhs;
+}
+
+template <typename First, std::size_t FirstBits, typename Second,
+          std::size_t SecondBits>
+constexpr bool operator>=(
+    const PackedPair<First, FirstBits, Second, SecondBits> &lhs,
+    const PackedPair<First, FirstBits, Second, SecondBits> &rhs
+) noexcept {
+    return !(lhs < rhs);
+}
+
+} // namespace gregjm
+
+#endif
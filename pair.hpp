@@ -2,22 +2,31 @@
 #define GREGJM_PAIR_HPP
 
 #include "pair_detail.hpp"
+#include "relocate.hpp"
+#include "uninitialized.hpp"
 
 #include <cstddef> // std::size_t
+#include <functional> // std::invoke
 #include <iostream> // std::basic_ostream
-#include <tuple> // std::tuple_size_v, std::get
+#include <tuple> // std::tuple_size_v, std::get, std::tuple_element
 #include <type_traits>
 #include <utility> // std::forward, std::pair, std::declval, std::swap
 
 namespace gregjm {
 
+// when First and Second are the same empty type, only one object is stored
+// and first() and second() return references to it, so &first() ==
+// &second(). otherwise the members have distinct addresses
 template <typename First, typename Second>
 class Pair
-: private detail::WrapIfNotInheritableT<First, 0>,
-  private detail::WrapIfNotInheritableT<Second, 1> {
+: private detail::MemberStorageT<First, 0>,
+  private detail::ElideIfSharedT<First, Second, 1> {
 private:
-    using FirstT = detail::WrapIfNotInheritableT<First, 0>;
-    using SecondT = detail::WrapIfNotInheritableT<Second, 1>;
+    static constexpr inline bool is_second_shared =
+        detail::is_shared_empty_v<First, Second>;
+
+    using FirstT = detail::MemberStorageT<First, 0>;
+    using SecondT = detail::ElideIfSharedT<First, Second, 1>;
 
 public:
     using first_type = First;
@@ -27,25 +36,70 @@ public:
     noexcept(std::is_nothrow_default_constructible_v<First>
              && std::is_nothrow_default_constructible_v<Second>) = default;
 
-    template <typename T, typename U,
+    // default-initializes both members; unlike Pair{ }, this leaves trivial
+    // members indeterminate
+    template <typename F = First, typename S = Second,
               typename = std::enable_if_t<
+                  std::is_default_constructible_v<F>
+                  && std::is_default_constructible_v<S>
+              >>
+    explicit Pair(uninitialized_t)
+    noexcept(std::is_nothrow_default_constructible_v<First>
+             && std::is_nothrow_default_constructible_v<Second>) { }
+
+    template <typename T, typename U,
+              std::enable_if_t<
                   std::is_constructible_v<First, const T&>
                   && std::is_constructible_v<Second, const U&>
-              >>
+                  && std::is_convertible_v<const T&, First>
+                  && std::is_convertible_v<const U&, Second>,
+                  int
+              > = 0>
+    constexpr Pair(const Pair<T, U> &other)
+    noexcept(std::is_nothrow_constructible_v<First, const T&>
+             && std::is_nothrow_constructible_v<Second, const U&>)
+    : FirstT(other.first()), SecondT(other.second()) { }
+
+    template <typename T, typename U,
+              std::enable_if_t<
+                  std::is_constructible_v<First, const T&>
+                  && std::is_constructible_v<Second, const U&>
+                  && !(std::is_convertible_v<const T&, First>
+                       && std::is_convertible_v<const U&, Second>),
+                  int
+              > = 0>
     explicit constexpr Pair(const Pair<T, U> &other)
     noexcept(std::is_nothrow_constructible_v<First, const T&>
              && std::is_nothrow_constructible_v<Second, const U&>)
     : FirstT(other.first()), SecondT(other.second()) { }
 
     template <typename T, typename U,
-              typename =
-                  std::enable_if_t<std::is_constructible_v<First, T&&>
-                                   && std::is_constructible_v<Second, U&&>>>
+              std::enable_if_t<
+                  std::is_constructible_v<First, T&&>
+                  && std::is_constructible_v<Second, U&&>
+                  && std::is_convertible_v<T&&, First>
+                  && std::is_convertible_v<U&&, Second>,
+                  int
+              > = 0>
+    constexpr Pair(Pair<T, U> &&other)
+    noexcept(std::is_nothrow_constructible_v<First, T&&>
+             && std::is_nothrow_constructible_v<Second, U&&>)
+    : FirstT(std::forward<T>(other.first())),
+      SecondT(std::forward<U>(other.second())) { }
+
+    template <typename T, typename U,
+              std::enable_if_t<
+                  std::is_constructible_v<First, T&&>
+                  && std::is_constructible_v<Second, U&&>
+                  && !(std::is_convertible_v<T&&, First>
+                       && std::is_convertible_v<U&&, Second>),
+                  int
+              > = 0>
     explicit constexpr Pair(Pair<T, U> &&other)
     noexcept(std::is_nothrow_constructible_v<First, T&&>
              && std::is_nothrow_constructible_v<Second, U&&>)
-    : FirstT(std::move(other.first())),
-      SecondT(std::move(other.second())) { }
+    : FirstT(std::forward<T>(other.first())),
+      SecondT(std::forward<U>(other.second())) { }
 
     template <typename F, typename S,
               typename = std::enable_if_t<
@@ -77,14 +131,17 @@ public:
 
     template <typename T, typename U,
               typename =
-                  std::enable_if_t<std::is_assignable_v<First, const T&>
-                                   && std::is_assignable_v<Second, const U&>>>
+                  std::enable_if_t<std::is_assignable_v<First&, const T&>
+                                   && std::is_assignable_v<Second&, const U&>>>
     constexpr Pair& operator=(const Pair<T, U> &other)
-    noexcept(std::is_nothrow_assignable_v<First, const T&>
-             && std::is_nothrow_assignable_v<Second, const U&>) {
-        if (this != &other) {
+    noexcept(std::is_nothrow_assignable_v<First&, const T&>
+             && std::is_nothrow_assignable_v<Second&, const U&>) {
+        if (static_cast<const void*>(this)
+            != static_cast<const void*>(&other)) {
             first() = other.first();
-            second() = other.second();
+            if constexpr (!is_second_shared) {
+                second() = other.second();
+            }
         }
 
         return *this;
@@ -92,43 +149,55 @@ public:
 
     template <typename T, typename U,
               typename =
-                  std::enable_if_t<std::is_assignable_v<First, T&&>
-                                   && std::is_assignable_v<Second, U&&>>>
+                  std::enable_if_t<std::is_assignable_v<First&, T&&>
+                                   && std::is_assignable_v<Second&, U&&>>>
     constexpr Pair& operator=(Pair<T, U> &&other)
-    noexcept(std::is_nothrow_assignable_v<First, T&&>
-             && std::is_nothrow_assignable_v<Second, U&&>) {
-        if (this != &other) {
-            first() = std::move(other.first());
-            second() = std::move(other.second());
+    noexcept(std::is_nothrow_assignable_v<First&, T&&>
+             && std::is_nothrow_assignable_v<Second&, U&&>) {
+        if (static_cast<const void*>(this)
+            != static_cast<const void*>(&other)) {
+            first() = std::forward<T>(other.first());
+            if constexpr (!is_second_shared) {
+                second() = std::forward<U>(other.second());
+            }
         }
 
         return *this;
     }
 
     constexpr inline First& first() noexcept {
-        return dynamic_cast<FirstT&>(*this).as_base();
+        return static_cast<FirstT&>(*this).as_base();
     }
 
     constexpr inline const First& first() const noexcept {
-        return dynamic_cast<const FirstT&>(*this).as_base();
+        return static_cast<const FirstT&>(*this).as_base();
     }
 
     constexpr inline Second& second() noexcept {
-        return dynamic_cast<SecondT&>(*this).as_base();
+        if constexpr (is_second_shared) {
+            return first();
+        } else {
+            return static_cast<SecondT&>(*this).as_base();
+        }
     }
 
     constexpr inline const Second& second() const noexcept {
-        return dynamic_cast<const SecondT&>(*this).as_base();
+        if constexpr (is_second_shared) {
+            return first();
+        } else {
+            return static_cast<const SecondT&>(*this).as_base();
+        }
     }
 
     constexpr void swap(Pair &other)
     noexcept(std::is_nothrow_swappable_v<First>
              && std::is_nothrow_swappable_v<Second>)
     {
-        using std::swap;
+        detail::swap_values(first(), other.first());
 
-        swap(first(), other.first());
-        swap(second(), other.second());
+        if constexpr (!is_second_shared) {
+            detail::swap_values(second(), other.second());
+        }
     }
 
     template <typename T, typename U,
@@ -140,10 +209,11 @@ public:
     noexcept(std::is_nothrow_swappable_with_v<First, T>
              && std::is_nothrow_swappable_with_v<Second, U>)
     {
-        using std::swap;
+        detail::swap_values(first(), other.first());
 
-        swap(first(), other.first());
-        swap(second(), other.second());
+        if constexpr (!is_second_shared) {
+            detail::swap_values(second(), other.second());
+        }
     }
 
 private:
@@ -176,8 +246,24 @@ operator<<(std::basic_ostream<CharT, Traits> &os,
     return os << '(' << pair.first() << ", " << pair.second() << ')';
 }
 
+template <typename First, typename Second>
+constexpr inline void swap(Pair<First, Second> &lhs, Pair<First, Second> &rhs)
+noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
 template <typename First1, typename Second1, typename First2, typename Second2>
-inline void swap(Pair<First1, Second1> &lhs, Pair<First2, Second2> &rhs)
+constexpr inline void swap(Pair<First1, Second1> &lhs,
+                           Pair<First2, Second2> &rhs)
+noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+// pairs of references are used as proxies by containers and views, which
+// hand them out as prvalues; swapping them swaps the referenced objects
+template <typename First, typename Second>
+constexpr inline void swap(Pair<First&, Second&> &&lhs,
+                           Pair<First&, Second&> &&rhs)
 noexcept(noexcept(lhs.swap(rhs))) {
     lhs.swap(rhs);
 }
@@ -212,14 +298,15 @@ template <typename First1, typename Second1, typename First2, typename Second2,
           >>
 constexpr inline bool operator<(
     const Pair<First1, Second1> &lhs, const Pair<First2, Second2> &rhs
-) noexcept(noexcept(lhs.first() == rhs.first()
-                    && lhs.second() < rhs.second()
-                    && lhs.first() < rhs.first())) {
-    if (lhs.first() == rhs.first()) {
-        return lhs.second() < rhs.second();
+) noexcept(detail::is_nothrow_three_way_comparable_v<First1, First2>
+           && noexcept(lhs.second() < rhs.second())) {
+    if (const int result = detail::compare_three_way(lhs.first(),
+                                                     rhs.first());
+        result != 0) {
+        return result < 0;
     }
 
-    return lhs.first() < rhs.first();
+    return lhs.second() < rhs.second();
 }
 
 template <typename First1, typename Second1, typename First2, typename Second2,
@@ -255,6 +342,48 @@ constexpr inline bool operator>=(
     return !(lhs < rhs);
 }
 
+// three-way comparison that visits each member at most once; returns a
+// negative number, zero or a positive number
+template <typename First1, typename Second1, typename First2, typename Second2,
+          typename = std::enable_if_t<
+              detail::is_less_than_comparable_v<First1, First2>
+              && detail::is_less_than_comparable_v<Second1, Second2>
+          >>
+constexpr inline int compare(
+    const Pair<First1, Second1> &lhs, const Pair<First2, Second2> &rhs
+) noexcept(detail::is_nothrow_three_way_comparable_v<First1, First2>
+           && detail::is_nothrow_three_way_comparable_v<Second1, Second2>) {
+    if (const int result = detail::compare_three_way(lhs.first(),
+                                                     rhs.first());
+        result != 0) {
+        return result;
+    }
+
+    return detail::compare_three_way(lhs.second(), rhs.second());
+}
+
+#if GREGJM_HAS_THREE_WAY_COMPARISON
+template <typename First1, typename Second1, typename First2, typename Second2,
+          typename = std::enable_if_t<
+              detail::is_less_than_comparable_v<First1, First2>
+              && detail::is_less_than_comparable_v<Second1, Second2>
+          >>
+constexpr std::common_comparison_category_t<
+    detail::SynthThreeWayResultT<First1, First2>,
+    detail::SynthThreeWayResultT<Second1, Second2>
+>
+operator<=>(const Pair<First1, Second1> &lhs,
+            const Pair<First2, Second2> &rhs) {
+    if (const auto result = detail::synth_three_way(lhs.first(),
+                                                    rhs.first());
+        result != 0) {
+        return result;
+    }
+
+    return detail::synth_three_way(lhs.second(), rhs.second());
+}
+#endif
+
 template <typename First, typename Second>
 constexpr gregjm::Pair<detail::UnwrapDecayT<First>,
                        detail::UnwrapDecayT<Second>>
@@ -266,6 +395,159 @@ make_pair(First &&first, Second &&second) {
     return PairT{ std::forward<First>(first), std::forward<Second>(second) };
 }
 
+// Pair is trivially copyable whenever its members are, and so trivially
+// relocatable through the primary template; this also covers members that
+// are only trivially relocatable by specialization
+template <typename First, typename Second>
+struct is_trivially_relocatable<Pair<First, Second>>
+: std::bool_constant<is_trivially_relocatable_v<First>
+                     && is_trivially_relocatable_v<Second>> { };
+
+namespace detail {
+
+// hash_words over the two member hashes. integral members are used as they
+// are, so a pair of integers is hashed as its packed 128-bit value;
+// swapping the members changes the hash, since each has its own seed
+template <typename First, typename Second>
+struct PairHash<First, Second, true> {
+    std::size_t operator()(const Pair<First, Second> &pair) const
+    noexcept(noexcept(hash_word(std::declval<const HashKeyT<First>&>()))
+             && noexcept(hash_word(std::declval<const HashKeyT<Second>&>())))
+    {
+        return static_cast<std::size_t>(hash_words(
+            hash_word<HashKeyT<First>>(pair.first()),
+            hash_word<HashKeyT<Second>>(pair.second())
+        ));
+    }
+};
+
+} // namespace detail
+
+} // namespace gregjm
+
+namespace std {
+
+template <typename First, typename Second>
+struct tuple_size<gregjm::Pair<First, Second>>
+: std::integral_constant<std::size_t, 2> { };
+
+template <typename First, typename Second>
+struct tuple_element<0, gregjm::Pair<First, Second>> {
+    using type = First;
+};
+
+template <typename First, typename Second>
+struct tuple_element<1, gregjm::Pair<First, Second>> {
+    using type = Second;
+};
+
+template <typename First, typename Second>
+struct hash<gregjm::Pair<First, Second>>
+: gregjm::detail::PairHash<First, Second> { };
+
+} // namespace std
+
+namespace gregjm {
+namespace detail {
+
+template <typename T>
+struct IsPair : std::false_type { };
+
+template <typename First, typename Second>
+struct IsPair<Pair<First, Second>> : std::true_type { };
+
+template <typename T>
+static constexpr inline bool is_pair_v =
+    IsPair<std::remove_cv_t<std::remove_reference_t<T>>>::value;
+
+template <typename T, typename First, typename Second>
+static constexpr inline bool is_unique_in_pair_v =
+    std::is_same_v<T, First> != std::is_same_v<T, Second>;
+
+} // namespace detail
+
+template <std::size_t I, typename First, typename Second>
+constexpr inline std::tuple_element_t<I, Pair<First, Second>>&
+get(Pair<First, Second> &pair) noexcept {
+    if constexpr (I == 0) {
+        return pair.first();
+    } else {
+        return pair.second();
+    }
+}
+
+template <std::size_t I, typename First, typename Second>
+constexpr inline const std::tuple_element_t<I, Pair<First, Second>>&
+get(const Pair<First, Second> &pair) noexcept {
+    if constexpr (I == 0) {
+        return pair.first();
+    } else {
+        return pair.second();
+    }
+}
+
+template <std::size_t I, typename First, typename Second>
+constexpr inline std::tuple_element_t<I, Pair<First, Second>>&&
+get(Pair<First, Second> &&pair) noexcept {
+    using ElementT = std::tuple_element_t<I, Pair<First, Second>>;
+
+    return std::forward<ElementT>(gregjm::get<I>(pair));
+}
+
+template <std::size_t I, typename First, typename Second>
+constexpr inline const std::tuple_element_t<I, Pair<First, Second>>&&
+get(const Pair<First, Second> &&pair) noexcept {
+    using ElementT = std::tuple_element_t<I, Pair<First, Second>>;
+
+    return std::forward<const ElementT>(gregjm::get<I>(pair));
+}
+
+template <typename T, typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_unique_in_pair_v<T, First, Second>
+          >>
+constexpr inline T& get(Pair<First, Second> &pair) noexcept {
+    return gregjm::get<std::is_same_v<T, First> ? 0 : 1>(pair);
+}
+
+template <typename T, typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_unique_in_pair_v<T, First, Second>
+          >>
+constexpr inline const T& get(const Pair<First, Second> &pair) noexcept {
+    return gregjm::get<std::is_same_v<T, First> ? 0 : 1>(pair);
+}
+
+template <typename T, typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_unique_in_pair_v<T, First, Second>
+          >>
+constexpr inline T&& get(Pair<First, Second> &&pair) noexcept {
+    return gregjm::get<std::is_same_v<T, First> ? 0 : 1>(std::move(pair));
+}
+
+template <typename T, typename First, typename Second,
+          typename = std::enable_if_t<
+              detail::is_unique_in_pair_v<T, First, Second>
+          >>
+constexpr inline const T&& get(const Pair<First, Second> &&pair) noexcept {
+    return gregjm::get<std::is_same_v<T, First> ? 0 : 1>(std::move(pair));
+}
+
+// std::apply calls std::get qualified, so it cannot see the overloads above;
+// this is the Pair equivalent
+template <typename F, typename P,
+          typename = std::enable_if_t<detail::is_pair_v<P>>>
+constexpr decltype(auto) apply(F &&f, P &&pair)
+noexcept(std::is_nothrow_invocable_v<
+    F, decltype(gregjm::get<0>(std::declval<P>())),
+    decltype(gregjm::get<1>(std::declval<P>()))
+>) {
+    return std::invoke(std::forward<F>(f),
+                       gregjm::get<0>(std::forward<P>(pair)),
+                       gregjm::get<1>(std::forward<P>(pair)));
+}
+
 } // namespace gregjm
 
 #endif
@@ -1,12 +1,88 @@
 #ifndef GREGJM_PAIR_DETAIL_HPP
 #define GREGJM_PAIR_DETAIL_HPP
 
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t, std::uintptr_t
+#include <functional> // std::hash
+#include <tuple> // std::get
 #include <type_traits>
-#include <utility> // std::forward
+#include <utility> // std::forward, std::index_sequence
+
+#if __cplusplus > 201703L && __has_include(<compare>)
+#include <compare>
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) \
+    && defined(__cpp_lib_three_way_comparison)
+#define GREGJM_HAS_THREE_WAY_COMPARISON 1
+#else
+#define GREGJM_HAS_THREE_WAY_COMPARISON 0
+#endif
+
+// selects how Pair and Tuple store their members. with 1, every member is a
+// [[no_unique_address]] data member, which also compresses final empty types
+// and keeps T's members out of name lookup; with 0, empty members are
+// compressed by private inheritance. defaults to 1 when the attribute is
+// available in C++20 mode; define it to override.
+//
+// the two backends give the same Pair different layouts, so every
+// translation unit of a program must agree on this macro. since the default
+// follows __cplusplus, linking C++17 and C++20 objects that pass a Pair
+// between them is an ODR violation unless it is defined the same way in
+// both, for example on the command line
+#ifndef GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS
+#if __cplusplus > 201703L && defined(__has_cpp_attribute)
+#if __has_cpp_attribute(no_unique_address)
+#define GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS 1
+#endif
+#endif
+#endif
+
+#ifndef GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS
+#define GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS 0
+#endif
 
 namespace gregjm {
+
+// where Pair and Tuple keep a member. Base inherits it privately, so an empty
+// type takes no space; Member stores it as a plain data member; and
+// CompressedMember stores it as a [[no_unique_address]] data member, which
+// also compresses final empty types but needs
+// GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS
+enum class StorageKind {
+    Member,
+    Base,
+    CompressedMember
+};
+
+// how Pair and Tuple store a member of type T. with the [[no_unique_address]]
+// backend every member is a CompressedMember; otherwise only empty non-final
+// classes are inherited. inheriting anything else would make a Pair
+// polymorphic along with T, or give it ambiguous bases when two members
+// share a base class. specialize it to force a storage kind for T
+template <typename T>
+struct storage_policy
+: std::integral_constant<
+    StorageKind,
+#if GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS
+    StorageKind::CompressedMember
+#else
+    std::is_empty_v<T> && !std::is_final_v<T> ? StorageKind::Base
+                                              : StorageKind::Member
+#endif
+> { };
+
+template <typename T>
+static constexpr inline StorageKind storage_policy_v = storage_policy<T>::value;
+
 namespace detail {
 
+struct FromTupleT {
+    explicit constexpr FromTupleT() noexcept = default;
+};
+
+static constexpr inline FromTupleT from_tuple{ };
+
 template <typename T, std::size_t I = 0>
 struct Wrapper {
     T data;
@@ -28,6 +104,16 @@ struct Wrapper {
     noexcept(std::is_nothrow_constructible_v<T, std::initializer_list<U>>)
     : data{ init } { }
 
+    template <typename Tuple, std::size_t ...Is,
+              typename = std::enable_if_t<std::is_constructible_v<
+                  T, std::tuple_element_t<Is, std::remove_reference_t<Tuple>>...
+              >>>
+    constexpr Wrapper(FromTupleT, Tuple &&args, std::index_sequence<Is...>)
+    noexcept(std::is_nothrow_constructible_v<
+        T, std::tuple_element_t<Is, std::remove_reference_t<Tuple>>...
+    >)
+    : data(std::get<Is>(std::forward<Tuple>(args))...) { }
+
     constexpr inline T& as_base() noexcept {
         return data;
     }
@@ -37,6 +123,48 @@ struct Wrapper {
     }
 };
 
+// reference members assign through to the referenced object, like
+// std::pair<T&, U&>; this is what lets Pair<T&, U&> act as a proxy reference
+template <typename T, std::size_t I>
+struct Wrapper<T&, I> {
+private:
+    struct NotAssignable;
+
+    using AssignFromT = std::conditional_t<std::is_assignable_v<T&, T&>,
+                                           const Wrapper&,
+                                           const NotAssignable&>;
+
+public:
+    T &data;
+
+    template <typename U,
+              typename = std::enable_if_t<std::is_constructible_v<T&, U>>>
+    constexpr explicit Wrapper(U &&ref)
+    noexcept(std::is_nothrow_constructible_v<T&, U>)
+    : data(std::forward<U>(ref)) { }
+
+    template <typename Tuple,
+              typename = std::enable_if_t<std::is_constructible_v<
+                  T&, std::tuple_element_t<0, std::remove_reference_t<Tuple>>
+              >>>
+    constexpr Wrapper(FromTupleT, Tuple &&args, std::index_sequence<0>)
+    noexcept
+    : data(std::get<0>(std::forward<Tuple>(args))) { }
+
+    constexpr Wrapper(const Wrapper &other) noexcept = default;
+
+    constexpr Wrapper& operator=(AssignFromT other)
+    noexcept(std::is_nothrow_assignable_v<T&, T&>) {
+        data = other.data;
+
+        return *this;
+    }
+
+    constexpr inline T& as_base() const noexcept {
+        return data;
+    }
+};
+
 template <typename T, std::size_t I = 0>
 struct Alias : private T {
     constexpr Alias()
@@ -56,15 +184,88 @@ struct Alias : private T {
     noexcept(std::is_nothrow_constructible_v<T, std::initializer_list<U>>)
     : T{ init } { }
 
+    template <typename Tuple, std::size_t ...Is,
+              typename = std::enable_if_t<std::is_constructible_v<
+                  T, std::tuple_element_t<Is, std::remove_reference_t<Tuple>>...
+              >>>
+    constexpr Alias(FromTupleT, Tuple &&args, std::index_sequence<Is...>)
+    noexcept(std::is_nothrow_constructible_v<
+        T, std::tuple_element_t<Is, std::remove_reference_t<Tuple>>...
+    >)
+    : T(std::get<Is>(std::forward<Tuple>(args))...) { }
+
     constexpr inline T& as_base() noexcept {
-        return dynamic_cast<T&>(*this);
+        return static_cast<T&>(*this);
     }
 
     constexpr inline const T& as_base() const noexcept {
-        return dynamic_cast<const T&>(*this);
+        return static_cast<const T&>(*this);
     }
 };
 
+// takes the place of a member that is the same empty type as an earlier
+// member, which it shares storage with. arguments are still used to
+// construct a T, which is then discarded, so that constructor side effects
+// and exceptions are preserved; an empty type has no state to keep
+template <typename T, std::size_t I = 0>
+struct Elided {
+    constexpr Elided() noexcept = default;
+
+    template <typename ...Args,
+              typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
+    constexpr explicit Elided(Args &&...args)
+    noexcept(std::is_nothrow_constructible_v<T, Args...>) {
+        static_cast<void>(T(std::forward<Args>(args)...));
+    }
+
+    template <typename U,
+              typename = std::enable_if_t<
+                  std::is_constructible_v<T, std::initializer_list<U>>
+              >>
+    constexpr explicit Elided(const std::initializer_list<U> init)
+    noexcept(std::is_nothrow_constructible_v<T, std::initializer_list<U>>) {
+        static_cast<void>(T{ init });
+    }
+
+    template <typename Tuple, std::size_t ...Is,
+              typename = std::enable_if_t<std::is_constructible_v<
+                  T, std::tuple_element_t<Is, std::remove_reference_t<Tuple>>...
+              >>>
+    constexpr Elided(FromTupleT, Tuple &&args, std::index_sequence<Is...>)
+    noexcept(std::is_nothrow_constructible_v<
+        T, std::tuple_element_t<Is, std::remove_reference_t<Tuple>>...
+    >) {
+        static_cast<void>(T(std::get<Is>(std::forward<Tuple>(args))...));
+    }
+};
+
+// std::swap is only constexpr from C++20, so trivially copyable values are
+// swapped here by copying, which is all that std::swap would do for them;
+// everything else is swapped through ADL as usual
+template <typename T, typename U>
+constexpr void swap_values(T &lhs, U &rhs)
+noexcept(std::is_nothrow_swappable_with_v<T&, U&>) {
+    if constexpr (std::is_same_v<T, U> && std::is_trivially_copyable_v<T>
+                  && std::is_copy_assignable_v<T>) {
+        T temp = lhs;
+        lhs = rhs;
+        rhs = temp;
+    } else {
+        using std::swap;
+
+        swap(lhs, rhs);
+    }
+}
+
+// two members of the same empty type would otherwise need distinct
+// addresses, costing a byte each plus padding
+template <typename T, typename U>
+struct IsSharedEmpty
+: std::bool_constant<std::is_same_v<T, U> && std::is_empty_v<T>> { };
+
+template <typename T, typename U>
+static constexpr inline bool is_shared_empty_v = IsSharedEmpty<T, U>::value;
+
 template <typename T>
 struct IsInheritable
 : std::conditional_t<std::is_class_v<T> && !std::is_final_v<T>,
@@ -111,14 +312,192 @@ template <typename T, typename U = T>
 static constexpr inline bool is_less_than_comparable_v =
     IsLessThanComparable<T, U>::value;
 
+template <typename T>
+static constexpr inline bool is_compare_result_v =
+    std::is_integral_v<T> && std::is_signed_v<T> && !std::is_same_v<T, bool>;
+
+// only a compare() that returns a signed integer, like
+// std::string::compare, is taken for a three-way comparison; a bool
+// compare() is more likely an equality test
+template <typename T, typename U, typename = void>
+struct HasCompareMember : std::false_type { };
+
+template <typename T, typename U>
+struct HasCompareMember<
+    T, U, std::enable_if_t<is_compare_result_v<std::remove_cv_t<
+        decltype(std::declval<const T&>().compare(std::declval<const U&>()))
+    >>>
+> : std::true_type { };
+
+template <typename T, typename U>
+static constexpr inline bool has_compare_member_v =
+    HasCompareMember<T, U>::value;
+
+template <typename T, typename U, typename = void>
+struct HasThreeWayComparison : std::false_type { };
+
+#if GREGJM_HAS_THREE_WAY_COMPARISON
+template <typename T, typename U>
+struct HasThreeWayComparison<
+    T, U, std::void_t<decltype(std::declval<const T&>()
+                               <=> std::declval<const U&>())>
+> : std::true_type { };
+#endif
+
+template <typename T, typename U>
+static constexpr inline bool has_three_way_comparison_v =
+    HasThreeWayComparison<T, U>::value;
+
+template <typename T, typename U>
+constexpr bool is_nothrow_compare() noexcept {
+    if constexpr (has_compare_member_v<T, U>) {
+        return noexcept(
+            std::declval<const T&>().compare(std::declval<const U&>())
+        );
+#if GREGJM_HAS_THREE_WAY_COMPARISON
+    } else if constexpr (has_three_way_comparison_v<T, U>) {
+        return noexcept(std::declval<const T&>() <=> std::declval<const U&>());
+#endif
+    } else {
+        return noexcept(std::declval<const T&>() < std::declval<const U&>()
+                        && std::declval<const U&>() < std::declval<const T&>());
+    }
+}
+
+template <typename T, typename U>
+static constexpr inline bool is_nothrow_three_way_comparable_v =
+    is_nothrow_compare<T, U>();
+
+// returns a negative number, zero or a positive number, visiting lhs and rhs
+// once when T::compare or <=> is available
+template <typename T, typename U>
+constexpr int compare_three_way(const T &lhs, const U &rhs)
+noexcept(is_nothrow_three_way_comparable_v<T, U>) {
+    if constexpr (has_compare_member_v<T, U>) {
+        // kept in its own type, since a wider result need not fit in an int
+        const auto result = lhs.compare(rhs);
+
+        return (result > 0) - (result < 0);
+#if GREGJM_HAS_THREE_WAY_COMPARISON
+    } else if constexpr (has_three_way_comparison_v<T, U>) {
+        const auto result = lhs <=> rhs;
+
+        return (result > 0) - (result < 0);
+#endif
+    } else {
+        if (lhs < rhs) {
+            return -1;
+        } else if (rhs < lhs) {
+            return 1;
+        }
+
+        return 0;
+    }
+}
+
+#if GREGJM_HAS_THREE_WAY_COMPARISON
+template <typename T, typename U>
+constexpr auto synth_three_way(const T &lhs, const U &rhs) {
+    if constexpr (has_three_way_comparison_v<T, U>) {
+        return lhs <=> rhs;
+    } else {
+        if (lhs < rhs) {
+            return std::weak_ordering::less;
+        } else if (rhs < lhs) {
+            return std::weak_ordering::greater;
+        }
+
+        return std::weak_ordering::equivalent;
+    }
+}
+
+template <typename T, typename U>
+using SynthThreeWayResultT =
+    decltype(synth_three_way(std::declval<const T&>(),
+                             std::declval<const U&>()));
+#endif
+
+#if GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS
 template <typename T, std::size_t I = 0>
-struct WrapIfNotInheritable {
-    using TypeT = std::conditional_t<is_inheritable_v<T>, Alias<T, I>,
-                                     Wrapper<T, I>>;
+struct Member {
+    [[no_unique_address]] T data;
+
+    constexpr Member()
+    noexcept(std::is_nothrow_default_constructible_v<T>) = default;
+
+    template <typename ...Args,
+              typename = std::enable_if_t<std::is_constructible_v<T, Args...>>>
+    constexpr explicit Member(Args &&...args)
+    noexcept(std::is_nothrow_constructible_v<T, Args...>)
+    : data(std::forward<Args>(args)...) { }
+
+    template <typename U,
+              typename = std::enable_if_t<
+                  std::is_constructible_v<T, std::initializer_list<U>>
+              >>
+    constexpr explicit Member(const std::initializer_list<U> init)
+    noexcept(std::is_nothrow_constructible_v<T, std::initializer_list<U>>)
+    : data{ init } { }
+
+    template <typename Tuple, std::size_t ...Is,
+              typename = std::enable_if_t<std::is_constructible_v<
+                  T, std::tuple_element_t<Is, std::remove_reference_t<Tuple>>...
+              >>>
+    constexpr Member(FromTupleT, Tuple &&args, std::index_sequence<Is...>)
+    noexcept(std::is_nothrow_constructible_v<
+        T, std::tuple_element_t<Is, std::remove_reference_t<Tuple>>...
+    >)
+    : data(std::get<Is>(std::forward<Tuple>(args))...) { }
+
+    constexpr inline T& as_base() noexcept {
+        return data;
+    }
+
+    constexpr inline const T& as_base() const noexcept {
+        return data;
+    }
+};
+
+#endif
+
+// the storage for a member of type T, as chosen by storage_policy.
+// references are always Wrappers, for their assign-through semantics
+template <typename T, std::size_t I = 0,
+          StorageKind Kind = std::is_reference_v<T> ? StorageKind::Member
+                                                    : storage_policy_v<T>>
+struct MemberStorage {
+    using TypeT = Wrapper<T, I>;
+};
+
+template <typename T, std::size_t I>
+struct MemberStorage<T, I, StorageKind::Base> {
+    static_assert(is_inheritable_v<T>,
+                  "StorageKind::Base needs a non-final class type");
+
+    using TypeT = Alias<T, I>;
+};
+
+// Member<T, I> is empty whenever T is, so Pair still gets the empty base
+// optimization from inheriting it, final or not
+template <typename T, std::size_t I>
+struct MemberStorage<T, I, StorageKind::CompressedMember> {
+#if GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS
+    using TypeT = Member<T, I>;
+#else
+    static_assert(!std::is_same_v<T, T>,
+                  "StorageKind::CompressedMember needs "
+                  "GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS");
+#endif
 };
 
 template <typename T, std::size_t I = 0>
-using WrapIfNotInheritableT = typename WrapIfNotInheritable<T, I>::TypeT;
+using MemberStorageT = typename MemberStorage<T, I>::TypeT;
+
+// storage for a member of type U that follows a member of type T
+template <typename T, typename U, std::size_t I>
+using ElideIfSharedT = std::conditional_t<is_shared_empty_v<T, U>,
+                                          Elided<U, I>,
+                                          MemberStorageT<U, I>>;
 
 template <typename T>
 struct Unwrap {
@@ -141,6 +520,121 @@ struct UnwrapDecay {
 template <typename T>
 using UnwrapDecayT = typename UnwrapDecay<T>::TypeT;
 
+// operator-> for iterators whose reference type is a proxy, like
+// Pair<T&, U&>
+template <typename Reference>
+class ArrowProxy {
+public:
+    constexpr explicit ArrowProxy(Reference ref) noexcept : ref_{ ref } { }
+
+    constexpr Reference* operator->() noexcept {
+        return &ref_;
+    }
+
+private:
+    Reference ref_;
+};
+
+// the first three secrets of wyhash. see hash_words for how a pair uses them
+static constexpr inline std::uint64_t hash_seed_first = 0xa0761d6478bd642f;
+static constexpr inline std::uint64_t hash_seed_second = 0xe7037ed1a0b428db;
+static constexpr inline std::uint64_t hash_seed_third = 0x8ebc6af09c88c6e3;
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 HashProduct;
+#endif
+
+// xor of the high and low halves of the full product of lhs and rhs
+constexpr std::uint64_t multiply_fold(std::uint64_t lhs,
+                                      std::uint64_t rhs) noexcept {
+#ifdef __SIZEOF_INT128__
+    const HashProduct product = static_cast<HashProduct>(lhs) * rhs;
+
+    return static_cast<std::uint64_t>(product)
+           ^ static_cast<std::uint64_t>(product >> 64);
+#else
+    const std::uint64_t lhs_low = lhs & 0xffffffff;
+    const std::uint64_t lhs_high = lhs >> 32;
+    const std::uint64_t rhs_low = rhs & 0xffffffff;
+    const std::uint64_t rhs_high = rhs >> 32;
+
+    const std::uint64_t low_low = lhs_low * rhs_low;
+    const std::uint64_t middle = lhs_high * rhs_low + (low_low >> 32);
+    const std::uint64_t other_middle = lhs_low * rhs_high
+                                       + (middle & 0xffffffff);
+
+    const std::uint64_t high = lhs_high * rhs_high + (middle >> 32)
+                               + (other_middle >> 32);
+    const std::uint64_t low = (other_middle << 32) | (low_low & 0xffffffff);
+
+    return low ^ high;
+#endif
+}
+
+// each word is xored with its own seed and the 128-bit product of the two is
+// folded. both factors are xored back in, as wyhash does in its "condom"
+// mode, so that a member equal to its seed, which zeroes the product, cannot
+// erase the other member. a last fold by the third seed mixes every input
+// bit into the whole result
+constexpr std::uint64_t hash_words(std::uint64_t first,
+                                   std::uint64_t second) noexcept {
+    const std::uint64_t lhs = first ^ hash_seed_first;
+    const std::uint64_t rhs = second ^ hash_seed_second;
+
+    return multiply_fold(multiply_fold(lhs, rhs) ^ lhs ^ rhs,
+                         hash_seed_third);
+}
+
+template <typename T, typename = void>
+struct IsHashable : std::false_type { };
+
+template <typename T>
+struct IsHashable<
+    T, std::void_t<decltype(std::hash<T>{ }(std::declval<const T&>()))>
+> : std::true_type { };
+
+template <typename T>
+static constexpr inline bool is_hashable_v = IsHashable<T>::value;
+
+// integers, enums and pointers of up to 64 bits are hashed as their own
+// value; the fold does all of the mixing
+template <typename T>
+static constexpr inline bool is_hash_word_v =
+    (std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>)
+    && sizeof(T) <= sizeof(std::uint64_t);
+
+template <typename T>
+std::uint64_t hash_word(const T &value)
+noexcept(is_hash_word_v<T> || noexcept(std::hash<T>{ }(value))) {
+    if constexpr (std::is_pointer_v<T>) {
+        return static_cast<std::uint64_t>(
+            reinterpret_cast<std::uintptr_t>(value)
+        );
+    } else if constexpr (std::is_enum_v<T>) {
+        return static_cast<std::uint64_t>(
+            static_cast<std::underlying_type_t<T>>(value)
+        );
+    } else if constexpr (std::is_integral_v<T>) {
+        return static_cast<std::uint64_t>(value);
+    } else {
+        return static_cast<std::uint64_t>(std::hash<T>{ }(value));
+    }
+}
+
+template <typename T>
+using HashKeyT = std::remove_cv_t<std::remove_reference_t<T>>;
+
+// std::hash for a pair whose members are not both hashable is disabled, as
+// the standard requires: it cannot be constructed or called
+template <typename First, typename Second,
+          bool = is_hashable_v<HashKeyT<First>>
+                 && is_hashable_v<HashKeyT<Second>>>
+struct PairHash {
+    PairHash() = delete;
+    PairHash(const PairHash&) = delete;
+    PairHash& operator=(const PairHash&) = delete;
+};
+
 } // namespace detail
 } // namespace gregjm
 
@@ -0,0 +1,436 @@
+#ifndef GREGJM_PAIR_VECTOR_HPP
+#define GREGJM_PAIR_VECTOR_HPP
+
+#include "pair.hpp"
+#include "span.hpp"
+
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <initializer_list>
+#include <iterator> // std::random_access_iterator_tag
+#include <type_traits>
+#include <utility> // std::forward, std::move
+#include <vector>
+
+namespace gregjm {
+namespace detail {
+
+// iterates over two parallel arrays at once; when Second is empty every
+// element shares one Second object, so the second pointer never moves
+template <typename First, typename Second>
+class PairVectorIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Pair<std::remove_const_t<First>,
+                            std::remove_const_t<Second>>;
+    using difference_type = std::ptrdiff_t;
+    using reference = Pair<First&, Second&>;
+    using pointer = ArrowProxy<reference>;
+
+    constexpr PairVectorIterator() noexcept = default;
+
+    constexpr PairVectorIterator(First *first, Second *second) noexcept
+    : first_{ first }, second_{ second } { }
+
+    template <typename F, typename S,
+              typename = std::enable_if_t<std::is_convertible_v<F*, First*>
+                                          && std::is_convertible_v<S*,
+                                                                   Second*>>>
+    constexpr PairVectorIterator(const PairVectorIterator<F, S> &other)
+    noexcept
+    : first_{ other.first_ }, second_{ other.second_ } { }
+
+    constexpr reference operator*() const noexcept {
+        return reference{ *first_, *second_ };
+    }
+
+    constexpr pointer operator->() const noexcept {
+        return pointer{ **this };
+    }
+
+    constexpr reference operator[](difference_type offset) const noexcept {
+        return *(*this + offset);
+    }
+
+    constexpr PairVectorIterator& operator+=(difference_type offset)
+    noexcept {
+        first_ += offset;
+
+        if constexpr (!std::is_empty_v<Second>) {
+            second_ += offset;
+        }
+
+        return *this;
+    }
+
+    constexpr PairVectorIterator& operator-=(difference_type offset)
+    noexcept {
+        return *this += -offset;
+    }
+
+    constexpr PairVectorIterator& operator++() noexcept {
+        return *this += 1;
+    }
+
+    constexpr PairVectorIterator operator++(int) noexcept {
+        const PairVectorIterator previous = *this;
+        ++*this;
+
+        return previous;
+    }
+
+    constexpr PairVectorIterator& operator--() noexcept {
+        return *this -= 1;
+    }
+
+    constexpr PairVectorIterator operator--(int) noexcept {
+        const PairVectorIterator previous = *this;
+        --*this;
+
+        return previous;
+    }
+
+    friend constexpr PairVectorIterator operator+(PairVectorIterator iter,
+                                                  difference_type offset)
+    noexcept {
+        return iter += offset;
+    }
+
+    friend constexpr PairVectorIterator operator+(difference_type offset,
+                                                  PairVectorIterator iter)
+    noexcept {
+        return iter += offset;
+    }
+
+    friend constexpr PairVectorIterator operator-(PairVectorIterator iter,
+                                                  difference_type offset)
+    noexcept {
+        return iter -= offset;
+    }
+
+    friend constexpr difference_type operator-(const PairVectorIterator &lhs,
+                                               const PairVectorIterator &rhs)
+    noexcept {
+        return lhs.first_ - rhs.first_;
+    }
+
+    friend constexpr bool operator==(const PairVectorIterator &lhs,
+                                     const PairVectorIterator &rhs) noexcept {
+        return lhs.first_ == rhs.first_;
+    }
+
+    friend constexpr bool operator!=(const PairVectorIterator &lhs,
+                                     const PairVectorIterator &rhs) noexcept {
+        return lhs.first_ != rhs.first_;
+    }
+
+    friend constexpr bool operator<(const PairVectorIterator &lhs,
+                                    const PairVectorIterator &rhs) noexcept {
+        return lhs.first_ < rhs.first_;
+    }
+
+    friend constexpr bool operator<=(const PairVectorIterator &lhs,
+                                     const PairVectorIterator &rhs) noexcept {
+        return lhs.first_ <= rhs.first_;
+    }
+
+    friend constexpr bool operator>(const PairVectorIterator &lhs,
+                                    const PairVectorIterator &rhs) noexcept {
+        return lhs.first_ > rhs.first_;
+    }
+
+    friend constexpr bool operator>=(const PairVectorIterator &lhs,
+                                     const PairVectorIterator &rhs) noexcept {
+        return lhs.first_ >= rhs.first_;
+    }
+
+private:
+    template <typename F, typename S>
+    friend class PairVectorIterator;
+
+    First *first_ = nullptr;
+    Second *second_ = nullptr;
+};
+
+} // namespace detail
+
+// structure-of-arrays counterpart to std::vector<Pair<First, Second>>: firsts
+// and seconds live in separate contiguous buffers, and elements are accessed
+// through Pair<First&, Second&> proxies. an empty Second is stored once for
+// the whole container instead of once per element
+template <typename First, typename Second>
+class PairVector {
+private:
+    static_assert(!std::is_same_v<First, bool>
+                  && !std::is_same_v<Second, bool>,
+                  "PairVector needs contiguous storage, which "
+                  "std::vector<bool> does not provide");
+
+    static constexpr inline bool is_second_shared = std::is_empty_v<Second>;
+
+    using SecondStorageT = std::conditional_t<is_second_shared, Second,
+                                              std::vector<Second>>;
+
+public:
+    using value_type = Pair<First, Second>;
+    using reference = Pair<First&, Second&>;
+    using const_reference = Pair<const First&, const Second&>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = detail::PairVectorIterator<First, Second>;
+    using const_iterator = detail::PairVectorIterator<const First,
+                                                      const Second>;
+
+    PairVector() = default;
+
+    explicit PairVector(size_type count) {
+        resize(count);
+    }
+
+    PairVector(size_type count, const First &first, const Second &second) {
+        resize(count, first, second);
+    }
+
+    PairVector(std::initializer_list<value_type> init) {
+        reserve(init.size());
+
+        for (const value_type &elem : init) {
+            push_back(elem);
+        }
+    }
+
+    reference operator[](size_type index) noexcept {
+        return *(begin() + static_cast<difference_type>(index));
+    }
+
+    const_reference operator[](size_type index) const noexcept {
+        return *(begin() + static_cast<difference_type>(index));
+    }
+
+    reference front() noexcept {
+        return *begin();
+    }
+
+    const_reference front() const noexcept {
+        return *begin();
+    }
+
+    reference back() noexcept {
+        return *(end() - 1);
+    }
+
+    const_reference back() const noexcept {
+        return *(end() - 1);
+    }
+
+    iterator begin() noexcept {
+        return iterator{ firsts_vec().data(), seconds_data() };
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator{ firsts_vec().data(), seconds_data() };
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    iterator end() noexcept {
+        return begin() + static_cast<difference_type>(size());
+    }
+
+    const_iterator end() const noexcept {
+        return begin() + static_cast<difference_type>(size());
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    Span<First> firsts() noexcept {
+        return Span<First>{ firsts_vec() };
+    }
+
+    Span<const First> firsts() const noexcept {
+        return Span<const First>{ firsts_vec() };
+    }
+
+    // not available when Second is empty, since there is only one of it
+    template <typename S = Second,
+              typename = std::enable_if_t<!std::is_empty_v<S>>>
+    Span<S> seconds() noexcept {
+        return Span<S>{ data_.second() };
+    }
+
+    template <typename S = Second,
+              typename = std::enable_if_t<!std::is_empty_v<S>>>
+    Span<const S> seconds() const noexcept {
+        return Span<const S>{ data_.second() };
+    }
+
+    bool empty() const noexcept {
+        return firsts_vec().empty();
+    }
+
+    size_type size() const noexcept {
+        return firsts_vec().size();
+    }
+
+    size_type capacity() const noexcept {
+        return firsts_vec().capacity();
+    }
+
+    void reserve(size_type count) {
+        firsts_vec().reserve(count);
+
+        if constexpr (!is_second_shared) {
+            data_.second().reserve(count);
+        }
+    }
+
+    void shrink_to_fit() {
+        firsts_vec().shrink_to_fit();
+
+        if constexpr (!is_second_shared) {
+            data_.second().shrink_to_fit();
+        }
+    }
+
+    void clear() noexcept {
+        firsts_vec().clear();
+
+        if constexpr (!is_second_shared) {
+            data_.second().clear();
+        }
+    }
+
+    void resize(size_type count) {
+        firsts_vec().resize(count);
+
+        if constexpr (!is_second_shared) {
+            resize_seconds(count);
+        }
+    }
+
+    void resize(size_type count, const First &first, const Second &second) {
+        firsts_vec().resize(count, first);
+
+        if constexpr (!is_second_shared) {
+            resize_seconds(count, second);
+        } else {
+            static_cast<void>(second);
+        }
+    }
+
+    void push_back(const value_type &pair) {
+        emplace_back(pair.first(), pair.second());
+    }
+
+    void push_back(value_type &&pair) {
+        emplace_back(std::move(pair.first()), std::move(pair.second()));
+    }
+
+    template <typename F, typename S,
+              typename = std::enable_if_t<
+                  std::is_constructible_v<First, F>
+                  && std::is_constructible_v<Second, S>
+              >>
+    reference emplace_back(F &&first, S &&second) {
+        firsts_vec().emplace_back(std::forward<F>(first));
+
+        if constexpr (!is_second_shared) {
+            try {
+                data_.second().emplace_back(std::forward<S>(second));
+            } catch (...) {
+                firsts_vec().pop_back();
+
+                throw;
+            }
+        } else {
+            static_cast<void>(second);
+        }
+
+        return back();
+    }
+
+    void pop_back() noexcept {
+        firsts_vec().pop_back();
+
+        if constexpr (!is_second_shared) {
+            data_.second().pop_back();
+        }
+    }
+
+    void swap(PairVector &other) noexcept {
+        using std::swap;
+
+        swap(firsts_vec(), other.firsts_vec());
+
+        if constexpr (!is_second_shared) {
+            swap(data_.second(), other.data_.second());
+        }
+    }
+
+    friend bool operator==(const PairVector &lhs, const PairVector &rhs) {
+        if constexpr (is_second_shared) {
+            return lhs.firsts_vec() == rhs.firsts_vec();
+        } else {
+            return lhs.firsts_vec() == rhs.firsts_vec()
+                   && lhs.data_.second() == rhs.data_.second();
+        }
+    }
+
+    friend bool operator!=(const PairVector &lhs, const PairVector &rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    std::vector<First>& firsts_vec() noexcept {
+        return data_.first();
+    }
+
+    const std::vector<First>& firsts_vec() const noexcept {
+        return data_.first();
+    }
+
+    Second* seconds_data() noexcept {
+        if constexpr (is_second_shared) {
+            return &data_.second();
+        } else {
+            return data_.second().data();
+        }
+    }
+
+    const Second* seconds_data() const noexcept {
+        if constexpr (is_second_shared) {
+            return &data_.second();
+        } else {
+            return data_.second().data();
+        }
+    }
+
+    template <typename ...Args>
+    void resize_seconds(size_type count, const Args &...args) {
+        try {
+            data_.second().resize(count, args...);
+        } catch (...) {
+            // erase, since resize needs a default-constructible First
+            const auto kept =
+                static_cast<difference_type>(data_.second().size());
+            firsts_vec().erase(firsts_vec().begin() + kept, firsts_vec().end());
+
+            throw;
+        }
+    }
+
+    Pair<std::vector<First>, SecondStorageT> data_;
+};
+
+template <typename First, typename Second>
+inline void swap(PairVector<First, Second> &lhs,
+                 PairVector<First, Second> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef GREGJM_PARALLEL_SORT_HPP
+#define GREGJM_PARALLEL_SORT_HPP
+
+#include "thread_pool.hpp"
+
+#include <algorithm> // std::stable_sort, std::merge, std::lower_bound, ...
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <functional> // std::less
+#include <iterator> // std::iterator_traits, std::make_move_iterator
+#include <type_traits>
+#include <utility> // std::move
+#include <vector>
+
+namespace gregjm {
+namespace detail {
+
+// below this many elements, splitting costs more than it saves
+static constexpr inline std::ptrdiff_t parallel_sort_min_grain = 1 << 12;
+static constexpr inline std::ptrdiff_t parallel_merge_min_grain = 1 << 13;
+
+// the number of elements each task works on. about four pieces per thread
+// lets idle threads steal the tail of a slow one
+inline std::ptrdiff_t parallel_grain(std::ptrdiff_t size,
+                                     std::size_t num_threads,
+                                     std::ptrdiff_t min_grain) noexcept {
+    return std::max(size / static_cast<std::ptrdiff_t>(4 * num_threads),
+                    min_grain);
+}
+
+template <typename InputIt1, typename InputIt2, typename OutputIt,
+          typename Compare>
+void parallel_merge_into(TaskGroup &group, InputIt1 first1, InputIt1 last1,
+                         InputIt2 first2, InputIt2 last2, OutputIt out,
+                         Compare &comp, std::ptrdiff_t grain) {
+    const auto size1 = last1 - first1;
+    const auto size2 = last2 - first2;
+
+    if (size1 + size2 <= grain) {
+        std::merge(first1, last1, first2, last2, out, comp);
+
+        return;
+    }
+
+    // split the longer range at its middle and the other where that element
+    // would go, keeping elements of the first range ahead of equal ones in
+    // the second
+    InputIt1 middle1;
+    InputIt2 middle2;
+
+    if (size1 >= size2) {
+        middle1 = first1 + size1 / 2;
+        middle2 = std::lower_bound(first2, last2, *middle1, comp);
+    } else {
+        middle2 = first2 + size2 / 2;
+        middle1 = std::upper_bound(first1, last1, *middle2, comp);
+    }
+
+    const OutputIt middle_out = out + ((middle1 - first1)
+                                       + (middle2 - first2));
+
+    group.run([&group, first1, middle1, first2, middle2, out, &comp,
+               grain] {
+        parallel_merge_into(group, first1, middle1, first2, middle2, out,
+                            comp, grain);
+    });
+
+    parallel_merge_into(group, middle1, last1, middle2, last2, middle_out,
+                        comp, grain);
+}
+
+// sorts [first, last), leaving the result in [first, last) or, if
+// into_scratch, in the matching part of the scratch range. each half is
+// sorted into the other range and then merged back
+template <typename RandomIt, typename ScratchIt, typename Compare>
+void parallel_sort_into(ThreadPool &pool, RandomIt first, RandomIt last,
+                        ScratchIt scratch, bool into_scratch, Compare &comp,
+                        std::ptrdiff_t sort_grain,
+                        std::ptrdiff_t merge_grain) {
+    const auto size = last - first;
+
+    if (size <= sort_grain) {
+        std::stable_sort(first, last, comp);
+
+        if (into_scratch) {
+            std::move(first, last, scratch);
+        }
+
+        return;
+    }
+
+    const RandomIt middle = first + size / 2;
+    const ScratchIt scratch_middle = scratch + size / 2;
+    const ScratchIt scratch_last = scratch + size;
+
+    {
+        TaskGroup group{ pool };
+
+        group.run([&pool, first, middle, scratch, into_scratch, &comp,
+                   sort_grain, merge_grain] {
+            parallel_sort_into(pool, first, middle, scratch, !into_scratch,
+                               comp, sort_grain, merge_grain);
+        });
+
+        parallel_sort_into(pool, middle, last, scratch_middle, !into_scratch,
+                           comp, sort_grain, merge_grain);
+        group.wait();
+    }
+
+    TaskGroup group{ pool };
+
+    if (into_scratch) {
+        parallel_merge_into(group, std::make_move_iterator(first),
+                            std::make_move_iterator(middle),
+                            std::make_move_iterator(middle),
+                            std::make_move_iterator(last), scratch, comp,
+                            merge_grain);
+    } else {
+        parallel_merge_into(group, std::make_move_iterator(scratch),
+                            std::make_move_iterator(scratch_middle),
+                            std::make_move_iterator(scratch_middle),
+                            std::make_move_iterator(scratch_last), first,
+                            comp, merge_grain);
+    }
+
+    group.wait();
+}
+
+} // namespace detail
+
+// stably merges the sorted ranges [first1, last1) and [first2, last2) into
+// out, like std::merge, splitting the work across the pool. all iterators
+// must be random access and the output must not overlap either input
+template <typename RandomIt1, typename RandomIt2, typename OutputIt,
+          typename Compare = std::less<>>
+OutputIt parallel_merge(ThreadPool &pool, RandomIt1 first1, RandomIt1 last1,
+                        RandomIt2 first2, RandomIt2 last2, OutputIt out,
+                        Compare comp = Compare{ }) {
+    const auto size = (last1 - first1) + (last2 - first2);
+
+    TaskGroup group{ pool };
+    detail::parallel_merge_into(
+        group, first1, last1, first2, last2, out, comp,
+        detail::parallel_grain(size, pool.num_threads(),
+                               detail::parallel_merge_min_grain)
+    );
+    group.wait();
+
+    return out + size;
+}
+
+template <typename RandomIt1, typename RandomIt2, typename OutputIt,
+          typename Compare = std::less<>>
+OutputIt parallel_merge(parallel_t policy, RandomIt1 first1, RandomIt1 last1,
+                        RandomIt2 first2, RandomIt2 last2, OutputIt out,
+                        Compare comp = Compare{ }) {
+    ThreadPool pool{ policy.num_threads };
+
+    return parallel_merge(pool, first1, last1, first2, last2, out,
+                          std::move(comp));
+}
+
+// stably sorts [first, last) with comp, which defaults to operator<. the
+// result does not depend on the number of threads. uses a buffer of moved
+// elements as large as the range, so the value type must be move
+// constructible and move assignable
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(ThreadPool &pool, RandomIt first, RandomIt last,
+                   Compare comp = Compare{ }) {
+    using ValueT = typename std::iterator_traits<RandomIt>::value_type;
+
+    const auto size = last - first;
+
+    if (size <= detail::parallel_sort_min_grain) {
+        std::stable_sort(first, last, comp);
+
+        return;
+    }
+
+    // the elements are sorted where they are moved to, with the original
+    // range as scratch, and end up back in it
+    std::vector<ValueT> buffer(std::make_move_iterator(first),
+                               std::make_move_iterator(last));
+
+    detail::parallel_sort_into(
+        pool, buffer.begin(), buffer.end(), first, true, comp,
+        detail::parallel_grain(size, pool.num_threads(),
+                               detail::parallel_sort_min_grain),
+        detail::parallel_grain(size, pool.num_threads(),
+                               detail::parallel_merge_min_grain)
+    );
+}
+
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(parallel_t policy, RandomIt first, RandomIt last,
+                   Compare comp = Compare{ }) {
+    ThreadPool pool{ policy.num_threads };
+
+    parallel_sort(pool, first, last, std::move(comp));
+}
+
+} // namespace gregjm
+
+#endif
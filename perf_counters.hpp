@@ -0,0 +1,177 @@
+#ifndef GREGJM_PERF_COUNTERS_HPP
+#define GREGJM_PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h> // perf_event_attr, PERF_*
+#include <sys/ioctl.h> // ioctl
+#include <sys/syscall.h> // SYS_perf_event_open
+#include <unistd.h> // syscall, read, close
+
+#define GREGJM_BENCH_HAS_PERF_EVENTS 1
+#else
+#define GREGJM_BENCH_HAS_PERF_EVENTS 0
+#endif
+
+namespace gregjm {
+namespace bench {
+
+static constexpr inline std::size_t num_counters = 5;
+
+static constexpr inline std::array<const char*, num_counters> counter_names = {
+    "cycles", "instrs", "L1d-miss", "LLC-miss", "br-miss"
+};
+
+using CounterValues = std::array<double, num_counters>;
+
+// hardware counters for the calling thread and every thread it starts after
+// the counters are opened, read through perf_event_open. threads that exit
+// fold their counts into the opening thread's, which a reset does not clear,
+// so read() reports the difference from the values seen by start(). each
+// counter is opened on its own, so a host that lacks one event (common
+// for cache events in VMs) still reports the others; when no counter can be
+// opened at all (containers, non-Linux hosts) available() is false
+class PerfCounters {
+public:
+    PerfCounters() noexcept {
+        fds_.fill(-1);
+
+#if GREGJM_BENCH_HAS_PERF_EVENTS
+        constexpr std::uint64_t l1d_read_miss =
+            PERF_COUNT_HW_CACHE_L1D
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        fds_[0] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fds_[1] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds_[2] = open(PERF_TYPE_HW_CACHE, l1d_read_miss);
+        fds_[3] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        fds_[4] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+    PerfCounters(const PerfCounters &other) = delete;
+
+    PerfCounters& operator=(const PerfCounters &other) = delete;
+
+    ~PerfCounters() {
+#if GREGJM_BENCH_HAS_PERF_EVENTS
+        for (const int fd : fds_) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+#endif
+    }
+
+    bool available() const noexcept {
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            if (is_open(i)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool is_open(std::size_t index) const noexcept {
+        return fds_[index] >= 0;
+    }
+
+    void start() noexcept {
+#if GREGJM_BENCH_HAS_PERF_EVENTS
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            if (fds_[i] >= 0) {
+                if (!read_raw(fds_[i], baselines_[i])) {
+                    baselines_[i] = RawValue{ };
+                }
+
+                ::ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void stop() noexcept {
+#if GREGJM_BENCH_HAS_PERF_EVENTS
+        for (const int fd : fds_) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+#endif
+    }
+
+    // counts between the last start() and stop(), scaled up when the kernel
+    // had to multiplex a counter; closed counters read as zero
+    CounterValues read() const noexcept {
+        CounterValues values{ };
+
+#if GREGJM_BENCH_HAS_PERF_EVENTS
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            if (fds_[i] < 0) {
+                continue;
+            }
+
+            RawValue current;
+
+            if (!read_raw(fds_[i], current)) {
+                continue;
+            }
+
+            const RawValue &baseline = baselines_[i];
+
+            const std::uint64_t value = current[0] - baseline[0];
+            const std::uint64_t enabled = current[1] - baseline[1];
+            const std::uint64_t running = current[2] - baseline[2];
+
+            values[i] = static_cast<double>(value);
+
+            if (running != 0 && running < enabled) {
+                values[i] *= static_cast<double>(enabled)
+                             / static_cast<double>(running);
+            }
+        }
+#endif
+
+        return values;
+    }
+
+private:
+    // count, time enabled and time running
+    using RawValue = std::array<std::uint64_t, 3>;
+
+#if GREGJM_BENCH_HAS_PERF_EVENTS
+    static int open(std::uint32_t type, std::uint64_t config) noexcept {
+        perf_event_attr attr{ };
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+                           | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1,
+                                          -1, 0));
+    }
+
+    static bool read_raw(int fd, RawValue &values) noexcept {
+        return ::read(fd, values.data(), sizeof(values))
+               == static_cast<ssize_t>(sizeof(values));
+    }
+#endif
+
+    std::array<int, num_counters> fds_;
+    std::array<RawValue, num_counters> baselines_{ };
+};
+
+} // namespace bench
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,552 @@
+#ifndef GREGJM_RADIX_SORT_HPP
+#define GREGJM_RADIX_SORT_HPP
+
+#include "pair.hpp"
+#include "thread_pool.hpp"
+#include "uninitialized.hpp"
+
+#include <algorithm> // std::min, std::max, std::copy
+#include <array>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint16_t, std::uint32_t, ...
+#include <cstring> // std::memcpy
+#include <iterator> // std::iterator_traits
+#include <limits> // std::numeric_limits
+#include <memory> // std::addressof
+#include <tuple> // std::tuple, std::tuple_element_t
+#include <type_traits>
+#include <utility> // std::index_sequence, std::swap
+#include <vector>
+
+namespace gregjm {
+
+namespace detail {
+
+template <std::size_t Size>
+using RadixKeyOfSizeT = std::conditional_t<
+    Size == 1, std::uint8_t,
+    std::conditional_t<
+        Size == 2, std::uint16_t,
+        std::conditional_t<Size == 4, std::uint32_t, std::uint64_t>
+    >
+>;
+
+template <typename T>
+static constexpr inline bool is_radix_sortable_v =
+    (std::is_integral_v<T> || std::is_enum_v<T>
+     || (std::is_floating_point_v<T> && std::numeric_limits<T>::is_iec559))
+    && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4
+        || sizeof(T) == 8);
+
+template <typename T>
+using RadixKeyT = RadixKeyOfSizeT<sizeof(T)>;
+
+// maps value to an unsigned integer with the same order. signed integers
+// have their sign bit flipped; negative floats have every bit flipped and
+// positive floats only their sign bit, so -0.0 sorts before 0.0 and NaNs
+// sort to the ends by sign
+template <typename T>
+RadixKeyT<T> radix_key(T value) noexcept {
+    using Key = RadixKeyT<T>;
+
+    constexpr Key sign_bit = static_cast<Key>(Key{ 1 } << (sizeof(T) * 8 - 1));
+
+    if constexpr (std::is_enum_v<T>) {
+        return radix_key(static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        Key bits;
+        std::memcpy(&bits, &value, sizeof(T));
+
+        return (bits & sign_bit) != 0 ? static_cast<Key>(~bits)
+                                      : static_cast<Key>(bits ^ sign_bit);
+    } else if constexpr (std::is_signed_v<T>) {
+        return static_cast<Key>(static_cast<Key>(value) ^ sign_bit);
+    } else {
+        return static_cast<Key>(value);
+    }
+}
+
+struct RadixFirst {
+    template <typename T>
+    static auto get(const T &value) noexcept {
+        return value.first();
+    }
+};
+
+struct RadixSecond {
+    template <typename T>
+    static auto get(const T &value) noexcept {
+        return value.second();
+    }
+};
+
+struct RadixIdentity {
+    template <typename T>
+    static T get(const T &value) noexcept {
+        return value;
+    }
+};
+
+template <typename Key, typename T>
+using RadixMemberT = decltype(Key::get(std::declval<const T&>()));
+
+// compares by Keys, most significant first, as the radix passes order them
+template <typename Key, typename ...Keys, typename T>
+bool radix_less(const T &lhs, const T &rhs) noexcept {
+    const auto lhs_key = radix_key(Key::get(lhs));
+    const auto rhs_key = radix_key(Key::get(rhs));
+
+    if constexpr (sizeof...(Keys) > 0) {
+        if (lhs_key == rhs_key) {
+            return radix_less<Keys...>(lhs, rhs);
+        }
+    }
+
+    return lhs_key < rhs_key;
+}
+
+static constexpr inline std::size_t radix_size = 256;
+
+using RadixHistogram = std::array<std::size_t, radix_size>;
+
+struct RadixDigit {
+    std::size_t key;
+    std::size_t shift;
+};
+
+// one digit per byte of each key, in the order they are sorted by: least
+// significant byte of the least significant key first
+template <std::size_t ...KeySizes>
+constexpr auto make_radix_digits() noexcept {
+    constexpr std::size_t key_sizes[] = { KeySizes... };
+
+    std::array<RadixDigit, (KeySizes + ...)> result{ };
+    std::size_t d = 0;
+
+    for (std::size_t k = sizeof...(KeySizes); k-- > 0;) {
+        for (std::size_t byte = 0; byte < key_sizes[k]; ++byte) {
+            result[d] = RadixDigit{ k, byte * 8 };
+            ++d;
+        }
+    }
+
+    return result;
+}
+
+template <std::size_t ...KeySizes>
+constexpr auto radix_first_digits() noexcept {
+    constexpr std::size_t key_sizes[] = { KeySizes... };
+
+    std::array<std::size_t, sizeof...(KeySizes)> result{ };
+    std::size_t d = 0;
+
+    for (std::size_t k = sizeof...(KeySizes); k-- > 0;) {
+        result[k] = d;
+        d += key_sizes[k];
+    }
+
+    return result;
+}
+
+// sorts data[0, size) by Keys, most significant key first, with one stable
+// counting pass per byte of each key, least significant byte of the last key
+// first. passes where every element has the same byte are skipped
+template <typename T, typename ...Keys>
+class RadixSorter {
+public:
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "radix_sort moves elements by copying their bytes");
+
+    // runs on the calling thread alone if pool is null
+    RadixSorter(T *data, std::size_t size, ThreadPool *pool)
+    : data_{ data }, size_{ size }, pool_{ pool },
+      num_threads_{ pool ? std::max<std::size_t>(
+          std::min(pool->num_threads(), size / min_elements_per_thread), 1
+      ) : 1 } { }
+
+    void sort() {
+        if (size_ <= insertion_sort_size) {
+            insertion_sort();
+
+            return;
+        }
+
+        const auto buffer = make_uninitialized_array<T>(size_);
+        T *source = data_;
+        T *destination = buffer.get();
+
+        // histograms of every digit for each thread's chunk. until the first
+        // scatter, they are also the per-chunk counts of each digit
+        std::vector<std::array<RadixHistogram, num_digits>> chunk_counts(
+            num_threads_
+        );
+
+        for_each_chunk([this, &chunk_counts](std::size_t thread,
+                                             std::size_t begin,
+                                             std::size_t end) {
+            count_all(begin, end, chunk_counts[thread]);
+        });
+
+        bool counts_are_current = true;
+        std::vector<RadixHistogram> offsets(num_threads_);
+
+        for (std::size_t d = 0; d < num_digits; ++d) {
+            if (is_trivial(chunk_counts, d, source)) {
+                continue;
+            }
+
+            if (!counts_are_current) {
+                for_each_chunk([this, &chunk_counts, source, d](
+                                   std::size_t thread, std::size_t begin,
+                                   std::size_t end) {
+                    count_digit(source, begin, end, d,
+                                chunk_counts[thread][d]);
+                });
+            }
+
+            compute_offsets(chunk_counts, d, offsets);
+
+            for_each_chunk([this, &offsets, source, destination, d](
+                               std::size_t thread, std::size_t begin,
+                               std::size_t end) {
+                scatter(source, destination, begin, end, d, offsets[thread]);
+            });
+
+            std::swap(source, destination);
+            counts_are_current = false;
+        }
+
+        if (source != data_) {
+            std::memcpy(static_cast<void*>(data_),
+                        static_cast<const void*>(source), size_ * sizeof(T));
+        }
+    }
+
+private:
+    static constexpr inline std::size_t insertion_sort_size = 64;
+    static constexpr inline std::size_t min_elements_per_thread = 1 << 16;
+
+    static constexpr inline std::size_t num_keys = sizeof...(Keys);
+
+    static constexpr inline std::array<std::size_t, num_keys> key_sizes{
+        sizeof(RadixMemberT<Keys, T>)...
+    };
+
+    // the first digit of each key
+    static constexpr inline std::array<std::size_t, num_keys> first_digits =
+        radix_first_digits<sizeof(RadixMemberT<Keys, T>)...>();
+
+    static constexpr inline std::size_t num_digits =
+        (sizeof(RadixMemberT<Keys, T>) + ...);
+
+    static constexpr inline std::array<RadixDigit, num_digits> digits =
+        make_radix_digits<sizeof(RadixMemberT<Keys, T>)...>();
+
+    template <std::size_t K>
+    using KeyAt = std::tuple_element_t<K, std::tuple<Keys...>>;
+
+    template <typename F, std::size_t ...Ks>
+    static void visit_key(std::size_t k, F &&f, std::index_sequence<Ks...>) {
+        (void) ((Ks == k ? (f(KeyAt<Ks>{ }), true) : false) || ...);
+    }
+
+    template <typename F>
+    static void visit_key(std::size_t k, F &&f) {
+        visit_key(k, std::forward<F>(f),
+                  std::make_index_sequence<num_keys>{ });
+    }
+
+    template <typename F>
+    void for_each_chunk(F &&f) const {
+        const std::size_t chunk = size_ / num_threads_;
+        const auto bounds = [this, chunk](std::size_t thread) {
+            return thread + 1 == num_threads_ ? size_ : chunk * (thread + 1);
+        };
+
+        if (num_threads_ == 1) {
+            f(std::size_t{ 0 }, std::size_t{ 0 }, size_);
+
+            return;
+        }
+
+        TaskGroup group{ *pool_ };
+
+        for (std::size_t thread = 1; thread < num_threads_; ++thread) {
+            group.run([&f, &bounds, chunk, thread] {
+                f(thread, chunk * thread, bounds(thread));
+            });
+        }
+
+        f(std::size_t{ 0 }, std::size_t{ 0 }, bounds(0));
+        group.wait();
+    }
+
+    template <std::size_t ...Ks>
+    void count_all(std::size_t begin, std::size_t end,
+                   std::array<RadixHistogram, num_digits> &counts,
+                   std::index_sequence<Ks...>) const noexcept {
+        for (std::size_t i = begin; i < end; ++i) {
+            (count_key<Ks>(data_[i], counts), ...);
+        }
+    }
+
+    void count_all(std::size_t begin, std::size_t end,
+                   std::array<RadixHistogram, num_digits> &counts) const
+    noexcept {
+        for (auto &histogram : counts) {
+            histogram.fill(0);
+        }
+
+        count_all(begin, end, counts, std::make_index_sequence<num_keys>{ });
+    }
+
+    template <std::size_t K>
+    static void count_key(const T &value,
+                          std::array<RadixHistogram, num_digits> &counts)
+    noexcept {
+        constexpr std::size_t first = first_digits[K];
+        const auto key = radix_key(KeyAt<K>::get(value));
+
+        for (std::size_t byte = 0; byte < key_sizes[K]; ++byte) {
+            ++counts[first + byte][(key >> (byte * 8)) & 0xff];
+        }
+    }
+
+    static void count_digit(const T *source, std::size_t begin,
+                            std::size_t end, std::size_t d,
+                            RadixHistogram &counts) noexcept {
+        counts.fill(0);
+
+        visit_key(digits[d].key, [source, begin, end, d, &counts](auto key) {
+            using Key = decltype(key);
+
+            const std::size_t shift = digits[d].shift;
+
+            for (std::size_t i = begin; i < end; ++i) {
+                ++counts[(radix_key(Key::get(source[i])) >> shift) & 0xff];
+            }
+        });
+    }
+
+    // a digit is trivial when every element has the same value for it
+    bool is_trivial(
+        const std::vector<std::array<RadixHistogram, num_digits>> &counts,
+        std::size_t d, const T *source
+    ) const noexcept {
+        std::size_t bucket = 0;
+
+        visit_key(digits[d].key, [source, d, &bucket](auto key) {
+            using Key = decltype(key);
+
+            bucket = (radix_key(Key::get(source[0])) >> digits[d].shift)
+                     & 0xff;
+        });
+
+        // the per-digit totals do not depend on where elements are, so the
+        // counts from before the first scatter still hold
+        std::size_t total = 0;
+
+        for (const auto &chunk : counts) {
+            total += chunk[d][bucket];
+        }
+
+        return total == size_;
+    }
+
+    // each thread writes its chunk's elements for bucket b after everything
+    // in smaller buckets and after earlier chunks' elements in bucket b
+    void compute_offsets(
+        const std::vector<std::array<RadixHistogram, num_digits>> &counts,
+        std::size_t d, std::vector<RadixHistogram> &offsets
+    ) const noexcept {
+        std::size_t offset = 0;
+
+        for (std::size_t bucket = 0; bucket < radix_size; ++bucket) {
+            for (std::size_t thread = 0; thread < num_threads_; ++thread) {
+                offsets[thread][bucket] = offset;
+                offset += counts[thread][d][bucket];
+            }
+        }
+    }
+
+    static void scatter(const T *source, T *destination, std::size_t begin,
+                        std::size_t end, std::size_t d,
+                        const RadixHistogram &offsets) noexcept {
+        visit_key(digits[d].key, [=, &offsets](auto key) {
+            using Key = decltype(key);
+
+            // a local copy, since the stores through destination could
+            // otherwise alias it and force a reload every iteration
+            RadixHistogram next = offsets;
+            const std::size_t shift = digits[d].shift;
+
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::size_t bucket =
+                    (radix_key(Key::get(source[i])) >> shift) & 0xff;
+                std::memcpy(static_cast<void*>(destination + next[bucket]++),
+                            static_cast<const void*>(source + i), sizeof(T));
+            }
+        });
+    }
+
+    void insertion_sort() noexcept {
+        for (std::size_t i = 1; i < size_; ++i) {
+            const T value = data_[i];
+            std::size_t j = i;
+
+            for (; j > 0 && radix_less<Keys...>(value, data_[j - 1]); --j) {
+                data_[j] = data_[j - 1];
+            }
+
+            data_[j] = value;
+        }
+    }
+
+    T *data_;
+    std::size_t size_;
+    ThreadPool *pool_;
+    std::size_t num_threads_;
+};
+
+template <typename T>
+struct RadixKeys {
+    using type = RadixSorter<T, RadixIdentity>;
+};
+
+template <typename First, typename Second>
+struct RadixKeys<Pair<First, Second>> {
+    using type = RadixSorter<Pair<First, Second>, RadixFirst, RadixSecond>;
+};
+
+template <typename T>
+static constexpr inline bool is_radix_sortable_element_v =
+    is_radix_sortable_v<T>;
+
+template <typename First, typename Second>
+static constexpr inline bool is_radix_sortable_element_v<Pair<First,
+                                                              Second>> =
+    is_radix_sortable_v<First> && is_radix_sortable_v<Second>;
+
+template <typename T>
+static constexpr inline bool is_radix_sortable_by_first_v = false;
+
+template <typename First, typename Second>
+static constexpr inline bool is_radix_sortable_by_first_v<Pair<First,
+                                                               Second>> =
+    is_radix_sortable_v<First> && std::is_trivially_copyable_v<Second>;
+
+template <typename RandomIt>
+using IteratorValueT = typename std::iterator_traits<RandomIt>::value_type;
+
+// the sorters work on a T*, so the range must be contiguous. before C++20
+// there is no way to ask an iterator that, so only pointers and the
+// iterators of std::vector are accepted; other contiguous ranges can be
+// passed as data() and data() + size()
+template <typename RandomIt, typename T = IteratorValueT<RandomIt>>
+static constexpr inline bool is_contiguous_iterator_v =
+#if defined(__cpp_lib_concepts)
+    std::contiguous_iterator<RandomIt>;
+#else
+    std::is_pointer_v<RandomIt>
+    || (std::is_same_v<RandomIt, typename std::vector<T>::iterator>
+        && !std::is_same_v<T, bool>);
+#endif
+
+template <typename RandomIt>
+static constexpr inline bool is_radix_sortable_range_v =
+    is_contiguous_iterator_v<RandomIt>
+    && is_radix_sortable_element_v<IteratorValueT<RandomIt>>;
+
+template <typename RandomIt>
+static constexpr inline bool is_radix_sortable_by_first_range_v =
+    is_contiguous_iterator_v<RandomIt>
+    && is_radix_sortable_by_first_v<IteratorValueT<RandomIt>>;
+
+template <typename Sorter, typename RandomIt>
+void radix_sort_range(RandomIt first, RandomIt last, ThreadPool *pool) {
+    const auto size = static_cast<std::size_t>(last - first);
+
+    if (size > 1) {
+        Sorter{ std::addressof(*first), size, pool }.sort();
+    }
+}
+
+} // namespace detail
+
+// sorts [first, last) into the order of operator<, for ranges of integers,
+// enums and IEEE floating point numbers, and of Pairs of them. Pairs are
+// sorted by second and then stably by first. floating point values are
+// ordered by their bits, so -0.0 sorts before 0.0 and NaNs sort to the ends.
+// the range must be contiguous: first and last are pointers or iterators of
+// std::vector. uses a buffer as large as the range
+template <typename RandomIt,
+          typename = std::enable_if_t<
+              detail::is_radix_sortable_range_v<RandomIt>
+          >>
+void radix_sort(RandomIt first, RandomIt last) {
+    using Sorter =
+        typename detail::RadixKeys<detail::IteratorValueT<RandomIt>>::type;
+
+    detail::radix_sort_range<Sorter>(first, last, nullptr);
+}
+
+// splits each pass across the pool; ranges too small to benefit use fewer
+// threads
+template <typename RandomIt,
+          typename = std::enable_if_t<
+              detail::is_radix_sortable_range_v<RandomIt>
+          >>
+void radix_sort(ThreadPool &pool, RandomIt first, RandomIt last) {
+    using Sorter =
+        typename detail::RadixKeys<detail::IteratorValueT<RandomIt>>::type;
+
+    detail::radix_sort_range<Sorter>(first, last, &pool);
+}
+
+template <typename RandomIt,
+          typename = std::enable_if_t<
+              detail::is_radix_sortable_range_v<RandomIt>
+          >>
+void radix_sort(parallel_t policy, RandomIt first, RandomIt last) {
+    ThreadPool pool{ policy.num_threads };
+
+    radix_sort(pool, first, last);
+}
+
+// stably sorts a range of Pairs by first alone, carrying second along as a
+// payload of any trivially copyable type
+template <typename RandomIt,
+          typename = std::enable_if_t<
+              detail::is_radix_sortable_by_first_range_v<RandomIt>
+          >>
+void radix_sort_by_first(RandomIt first, RandomIt last) {
+    using Sorter = detail::RadixSorter<detail::IteratorValueT<RandomIt>,
+                                       detail::RadixFirst>;
+
+    detail::radix_sort_range<Sorter>(first, last, nullptr);
+}
+
+template <typename RandomIt,
+          typename = std::enable_if_t<
+              detail::is_radix_sortable_by_first_range_v<RandomIt>
+          >>
+void radix_sort_by_first(ThreadPool &pool, RandomIt first, RandomIt last) {
+    using Sorter = detail::RadixSorter<detail::IteratorValueT<RandomIt>,
+                                       detail::RadixFirst>;
+
+    detail::radix_sort_range<Sorter>(first, last, &pool);
+}
+
+template <typename RandomIt,
+          typename = std::enable_if_t<
+              detail::is_radix_sortable_by_first_range_v<RandomIt>
+          >>
+void radix_sort_by_first(parallel_t policy, RandomIt first, RandomIt last) {
+    ThreadPool pool{ policy.num_threads };
+
+    radix_sort_by_first(pool, first, last);
+}
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef GREGJM_RELOCATE_HPP
+#define GREGJM_RELOCATE_HPP
+
+#include <cstddef> // std::size_t
+#include <cstring> // std::memmove
+#include <memory> // std::uninitialized_move, std::destroy
+#include <type_traits>
+
+namespace gregjm {
+
+// a type is trivially relocatable when moving an object into new storage and
+// then destroying the source is equivalent to copying its bytes. this holds
+// for every type with a trivial move constructor and destructor; specialize
+// it for types that are not trivially movable but still do not care about
+// their own address, like a unique owner of a heap allocation
+template <typename T>
+struct is_trivially_relocatable
+: std::bool_constant<std::is_trivially_move_constructible_v<T>
+                     && std::is_trivially_destructible_v<T>> { };
+
+template <typename T>
+static constexpr inline bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// stateless, but its copy constructor is user-provided in libstdc++
+template <typename T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type { };
+
+// move constructs [first, last) into the uninitialized storage at dest, then
+// destroys [first, last). trivially relocatable types are moved with a single
+// memmove; otherwise the ranges must not overlap. returns the end of the
+// destination range
+template <typename T>
+T* relocate(T *first, T *last, T *dest)
+noexcept(is_trivially_relocatable_v<T>
+         || std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        const auto count = static_cast<std::size_t>(last - first);
+
+        if (count != 0) {
+            std::memmove(static_cast<void*>(dest),
+                         static_cast<const void*>(first), count * sizeof(T));
+        }
+
+        return dest + count;
+    } else {
+        T *const end = std::uninitialized_move(first, last, dest);
+        std::destroy(first, last);
+
+        return end;
+    }
+}
+
+// relocate for a single object; returns dest
+template <typename T>
+T* relocate_at(T *source, T *dest)
+noexcept(is_trivially_relocatable_v<T>
+         || std::is_nothrow_move_constructible_v<T>) {
+    relocate(source, source + 1, dest);
+
+    return dest;
+}
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef GREGJM_SPAN_HPP
+#define GREGJM_SPAN_HPP
+
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <iterator> // std::data, std::size
+#include <type_traits>
+#include <utility> // std::declval
+
+namespace gregjm {
+namespace detail {
+
+template <typename C, typename T, typename = void>
+struct IsContiguousContainerOf : std::false_type { };
+
+template <typename C, typename T>
+struct IsContiguousContainerOf<
+    C, T, std::void_t<decltype(std::data(std::declval<C&>())),
+                      decltype(std::size(std::declval<C&>()))>
+> : std::is_convertible<
+        std::remove_pointer_t<decltype(std::data(std::declval<C&>()))>(*)[],
+        T(*)[]
+    > { };
+
+template <typename C, typename T>
+static constexpr inline bool is_contiguous_container_of_v =
+    IsContiguousContainerOf<C, T>::value;
+
+} // namespace detail
+
+// non-owning view of a contiguous sequence; a stand in for std::span until
+// this library moves to C++20
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(T *data, size_type size) noexcept
+    : data_{ data }, size_{ size } { }
+
+    template <typename U,
+              typename = std::enable_if_t<std::is_convertible_v<U(*)[],
+                                                                T(*)[]>>>
+    constexpr Span(const Span<U> &other) noexcept
+    : data_{ other.data() }, size_{ other.size() } { }
+
+    template <typename C,
+              typename = std::enable_if_t<
+                  detail::is_contiguous_container_of_v<C, T>
+              >>
+    constexpr Span(C &container) noexcept(noexcept(std::data(container)))
+    : data_{ std::data(container) }, size_{ std::size(container) } { }
+
+    constexpr inline T* data() const noexcept {
+        return data_;
+    }
+
+    constexpr inline size_type size() const noexcept {
+        return size_;
+    }
+
+    constexpr inline bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr inline T& operator[](size_type index) const noexcept {
+        return data_[index];
+    }
+
+    constexpr inline T& front() const noexcept {
+        return data_[0];
+    }
+
+    constexpr inline T& back() const noexcept {
+        return data_[size_ - 1];
+    }
+
+    constexpr inline iterator begin() const noexcept {
+        return data_;
+    }
+
+    constexpr inline iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    constexpr Span subspan(size_type offset, size_type count) const noexcept {
+        return Span{ data_ + offset, count };
+    }
+
+private:
+    T *data_ = nullptr;
+    size_type size_ = 0;
+};
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef GREGJM_TAGGED_POINTER_PAIR_HPP
+#define GREGJM_TAGGED_POINTER_PAIR_HPP
+
+#include "packed_pair.hpp"
+#include "pair.hpp"
+
+#include <cassert> // assert
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uintptr_t
+#include <functional> // std::hash
+#include <iostream> // std::basic_ostream
+#include <type_traits>
+
+namespace gregjm {
+namespace detail {
+
+constexpr std::size_t log2_floor(std::size_t value) noexcept {
+    std::size_t result = 0;
+
+    while (value > 1) {
+        value /= 2;
+        ++result;
+    }
+
+    return result;
+}
+
+// the number of low bits that are zero in every pointer to a T
+template <typename Pointer>
+static constexpr inline std::size_t pointer_free_bits_v =
+    log2_floor(alignof(std::remove_pointer_t<Pointer>));
+
+} // namespace detail
+
+// a pointer and a small tag stored together in one pointer-sized word. the
+// tag lives in the low bits that alignof(T) guarantees are zero, so by
+// default Bits is every bit the alignment frees. first() and second() behave
+// as in PackedPair: values when const, assignable proxies otherwise. debug
+// builds assert that pointers are aligned and that tags fit in Bits
+template <typename Pointer, typename Tag,
+          std::size_t Bits = detail::pointer_free_bits_v<Pointer>>
+class TaggedPointerPair {
+private:
+    static_assert(std::is_pointer_v<Pointer>
+                  && std::is_object_v<std::remove_pointer_t<Pointer>>,
+                  "TaggedPointerPair requires a pointer to an object type");
+    static_assert(detail::is_packable_v<Tag>,
+                  "TaggedPointerPair tags must be integral or enumeration "
+                  "types");
+    static_assert(Bits > 0 && Bits <= sizeof(Tag) * 8,
+                  "TaggedPointerPair tags must be between one bit and the "
+                  "width of their type");
+    static_assert(Bits <= detail::pointer_free_bits_v<Pointer>,
+                  "the alignment of the pointee does not free enough bits "
+                  "for the tag");
+
+    using TagField = detail::PackedField<Tag, Bits>;
+
+    static constexpr inline std::uintptr_t tag_mask =
+        (std::uintptr_t{ 1 } << Bits) - 1;
+
+public:
+    using first_type = Pointer;
+    using second_type = Tag;
+
+    static constexpr inline std::size_t tag_bits = Bits;
+
+    TaggedPointerPair() noexcept = default;
+
+    TaggedPointerPair(Pointer pointer, Tag tag) noexcept
+    : word_{ encode(pointer, tag) } { }
+
+    explicit TaggedPointerPair(const Pair<Pointer, Tag> &pair) noexcept
+    : TaggedPointerPair(pair.first(), pair.second()) { }
+
+    explicit operator Pair<Pointer, Tag>() const noexcept {
+        return { first(), second() };
+    }
+
+    static bool fits(Pointer pointer, Tag tag) noexcept {
+        return (reinterpret_cast<std::uintptr_t>(pointer) & tag_mask) == 0
+               && TagField::fits(tag);
+    }
+
+    std::uintptr_t word() const noexcept {
+        return word_;
+    }
+
+    detail::PackedFieldReference<TaggedPointerPair, 0> first() noexcept {
+        return detail::PackedFieldReference<TaggedPointerPair, 0>{ *this };
+    }
+
+    Pointer first() const noexcept {
+        return reinterpret_cast<Pointer>(word_ & ~tag_mask);
+    }
+
+    detail::PackedFieldReference<TaggedPointerPair, 1> second() noexcept {
+        return detail::PackedFieldReference<TaggedPointerPair, 1>{ *this };
+    }
+
+    Tag second() const noexcept {
+        return TagField::decode(word_);
+    }
+
+    void set_first(Pointer pointer) noexcept {
+        word_ = encode(pointer, second());
+    }
+
+    void set_second(Tag tag) noexcept {
+        word_ = encode(first(), tag);
+    }
+
+    void swap(TaggedPointerPair &other) noexcept {
+        const std::uintptr_t word = word_;
+        word_ = other.word_;
+        other.word_ = word;
+    }
+
+private:
+    static std::uintptr_t encode(Pointer pointer, Tag tag) noexcept {
+        assert(fits(pointer, tag)
+               && "TaggedPointerPair pointer is misaligned or tag overflows");
+
+        return reinterpret_cast<std::uintptr_t>(pointer)
+               | static_cast<std::uintptr_t>(TagField::encode(tag));
+    }
+
+    std::uintptr_t word_;
+};
+
+template <typename CharT, typename Traits, typename Pointer, typename Tag,
+          std::size_t Bits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits> &os,
+           const TaggedPointerPair<Pointer, Tag, Bits> &pair) {
+    return os << static_cast<Pair<Pointer, Tag>>(pair);
+}
+
+template <typename Pointer, typename Tag, std::size_t Bits>
+void swap(TaggedPointerPair<Pointer, Tag, Bits> &lhs,
+          TaggedPointerPair<Pointer, Tag, Bits> &rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Pointer, typename Tag, std::size_t Bits>
+bool operator==(const TaggedPointerPair<Pointer, Tag, Bits> &lhs,
+                const TaggedPointerPair<Pointer, Tag, Bits> &rhs) noexcept {
+    return lhs.word() == rhs.word();
+}
+
+template <typename Pointer, typename Tag, std::size_t Bits>
+bool operator!=(const TaggedPointerPair<Pointer, Tag, Bits> &lhs,
+                const TaggedPointerPair<Pointer, Tag, Bits> &rhs) noexcept {
+    return lhs.word() != rhs.word();
+}
+
+// orders by address and then by tag. the pointer sits above the tag in the
+// word, so with an unsigned tag this is a single integer compare
+template <typename Pointer, typename Tag, std::size_t Bits>
+bool operator<(const TaggedPointerPair<Pointer, Tag, Bits> &lhs,
+               const TaggedPointerPair<Pointer, Tag, Bits> &rhs) noexcept {
+    if constexpr (std::is_signed_v<detail::PackedUnderlyingT<Tag>>) {
+        if (lhs.first() != rhs.first()) {
+            return std::less<Pointer>{ }(lhs.first(), rhs.first());
+        }
+
+        return lhs.second() < rhs.second();
+    } else {
+        return lhs.word() < rhs.word();
+    }
+}
+
+template <typename Pointer, typename Tag, std::size_t Bits>
+bool operator<=(const TaggedPointerPair<Pointer, Tag, Bits> &lhs,
+                const TaggedPointerPair<Pointer, Tag, Bits> &rhs) noexcept {
+    return !(rhs < lhs);
+}
+
+template <typename Pointer, typename Tag, std::size_t Bits>
+bool operator>(const TaggedPointerPair<Pointer, Tag, Bits> &lhs,
+               const TaggedPointerPair<Pointer, Tag, Bits> &rhs) noexcept {
+    return rhs < lhs;
+}
+
+template <typename Pointer, typename Tag, std::size_t Bits>
+bool operator>=(const TaggedPointerPair<Pointer, Tag, Bits> &lhs,
+                const TaggedPointerPair<Pointer, Tag, Bits> &rhs) noexcept {
+    return !(lhs < rhs);
+}
+
+} // namespace gregjm
+
+namespace std {
+
+template <typename Pointer, typename Tag, std::size_t Bits>
+struct hash<gregjm::TaggedPointerPair<Pointer, Tag, Bits>> {
+    std::size_t operator()(
+        const gregjm::TaggedPointerPair<Pointer, Tag, Bits> &pair
+    ) const noexcept {
+        return std::hash<std::uintptr_t>{ }(pair.word());
+    }
+};
+
+} // namespace std
+
+#endif
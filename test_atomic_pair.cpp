@@ -0,0 +1,251 @@
+#include "atomic_pair.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Versioned = gregjm::Pair<std::uint64_t, std::uint64_t>;
+using Small = gregjm::Pair<std::uint32_t, std::uint32_t>;
+// final, so Pair holds it as a member rather than a base that would take part
+// in overload resolution for ==
+struct Payload final {
+    std::uint64_t low;
+    std::uint64_t high;
+
+    friend bool operator==(const Payload &lhs, const Payload &rhs) noexcept {
+        return lhs.low == rhs.low && lhs.high == rhs.high;
+    }
+
+    friend bool operator!=(const Payload &lhs, const Payload &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend std::ostream& operator<<(std::ostream &os, const Payload &payload) {
+        return os << '{' << payload.low << ", " << payload.high << '}';
+    }
+};
+
+using Large = gregjm::Pair<std::uint64_t, Payload>;
+
+constexpr std::size_t num_threads = 4;
+
+template <typename First, typename Second>
+void require_single_threaded(gregjm::Pair<First, Second> initial,
+                             gregjm::Pair<First, Second> desired) {
+    gregjm::AtomicPair<First, Second> atomic{ initial };
+
+    REQUIRE(atomic.load() == initial);
+
+    auto expected = desired;
+    REQUIRE_FALSE(atomic.compare_exchange_strong(expected, desired));
+    REQUIRE(expected == initial);
+    REQUIRE(atomic.load() == initial);
+
+    REQUIRE(atomic.compare_exchange_strong(expected, desired));
+    REQUIRE(atomic.load() == desired);
+
+    REQUIRE(atomic.exchange(initial) == desired);
+    REQUIRE(atomic.load() == initial);
+
+    atomic.store(desired);
+    REQUIRE(static_cast<gregjm::Pair<First, Second>>(atomic) == desired);
+
+    atomic = initial;
+    expected = initial;
+
+    while (!atomic.compare_exchange_weak(expected, desired)) { }
+
+    REQUIRE(atomic.load() == desired);
+}
+
+// every thread increments the count with a compare-exchange loop and
+// rewrites the rest of the pair from it, so a torn read or write shows up as
+// a pair that make would not have produced. Catch assertions are not thread
+// safe, so threads only count the torn values they see
+template <typename PairT, typename Make>
+void require_contended(Make make) {
+    constexpr std::size_t increments = 20000;
+
+    gregjm::AtomicPair<typename PairT::first_type,
+                       typename PairT::second_type> atomic{ make(0) };
+    std::atomic<std::size_t> torn{ 0 };
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&atomic, &make, &torn] {
+            for (std::size_t j = 0; j < increments; ++j) {
+                auto current = atomic.load();
+
+                while (!atomic.compare_exchange_weak(
+                           current, make(current.first() + 1))) {
+                    if (!(current == make(current.first()))) {
+                        ++torn;
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(torn == 0);
+    REQUIRE(atomic.load() == make(num_threads * increments));
+}
+
+struct Node {
+    std::atomic<Node*> next;
+    std::uint32_t value;
+};
+
+// a Treiber stack whose head is tagged with a version, so a pop that races
+// with a pop and push of the same node fails its compare-exchange instead of
+// installing a stale next pointer
+class Stack {
+public:
+    void push(Node *node) noexcept {
+        auto head = head_.load();
+
+        do {
+            node->next.store(head.first(), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(
+                     head, { node, head.second() + 1 }));
+    }
+
+    Node* pop() noexcept {
+        auto head = head_.load();
+
+        while (head.first() != nullptr) {
+            Node *const next =
+                head.first()->next.load(std::memory_order_relaxed);
+
+            if (head_.compare_exchange_weak(head,
+                                            { next, head.second() + 1 })) {
+                break;
+            }
+        }
+
+        return head.first();
+    }
+
+private:
+    gregjm::AtomicPair<Node*, std::uint64_t> head_;
+};
+
+} // namespace
+
+TEST_CASE("AtomicPair reports lock freedom", "[AtomicPair]") {
+    REQUIRE(gregjm::AtomicPair<std::uint32_t, std::uint32_t>
+            ::is_always_lock_free);
+    REQUIRE(gregjm::AtomicPair<std::uint64_t, std::uint64_t>
+            ::is_always_lock_free
+            == static_cast<bool>(GREGJM_ATOMIC_PAIR_HAS_CAS16));
+    REQUIRE(gregjm::AtomicPair<int*, std::uint64_t>::is_always_lock_free
+            == static_cast<bool>(GREGJM_ATOMIC_PAIR_HAS_CAS16));
+    REQUIRE_FALSE(gregjm::AtomicPair<std::uint64_t, Payload>
+                  ::is_always_lock_free);
+
+    const gregjm::AtomicPair<std::uint64_t, std::uint64_t> atomic;
+
+    REQUIRE(atomic.is_lock_free()
+            == gregjm::AtomicPair<std::uint64_t, std::uint64_t>
+               ::is_always_lock_free);
+    REQUIRE(atomic.load() == Versioned{ 0, 0 });
+}
+
+TEST_CASE("AtomicPair operations", "[AtomicPair]") {
+    SECTION("eight bytes") {
+        require_single_threaded(Small{ 1, 2 }, Small{ 3, 4 });
+    }
+
+    SECTION("sixteen bytes") {
+        require_single_threaded(Versioned{ 1, 2 }, Versioned{ 3, 4 });
+        require_single_threaded(Versioned{ 0, 0 }, Versioned{ ~0ull, 1 });
+    }
+
+    SECTION("seqlock") {
+        require_single_threaded(Large{ 1, Payload{ 2, 3 } },
+                                Large{ 4, Payload{ 5, 6 } });
+    }
+
+    SECTION("pointer and version") {
+        int value = 0;
+
+        require_single_threaded(gregjm::Pair<int*, std::uint64_t>{
+                                    nullptr, 0
+                                },
+                                gregjm::Pair<int*, std::uint64_t>{
+                                    &value, 1
+                                });
+    }
+}
+
+TEST_CASE("AtomicPair updates both members together", "[AtomicPair]") {
+    SECTION("sixteen bytes") {
+        require_contended<Versioned>([](std::uint64_t count) {
+            return Versioned{ count, count * 3 };
+        });
+    }
+
+    SECTION("seqlock") {
+        require_contended<Large>([](std::uint64_t count) {
+            return Large{ count, Payload{ count * 3, count * 5 } };
+        });
+    }
+}
+
+TEST_CASE("AtomicPair versioned pointers prevent ABA", "[AtomicPair]") {
+    constexpr std::size_t num_nodes = 64;
+    constexpr std::size_t rounds = 20000;
+
+    std::vector<Node> nodes(num_nodes);
+    Stack stack;
+
+    for (std::size_t i = 0; i < num_nodes; ++i) {
+        nodes[i].value = static_cast<std::uint32_t>(i);
+        stack.push(&nodes[i]);
+    }
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&stack] {
+            for (std::size_t j = 0; j < rounds; ++j) {
+                Node *const first = stack.pop();
+                Node *const second = stack.pop();
+
+                if (first != nullptr) {
+                    stack.push(first);
+                }
+
+                if (second != nullptr) {
+                    stack.push(second);
+                }
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<std::uint32_t> values;
+
+    while (Node *const node = stack.pop()) {
+        values.push_back(node->value);
+    }
+
+    std::sort(values.begin(), values.end());
+
+    REQUIRE(values.size() == num_nodes);
+    REQUIRE(std::adjacent_find(values.begin(), values.end()) == values.end());
+}
@@ -0,0 +1,200 @@
+#include "const_map.hpp"
+#include "pair.hpp"
+
+#include "catch.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+enum class Opcode : std::uint8_t {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Negate,
+    Halt
+};
+
+using Handler = int (*)(int, int);
+
+constexpr int add(int lhs, int rhs) {
+    return lhs + rhs;
+}
+
+constexpr int subtract(int lhs, int rhs) {
+    return lhs - rhs;
+}
+
+constexpr int multiply(int lhs, int rhs) {
+    return lhs * rhs;
+}
+
+constexpr int divide(int lhs, int rhs) {
+    return lhs / rhs;
+}
+
+constexpr gregjm::ConstMap handlers{ std::array<
+    gregjm::Pair<Opcode, Handler>, 4
+>{ {
+    { Opcode::Add, &add },
+    { Opcode::Subtract, &subtract },
+    { Opcode::Multiply, &multiply },
+    { Opcode::Divide, &divide }
+} } };
+
+static_assert(std::is_same_v<decltype(handlers),
+                             const gregjm::ConstMap<Opcode, Handler, 4>>);
+static_assert(handlers.strategy == gregjm::ConstMapStrategy::LinearScan);
+static_assert(handlers.size() == 4);
+static_assert(handlers.at(Opcode::Multiply)(6, 7) == 42);
+static_assert(handlers.contains(Opcode::Divide));
+static_assert(!handlers.contains(Opcode::Halt));
+static_assert(handlers.find(Opcode::Negate) == nullptr);
+
+constexpr std::size_t num_squares = 500;
+
+// key i * i maps to i, declared in a scrambled order
+constexpr std::array<gregjm::Pair<std::int64_t, std::size_t>, num_squares>
+make_squares() {
+    std::array<gregjm::Pair<std::int64_t, std::size_t>, num_squares> squares{ };
+
+    for (std::size_t i = 0; i < num_squares; ++i) {
+        const std::size_t root = (i * 7919) % num_squares;
+        const auto signed_root = static_cast<std::int64_t>(root);
+
+        squares[i] = gregjm::Pair<std::int64_t, std::size_t>{
+            signed_root * signed_root, root
+        };
+    }
+
+    return squares;
+}
+
+constexpr gregjm::ConstMap squares{ make_squares() };
+
+static_assert(squares.strategy == gregjm::ConstMapStrategy::PerfectHash);
+static_assert(squares.at(0) == 0);
+static_assert(squares.at(144) == 12);
+static_assert(squares.at(499 * 499) == 499);
+static_assert(!squares.contains(2));
+static_assert(!squares.contains(-1));
+
+constexpr gregjm::ConstMap<std::string_view, int, 12> months{ std::array<
+    gregjm::Pair<std::string_view, int>, 12
+>{ {
+    { "jan", 1 }, { "feb", 2 }, { "mar", 3 }, { "apr", 4 },
+    { "may", 5 }, { "jun", 6 }, { "jul", 7 }, { "aug", 8 },
+    { "sep", 9 }, { "oct", 10 }, { "nov", 11 }, { "dec", 12 }
+} } };
+
+static_assert(months.strategy == gregjm::ConstMapStrategy::Eytzinger);
+static_assert(months.at("jan") == 1);
+static_assert(months.at("may") == 5);
+static_assert(months.at("dec") == 12);
+static_assert(!months.contains("abc"));
+static_assert(!months.contains("zzz"));
+static_assert(!months.contains("mab"));
+
+constexpr gregjm::ConstMap<std::string_view, char, 3> few{ std::array<
+    gregjm::Pair<std::string_view, char>, 3
+>{ { { "one", '1' }, { "two", '2' }, { "three", '3' } } } };
+
+static_assert(few.strategy == gregjm::ConstMapStrategy::LinearScan);
+static_assert(few.at("two") == '2');
+static_assert(!few.contains("four"));
+
+static_assert(gregjm::ConstMap<int, int, 0>{ std::array<
+    gregjm::Pair<int, int>, 0
+>{ } }.empty());
+
+// the strategy depends only on the key type and the size
+static_assert(gregjm::ConstMap<std::uint32_t, int, 16>::strategy
+              == gregjm::ConstMapStrategy::LinearScan);
+static_assert(gregjm::ConstMap<std::uint32_t, int, 17>::strategy
+              == gregjm::ConstMapStrategy::PerfectHash);
+static_assert(gregjm::ConstMap<std::string_view, int, 8>::strategy
+              == gregjm::ConstMapStrategy::LinearScan);
+static_assert(gregjm::ConstMap<std::string_view, int, 9>::strategy
+              == gregjm::ConstMapStrategy::Eytzinger);
+
+} // namespace
+
+TEST_CASE("ConstMap finds every key", "[ConstMap]") {
+    SECTION("linear scan") {
+        REQUIRE(handlers.at(Opcode::Add)(2, 3) == 5);
+        REQUIRE(handlers.at(Opcode::Subtract)(2, 3) == -1);
+        REQUIRE(*handlers.find(Opcode::Divide) == &divide);
+        REQUIRE_FALSE(handlers.contains(Opcode::Halt));
+    }
+
+    SECTION("perfect hash") {
+        for (std::int64_t root = 0; root < 500; ++root) {
+            REQUIRE(squares.at(root * root) == static_cast<std::size_t>(root));
+        }
+
+        for (std::int64_t key = 0; key < 2000; ++key) {
+            const auto root = static_cast<std::int64_t>(
+                squares.find(key) == nullptr ? 0 : *squares.find(key)
+            );
+
+            REQUIRE(squares.contains(key) == (root * root == key));
+        }
+    }
+
+    SECTION("Eytzinger search") {
+        const std::array<std::string_view, 12> names{ {
+            "jan", "feb", "mar", "apr", "may", "jun",
+            "jul", "aug", "sep", "oct", "nov", "dec"
+        } };
+
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            REQUIRE(months.at(names[i]) == static_cast<int>(i + 1));
+        }
+
+        for (const std::string_view missing : { "", "a", "aug2", "ma", "zz" }) {
+            REQUIRE_FALSE(months.contains(missing));
+        }
+    }
+
+    SECTION("Eytzinger trees with a partial last level") {
+        const gregjm::ConstMap<std::string_view, int, 9> letters{ std::array<
+            gregjm::Pair<std::string_view, int>, 9
+        >{ {
+            { "i", 9 }, { "h", 8 }, { "g", 7 }, { "f", 6 }, { "e", 5 },
+            { "d", 4 }, { "c", 3 }, { "b", 2 }, { "a", 1 }
+        } } };
+        const std::string_view alphabet = "abcdefghi";
+
+        for (std::size_t i = 0; i < alphabet.size(); ++i) {
+            REQUIRE(letters.at(alphabet.substr(i, 1))
+                    == static_cast<int>(i + 1));
+        }
+
+        REQUIRE_FALSE(letters.contains("j"));
+        REQUIRE_FALSE(letters.contains("0"));
+    }
+}
+
+TEST_CASE("ConstMap reports errors", "[ConstMap]") {
+    REQUIRE_THROWS_AS(months.at("none"), std::out_of_range);
+    REQUIRE_THROWS_AS(squares.at(3), std::out_of_range);
+
+    const std::array<gregjm::Pair<int, int>, 3> duplicates{ {
+        { 1, 1 }, { 2, 2 }, { 1, 3 }
+    } };
+
+    REQUIRE_THROWS_AS(gregjm::ConstMap{ duplicates }, std::invalid_argument);
+
+    std::array<gregjm::Pair<int, int>, 40> many{ };
+
+    for (std::size_t i = 0; i < many.size(); ++i) {
+        many[i] = gregjm::Pair<int, int>{ static_cast<int>(i % 39), 0 };
+    }
+
+    REQUIRE_THROWS_AS(gregjm::ConstMap{ many }, std::invalid_argument);
+}
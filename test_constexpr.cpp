@@ -0,0 +1,184 @@
+#include "constexpr_sort.hpp"
+#include "pair.hpp"
+#include "tuple.hpp"
+
+#include "catch.hpp"
+
+#include <array>
+#include <cstddef>
+
+// built twice: once as C++17 with the inheritance backend and once as C++20
+// with the [[no_unique_address]] backend. everything here is checked in
+// static_assert, so this only compiles if each operation is a constant
+// expression
+
+namespace {
+
+struct Empty {
+    constexpr bool operator==(const Empty&) const noexcept {
+        return true;
+    }
+
+    constexpr bool operator!=(const Empty&) const noexcept {
+        return false;
+    }
+};
+
+using IntPair = gregjm::Pair<int, int>;
+using Entry = gregjm::Pair<int, char>;
+
+// construction and access
+static_assert(IntPair{ 1, 2 }.first() == 1);
+static_assert(IntPair{ 1, 2 }.second() == 2);
+static_assert(IntPair{ }.first() == 0);
+static_assert(gregjm::get<1>(IntPair{ 3, 4 }) == 4);
+static_assert(gregjm::make_pair(5, 'a').second() == 'a');
+static_assert(gregjm::Pair<Empty, int>{ Empty{ }, 7 }.second() == 7);
+static_assert(gregjm::Pair<int, Empty>{ 7, Empty{ } }.first() == 7);
+static_assert(gregjm::Pair<IntPair, int>{ IntPair{ 1, 2 }, 3 }
+                  .first().second() == 2);
+static_assert(gregjm::Tuple<int, Empty, char>{ 1, Empty{ }, 'c' }
+                  .get<2>() == 'c');
+
+constexpr IntPair assigned() {
+    IntPair pair{ 1, 2 };
+    const IntPair other{ 3, 4 };
+
+    pair = other;
+    pair.first() += 10;
+
+    return pair;
+}
+
+static_assert(assigned() == IntPair{ 13, 4 });
+
+constexpr gregjm::Pair<long, long> assigned_converted() {
+    gregjm::Pair<long, long> pair{ };
+    pair = IntPair{ 5, 6 };
+
+    return pair;
+}
+
+static_assert(assigned_converted() == gregjm::Pair<long, long>{ 5, 6 });
+
+// swap, through every storage kind: data members, inherited empty members,
+// elided shared empties and nested Pairs
+constexpr bool swaps() {
+    IntPair lhs{ 1, 2 };
+    IntPair rhs{ 3, 4 };
+    swap(lhs, rhs);
+
+    gregjm::Pair<Empty, int> empty_lhs{ Empty{ }, 1 };
+    gregjm::Pair<Empty, int> empty_rhs{ Empty{ }, 2 };
+    empty_lhs.swap(empty_rhs);
+
+    gregjm::Pair<Empty, Empty> shared_lhs;
+    gregjm::Pair<Empty, Empty> shared_rhs;
+    swap(shared_lhs, shared_rhs);
+
+    gregjm::Pair<IntPair, int> nested_lhs{ IntPair{ 1, 2 }, 3 };
+    gregjm::Pair<IntPair, int> nested_rhs{ IntPair{ 4, 5 }, 6 };
+    swap(nested_lhs, nested_rhs);
+
+    gregjm::Tuple<int, Empty, char> tuple_lhs{ 1, Empty{ }, 'a' };
+    gregjm::Tuple<int, Empty, char> tuple_rhs{ 2, Empty{ }, 'b' };
+    swap(tuple_lhs, tuple_rhs);
+
+    int i = 1;
+    int j = 2;
+    int k = 3;
+    int l = 4;
+    swap(gregjm::Pair<int&, int&>{ i, j }, gregjm::Pair<int&, int&>{ k, l });
+
+    return lhs == IntPair{ 3, 4 } && rhs == IntPair{ 1, 2 }
+           && empty_lhs.second() == 2 && empty_rhs.second() == 1
+           && nested_lhs.first().first() == 4 && nested_rhs.second() == 3
+           && tuple_lhs.get<0>() == 2 && tuple_rhs.get<2>() == 'a'
+           && i == 3 && j == 4 && k == 1 && l == 2;
+}
+
+static_assert(swaps());
+
+// comparisons
+static_assert(IntPair{ 1, 2 } == IntPair{ 1, 2 });
+static_assert(IntPair{ 1, 2 } != IntPair{ 2, 1 });
+static_assert(IntPair{ 1, 2 } < IntPair{ 1, 3 });
+static_assert(IntPair{ 1, 2 } <= IntPair{ 1, 2 });
+static_assert(IntPair{ 2, 0 } > IntPair{ 1, 9 });
+static_assert(IntPair{ 2, 0 } >= IntPair{ 2, 0 });
+static_assert(gregjm::compare(IntPair{ 1, 2 }, IntPair{ 1, 3 }) < 0);
+static_assert(gregjm::Tuple<int, char>{ 1, 'a' }
+              < gregjm::Tuple<int, char>{ 1, 'b' });
+#if GREGJM_HAS_THREE_WAY_COMPARISON
+static_assert((IntPair{ 1, 2 } <=> IntPair{ 1, 3 }) < 0);
+#endif
+
+// a table declared out of order and sorted at compile time
+constexpr auto table = gregjm::sorted(std::array<Entry, 8>{ {
+    { 40, 'd' }, { 10, 'a' }, { 80, 'h' }, { 30, 'c' },
+    { 70, 'g' }, { 20, 'b' }, { 60, 'f' }, { 50, 'e' }
+} });
+
+template <typename T, std::size_t N>
+constexpr bool is_sorted(const std::array<T, N> &array) {
+    for (std::size_t i = 1; i < N; ++i) {
+        if (array[i] < array[i - 1]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <std::size_t N>
+constexpr char lookup(const std::array<Entry, N> &entries, int key) {
+    std::size_t first = 0;
+    std::size_t last = N;
+
+    while (first < last) {
+        const std::size_t middle = first + (last - first) / 2;
+
+        if (entries[middle].first() < key) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    return first < N && entries[first].first() == key
+           ? entries[first].second() : '\0';
+}
+
+static_assert(is_sorted(table));
+static_assert(lookup(table, 10) == 'a');
+static_assert(lookup(table, 50) == 'e');
+static_assert(lookup(table, 80) == 'h');
+static_assert(lookup(table, 55) == '\0');
+
+constexpr auto descending = gregjm::sorted(
+    std::array<int, 6>{ { 3, 1, 4, 1, 5, 9 } },
+    [](int lhs, int rhs) { return lhs > rhs; }
+);
+
+static_assert(descending[0] == 9 && descending[1] == 5 && descending[2] == 4
+              && descending[3] == 3 && descending[4] == 1
+              && descending[5] == 1);
+static_assert(gregjm::sorted(std::array<int, 0>{ }).empty());
+static_assert(gregjm::sorted(std::array<int, 1>{ { 7 } })[0] == 7);
+
+} // namespace
+
+TEST_CASE("constexpr tables are usable at run time", "[Pair][constexpr]") {
+    REQUIRE(table.front() == Entry{ 10, 'a' });
+    REQUIRE(table.back() == Entry{ 80, 'h' });
+    REQUIRE(lookup(table, 30) == 'c');
+
+    std::array<Entry, 8> copy = table;
+    gregjm::constexpr_sort(copy.begin(), copy.end(),
+                           [](const Entry &lhs, const Entry &rhs) {
+        return lhs.second() > rhs.second();
+    });
+
+    REQUIRE(copy.front().second() == 'h');
+    REQUIRE(copy.back().second() == 'a');
+}
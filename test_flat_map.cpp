@@ -0,0 +1,276 @@
+#include "flat_map.hpp"
+
+#include "catch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+struct Empty {
+    constexpr bool operator==(const Empty&) const noexcept {
+        return true;
+    }
+};
+
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const noexcept {
+        return std::hash<std::string_view>{ }(str);
+    }
+};
+
+struct SeededHash {
+    std::uint64_t seed;
+
+    std::size_t operator()(int key) const noexcept {
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(key)
+                                        ^ seed);
+    }
+};
+
+// every key in the same group, to exercise probing past full groups
+struct CollidingHash {
+    std::size_t operator()(int) const noexcept {
+        return 0;
+    }
+};
+
+} // namespace
+
+TEST_CASE("FlatMap stores stateless policies in zero bytes", "[FlatMap]") {
+    REQUIRE(sizeof(gregjm::FlatMap<int, int>) == 5 * sizeof(void*));
+    REQUIRE(sizeof(gregjm::FlatMap<std::string, int, StringHash,
+                                   std::equal_to<>>)
+            == 5 * sizeof(void*));
+    REQUIRE(sizeof(gregjm::FlatMap<int, int, SeededHash>)
+            == 6 * sizeof(void*));
+
+    // slots of a map with an empty value are just keys
+    REQUIRE(sizeof(gregjm::FlatMap<int, Empty>::value_type) == sizeof(int));
+}
+
+TEST_CASE("FlatMap agrees with std::unordered_map", "[FlatMap]") {
+    gregjm::FlatMap<std::uint64_t, std::uint64_t> map;
+    std::unordered_map<std::uint64_t, std::uint64_t> expected;
+
+    std::uint64_t state = 0x9e3779b97f4a7c15;
+
+    for (int i = 0; i < 20000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        const std::uint64_t key = state % 2048;
+
+        switch (state >> 62) {
+        case 0:
+        case 1:
+            REQUIRE(map.try_emplace(key, state).second()
+                    == expected.try_emplace(key, state).second);
+            break;
+        case 2:
+            REQUIRE(map.erase(key) == expected.erase(key));
+            break;
+        default:
+            REQUIRE(map.contains(key) == (expected.count(key) == 1));
+            break;
+        }
+    }
+
+    REQUIRE(map.size() == expected.size());
+
+    std::size_t visited = 0;
+
+    for (const auto [key, value] : map) {
+        REQUIRE(expected.at(key) == value);
+        ++visited;
+    }
+
+    REQUIRE(visited == expected.size());
+}
+
+TEST_CASE("FlatMap supports the usual map operations", "[FlatMap]") {
+    gregjm::FlatMap<int, std::string> map{ { 1, "one" }, { 2, "two" } };
+
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.at(1) == "one");
+    REQUIRE_THROWS_AS(map.at(3), std::out_of_range);
+
+    map[3] = "three";
+
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.find(3)->second() == "three");
+    REQUIRE(map.find(4) == map.end());
+
+    REQUIRE_FALSE(map.insert({ 3, "drei" }).second());
+    REQUIRE(map[3] == "three");
+    REQUIRE_FALSE(map.insert_or_assign(3, "drei").second());
+    REQUIRE(map[3] == "drei");
+
+    SECTION("copy and move") {
+        gregjm::FlatMap<int, std::string> copy = map;
+
+        REQUIRE(copy == map);
+
+        copy[4] = "four";
+
+        REQUIRE(copy != map);
+
+        gregjm::FlatMap<int, std::string> moved = std::move(copy);
+
+        REQUIRE(copy.empty());
+        REQUIRE(copy.begin() == copy.end());
+        REQUIRE(moved.size() == 4);
+
+        copy = moved;
+        moved = std::move(map);
+
+        REQUIRE(copy.size() == 4);
+        REQUIRE(moved.size() == 3);
+    }
+
+    SECTION("erase and clear") {
+        map.erase(map.find(1));
+
+        REQUIRE_FALSE(map.contains(1));
+        REQUIRE(map.count(2) == 1);
+
+        map.clear();
+
+        REQUIRE(map.empty());
+        REQUIRE(map.begin() == map.end());
+
+        map[7] = "seven";
+
+        REQUIRE(map.size() == 1);
+    }
+}
+
+TEST_CASE("FlatMap reserves and reuses deleted slots", "[FlatMap]") {
+    gregjm::FlatMap<int, int> map;
+    map.reserve(1000);
+
+    const auto capacity = map.capacity();
+
+    REQUIRE(capacity >= 1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        map.try_emplace(i, i);
+    }
+
+    REQUIRE(map.capacity() == capacity);
+
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < 500; ++i) {
+            map.erase(i);
+        }
+
+        for (int i = 0; i < 500; ++i) {
+            map.try_emplace(i, round);
+        }
+    }
+
+    REQUIRE(map.size() == 1000);
+    REQUIRE(map.capacity() == capacity);
+    REQUIRE(map.at(499) == 49);
+    REQUIRE(map.at(999) == 999);
+}
+
+TEST_CASE("FlatMap inserts elements of itself across a rehash",
+          "[FlatMap]") {
+    gregjm::FlatMap<int, std::string> map;
+    map.try_emplace(0, std::string(64, 'a'));
+
+    // each insertion copies the previous value, so some of them read from
+    // the table that the insertion itself replaces
+    for (int i = 1; i < 200; ++i) {
+        const auto capacity = map.capacity();
+        map.try_emplace(i, map.at(i - 1));
+
+        if (map.capacity() != capacity) {
+            REQUIRE(map.at(i) == std::string(64, 'a'));
+        }
+    }
+
+    // and each key is the value stored under the previous one
+    const auto name = [](int i) {
+        return std::string(32, 'k') + std::to_string(i);
+    };
+
+    gregjm::FlatMap<std::string, std::string> chain;
+    chain.try_emplace(name(0), name(1));
+
+    for (int i = 1; i < 200; ++i) {
+        chain.try_emplace(chain.at(name(i - 1)), name(i + 1));
+    }
+
+    REQUIRE(chain.size() == 200);
+
+    for (int i = 0; i < 200; ++i) {
+        REQUIRE(chain.at(name(i)) == name(i + 1));
+    }
+}
+
+TEST_CASE("FlatMap probes past full groups", "[FlatMap]") {
+    gregjm::FlatMap<int, int, CollidingHash> map;
+
+    for (int i = 0; i < 200; ++i) {
+        map[i] = i * 2;
+    }
+
+    for (int i = 0; i < 200; i += 2) {
+        map.erase(i);
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        REQUIRE(map.contains(i) == (i % 2 == 1));
+    }
+}
+
+TEST_CASE("FlatMap supports heterogeneous lookup", "[FlatMap]") {
+    gregjm::FlatMap<std::string, int, StringHash, std::equal_to<>> map;
+
+    map["alpha"] = 1;
+    map[std::string{ "beta" }] = 2;
+
+    REQUIRE(map.find(std::string_view{ "alpha" })->second() == 1);
+    REQUIRE(map.contains("beta"));
+    REQUIRE(map.at(std::string_view{ "beta" }) == 2);
+    REQUIRE(map.erase(std::string_view{ "alpha" }) == 1);
+    REQUIRE_FALSE(map.contains("alpha"));
+
+    // a transparent key equality must not take iterators for keys
+    map["gamma"] = 3;
+
+    const auto next = map.erase(map.begin());
+
+    REQUIRE(map.size() == 1);
+    REQUIRE(next != map.end());
+    REQUIRE(map.erase(map.cbegin()) == map.end());
+    REQUIRE(map.empty());
+}
+
+TEST_CASE("FlatMap with an empty value is a set", "[FlatMap]") {
+    gregjm::FlatMap<int, Empty> set;
+
+    for (int i = 0; i < 100; ++i) {
+        set.try_emplace(i % 10);
+    }
+
+    REQUIRE(set.size() == 10);
+    REQUIRE(set.contains(9));
+
+    gregjm::FlatMap<int, int, SeededHash> seeded{ 0, SeededHash{ 42 } };
+    seeded[1] = 1;
+
+    REQUIRE(seeded.hash_function().seed == 42);
+    REQUIRE(seeded.at(1) == 1);
+}
@@ -0,0 +1,177 @@
+#include "flat_pair.hpp"
+#include "pair.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Empty { };
+
+using Inner = gregjm::Pair<std::uint64_t, std::uint8_t>;
+using Nested = gregjm::Pair<std::uint8_t, Inner>;
+using Flat = gregjm::FlatPair<std::uint8_t, Inner>;
+
+using Key = gregjm::Pair<gregjm::Pair<std::uint16_t, std::uint32_t>,
+                         gregjm::Pair<std::uint8_t, std::uint64_t>>;
+using FlatKey = gregjm::flat_pair_t<Key>;
+
+static_assert(sizeof(Nested) == 24);
+static_assert(sizeof(Flat) == 16);
+static_assert(sizeof(Key) == 24);
+static_assert(sizeof(FlatKey) == 16);
+static_assert(Flat::num_leaves == 3);
+static_assert(FlatKey::num_leaves == 4);
+static_assert(std::is_same_v<FlatKey,
+                             gregjm::FlatPair<Key::first_type,
+                                              Key::second_type>>);
+
+static_assert(std::is_trivially_copyable_v<Flat>);
+static_assert(gregjm::is_trivially_relocatable_v<Flat>);
+static_assert(std::is_same_v<decltype(std::declval<Flat&>().first()),
+                             std::uint8_t&>);
+static_assert(std::is_same_v<
+    decltype(std::declval<const Flat&>().second().first()),
+    const std::uint64_t&
+>);
+
+Inner make_inner(std::uint64_t first, std::uint8_t second) {
+    return Inner{ first, second };
+}
+
+Key make_key(std::uint16_t a, std::uint32_t b, std::uint8_t c,
+             std::uint64_t d) {
+    return Key{ Key::first_type{ a, b }, Key::second_type{ c, d } };
+}
+
+// empty leaves take no space, and a repeated empty leaf shares storage
+static_assert(sizeof(gregjm::FlatPair<Empty, gregjm::Pair<int, Empty>>)
+              == sizeof(int));
+
+} // namespace
+
+TEST_CASE("FlatPair keeps nested access", "[FlatPair]") {
+    Flat flat{ std::uint8_t{ 1 }, make_inner(2, 3) };
+
+    REQUIRE(flat.first() == 1);
+    REQUIRE(flat.second().first() == 2);
+    REQUIRE(flat.second().second() == 3);
+    REQUIRE(flat.leaf<0>() == 1);
+    REQUIRE(flat.leaf<1>() == 2);
+    REQUIRE(flat.leaf<2>() == 3);
+    REQUIRE(&flat.second().first() == &flat.leaf<1>());
+
+    SECTION("leaves are laid out by decreasing alignment") {
+        const auto *base = reinterpret_cast<const unsigned char*>(&flat);
+
+        REQUIRE(reinterpret_cast<const unsigned char*>(&flat.leaf<1>())
+                == base);
+    }
+
+    SECTION("views assign through") {
+        flat.second().first() = 20;
+        flat.second() = make_inner(40, 50);
+
+        REQUIRE(flat.leaf<1>() == 40);
+        REQUIRE(flat.leaf<2>() == 50);
+        REQUIRE(flat.second() == make_inner(40, 50));
+        REQUIRE(make_inner(40, 50) == flat.second());
+
+        Flat other{ std::uint8_t{ 7 }, make_inner(8, 9) };
+        other.second() = flat.second();
+
+        REQUIRE(other.second() == make_inner(40, 50));
+        REQUIRE(other.first() == 7);
+    }
+
+    SECTION("views convert to the nested Pair") {
+        const Inner inner = flat.second();
+
+        REQUIRE(inner == make_inner(2, 3));
+        REQUIRE(static_cast<Nested>(flat)
+                == Nested{ std::uint8_t{ 1 }, make_inner(2, 3) });
+    }
+
+    SECTION("a view initializes another FlatPair") {
+        const gregjm::FlatPair<int, Inner> copy{ 5, flat.second() };
+
+        REQUIRE(copy.second() == make_inner(2, 3));
+    }
+}
+
+TEST_CASE("FlatPair converts to and from Pair", "[FlatPair]") {
+    const Key key = make_key(1, 2, 3, 4);
+    const FlatKey flat = gregjm::flatten(key);
+
+    REQUIRE(flat.first().first() == 1);
+    REQUIRE(flat.first().second() == 2);
+    REQUIRE(flat.second().first() == 3);
+    REQUIRE(flat.second().second() == 4);
+    REQUIRE(static_cast<Key>(flat) == key);
+
+    std::ostringstream flat_oss;
+    flat_oss << flat;
+    std::ostringstream nested_oss;
+    nested_oss << key;
+
+    REQUIRE(flat_oss.str() == nested_oss.str());
+
+    SECTION("members are moved out of rvalue Pairs") {
+        using StringPair = gregjm::Pair<std::string,
+                                        gregjm::Pair<int, std::string>>;
+
+        StringPair pair{ std::string(32, 'a'),
+                         StringPair::second_type{ 1, std::string(32, 'b') } };
+        const gregjm::flat_pair_t<StringPair> moved =
+            gregjm::flatten(std::move(pair));
+
+        REQUIRE(moved.first() == std::string(32, 'a'));
+        REQUIRE(moved.second().second() == std::string(32, 'b'));
+        REQUIRE(pair.first().empty());
+        REQUIRE(pair.second().second().empty());
+    }
+}
+
+TEST_CASE("FlatPair orders like the nested Pair", "[FlatPair]") {
+    std::vector<Key> keys;
+
+    for (std::uint16_t i = 0; i < 4; ++i) {
+        for (std::uint8_t j = 0; j < 4; ++j) {
+            keys.push_back(make_key(static_cast<std::uint16_t>(i % 2),
+                                    7u - i, j, 3u - j));
+        }
+    }
+
+    std::vector<FlatKey> flat_keys(keys.begin(), keys.end());
+
+    std::sort(keys.begin(), keys.end());
+    std::sort(flat_keys.begin(), flat_keys.end());
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(static_cast<Key>(flat_keys[i]) == keys[i]);
+    }
+
+    REQUIRE(flat_keys[0] == flat_keys[0]);
+    REQUIRE(flat_keys[0] != flat_keys[1]);
+    REQUIRE(flat_keys[0] < flat_keys[1]);
+    REQUIRE(flat_keys[1] > flat_keys[0]);
+    REQUIRE(flat_keys[0] <= flat_keys[0]);
+    REQUIRE(flat_keys[1] >= flat_keys[0]);
+
+    SECTION("swap") {
+        using std::swap;
+
+        swap(flat_keys[0], flat_keys[1]);
+
+        REQUIRE(static_cast<Key>(flat_keys[0]) == keys[1]);
+        REQUIRE(static_cast<Key>(flat_keys[1]) == keys[0]);
+    }
+}
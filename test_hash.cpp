@@ -0,0 +1,202 @@
+#include "hash.hpp"
+#include "pair.hpp"
+#include "span.hpp"
+
+#include "catch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+struct Unhashable { };
+
+enum class Kind : std::uint16_t {
+    Leaf,
+    Branch
+};
+
+static_assert(std::is_default_constructible_v<
+    std::hash<gregjm::Pair<int, std::string>>
+>);
+static_assert(!std::is_default_constructible_v<
+    std::hash<gregjm::Pair<int, Unhashable>>
+>);
+static_assert(noexcept(std::hash<gregjm::Pair<int, long>>{ }(
+    std::declval<const gregjm::Pair<int, long>&>()
+)));
+
+constexpr std::uint64_t fold_by_halves(std::uint64_t lhs,
+                                       std::uint64_t rhs) noexcept {
+    const std::uint64_t lhs_low = lhs & 0xffffffff;
+    const std::uint64_t lhs_high = lhs >> 32;
+    const std::uint64_t rhs_low = rhs & 0xffffffff;
+    const std::uint64_t rhs_high = rhs >> 32;
+
+    const std::uint64_t low_low = lhs_low * rhs_low;
+    const std::uint64_t middle = lhs_high * rhs_low + (low_low >> 32);
+    const std::uint64_t other_middle = lhs_low * rhs_high
+                                       + (middle & 0xffffffff);
+
+    return ((other_middle << 32) | (low_low & 0xffffffff))
+           ^ (lhs_high * rhs_high + (middle >> 32) + (other_middle >> 32));
+}
+
+static_assert(gregjm::detail::multiply_fold(~0ull, ~0ull)
+              == fold_by_halves(~0ull, ~0ull));
+static_assert(gregjm::detail::multiply_fold(0x123456789abcdef0,
+                                            0xfedcba9876543210)
+              == fold_by_halves(0x123456789abcdef0, 0xfedcba9876543210));
+
+template <typename P>
+void require_batch_matches(const std::vector<P> &pairs) {
+    const std::hash<P> hasher;
+
+    for (std::size_t size = 0; size <= pairs.size(); ++size) {
+        std::vector<std::size_t> hashes(size + 1, 0);
+
+        gregjm::hash_batch(gregjm::Span<const P>{ pairs.data(), size },
+                           gregjm::Span<std::size_t>{ hashes });
+
+        for (std::size_t i = 0; i < size; ++i) {
+            REQUIRE(hashes[i] == hasher(pairs[i]));
+        }
+
+        REQUIRE(hashes[size] == 0);
+    }
+}
+
+} // namespace
+
+TEST_CASE("std::hash works with Pair", "[Pair][hash]") {
+    SECTION("unordered containers") {
+        std::unordered_map<gregjm::Pair<std::string, int>, int> map;
+
+        map[{ "a", 1 }] = 1;
+        map[{ "b", 1 }] = 2;
+        map[{ "a", 2 }] = 3;
+
+        REQUIRE(map.size() == 3);
+        REQUIRE((map[{ "a", 1 }]) == 1);
+        REQUIRE((map[{ "a", 2 }]) == 3);
+    }
+
+    SECTION("member hashes are combined") {
+        using PairT = gregjm::Pair<std::string, Kind>;
+        const std::hash<PairT> hasher;
+
+        REQUIRE(hasher(PairT{ "x", Kind::Leaf })
+                == hasher(PairT{ "x", Kind::Leaf }));
+        REQUIRE(hasher(PairT{ "x", Kind::Leaf })
+                != hasher(PairT{ "x", Kind::Branch }));
+        REQUIRE(hasher(PairT{ "x", Kind::Leaf })
+                != hasher(PairT{ "y", Kind::Leaf }));
+    }
+
+    SECTION("pairs of references hash like pairs of values") {
+        int first = 3;
+        long second = 4;
+
+        REQUIRE(std::hash<gregjm::Pair<const int&, long&>>{ }({ first,
+                                                                second })
+                == std::hash<gregjm::Pair<int, long>>{ }({ 3, 4 }));
+    }
+}
+
+TEST_CASE("std::hash separates symmetric integer pairs", "[Pair][hash]") {
+    using PairT = gregjm::Pair<std::uint32_t, std::uint32_t>;
+
+    constexpr std::uint32_t grid_size = 256;
+
+    const std::hash<PairT> hasher;
+    std::unordered_set<std::size_t> hashes;
+    std::unordered_set<std::size_t> buckets;
+
+    for (std::uint32_t i = 0; i < grid_size; ++i) {
+        for (std::uint32_t j = 0; j < grid_size; ++j) {
+            const std::size_t hash = hasher(PairT{ i, j });
+
+            hashes.insert(hash);
+            buckets.insert(hash % 1021);
+        }
+    }
+
+    REQUIRE(hashes.size() == grid_size * grid_size);
+    REQUIRE(buckets.size() == 1021);
+    REQUIRE(hasher(PairT{ 1, 2 }) != hasher(PairT{ 2, 1 }));
+    REQUIRE(hasher(PairT{ 0, 0 }) != hasher(PairT{ 1, 1 }));
+}
+
+TEST_CASE("std::hash keeps a member equal to its seed", "[Pair][hash]") {
+    using PairT = gregjm::Pair<std::uint64_t, std::uint64_t>;
+
+    constexpr std::uint64_t seed_first = gregjm::detail::hash_seed_first;
+    constexpr std::uint64_t seed_second = gregjm::detail::hash_seed_second;
+
+    // either seed zeroes the product of the seeded members
+    const std::hash<PairT> hasher;
+    std::unordered_set<std::size_t> hashes;
+
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        hashes.insert(hasher(PairT{ seed_first, i }));
+        hashes.insert(hasher(PairT{ i, seed_second }));
+    }
+
+    REQUIRE(hashes.size() == 2000);
+    REQUIRE(hashes.count(0) == 0);
+}
+
+TEST_CASE("hash_batch matches std::hash", "[Pair][hash]") {
+    SECTION("64-bit members") {
+        std::vector<gregjm::Pair<std::uint64_t, std::int64_t>> pairs;
+
+        for (std::uint64_t i = 0; i < 11; ++i) {
+            pairs.emplace_back(i * 0x9e3779b97f4a7c15,
+                               -static_cast<std::int64_t>(i));
+        }
+
+        pairs.emplace_back(gregjm::detail::hash_seed_first, 1);
+        pairs.emplace_back(2, static_cast<std::int64_t>(
+            gregjm::detail::hash_seed_second
+        ));
+
+        require_batch_matches(pairs);
+    }
+
+    SECTION("32-bit members") {
+        std::vector<gregjm::Pair<std::uint32_t, std::uint32_t>> pairs;
+
+        for (std::uint32_t i = 0; i < 11; ++i) {
+            pairs.emplace_back(i * 2654435761u, ~i);
+        }
+
+        require_batch_matches(pairs);
+    }
+
+    SECTION("pointers") {
+        int values[9]{ };
+        std::vector<gregjm::Pair<int*, std::uint64_t>> pairs;
+
+        for (std::uint64_t i = 0; i < 9; ++i) {
+            pairs.emplace_back(&values[i], i);
+        }
+
+        require_batch_matches(pairs);
+    }
+
+    SECTION("members without a vector path") {
+        std::vector<gregjm::Pair<std::string, std::int32_t>> pairs;
+
+        for (std::int32_t i = 0; i < 6; ++i) {
+            pairs.emplace_back(std::to_string(i), -i);
+        }
+
+        require_batch_matches(pairs);
+    }
+}
@@ -0,0 +1,481 @@
+#include "pair.hpp"
+#include "tuple.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+// built twice: once as C++17 with the inheritance backend and once as C++20
+// with the [[no_unique_address]] backend
+
+namespace {
+
+struct Empty { };
+
+struct OtherEmpty { };
+
+struct FinalEmpty final { };
+
+struct Padded {
+    int i;
+    char c;
+};
+
+struct FinalPadded final {
+    int i;
+    char c;
+};
+
+struct Polymorphic {
+    virtual ~Polymorphic() = default;
+
+    int i;
+};
+
+struct SharedBase {
+    int i;
+};
+
+struct LeftDerived : SharedBase { };
+
+struct RightDerived : SharedBase { };
+
+struct ForcedMember { };
+
+struct ForcedBase {
+    virtual ~ForcedBase() = default;
+};
+
+#if GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS
+struct Tagged {
+    using tag = char;
+};
+
+using tag = long;
+
+// unqualified lookup in a class searches its bases, so with the inheritance
+// backend this finds Tagged::tag through Pair's private base and does not
+// compile; with data members it finds the tag declared above
+struct LookupProbe : gregjm::Pair<Tagged, int> {
+    static constexpr inline std::size_t tag_size = sizeof(tag);
+};
+#endif
+
+} // namespace
+
+template <>
+struct gregjm::storage_policy<ForcedMember>
+: std::integral_constant<gregjm::StorageKind, gregjm::StorageKind::Member> { };
+
+template <>
+struct gregjm::storage_policy<ForcedBase>
+: std::integral_constant<gregjm::StorageKind, gregjm::StorageKind::Base> { };
+
+template <>
+struct gregjm::reorder_tuple_members<char, double, char, int>
+: std::true_type { };
+
+template <>
+struct gregjm::reorder_tuple_members<Empty, char, std::uint64_t, Empty,
+                                     std::uint16_t>
+: std::true_type { };
+
+namespace {
+
+template <typename First, typename Second>
+struct Naive {
+    First first;
+    Second second;
+};
+
+template <typename T>
+constexpr std::size_t storage_size = std::is_empty_v<T> ? 0 : sizeof(T);
+
+template <typename First, typename Second>
+constexpr std::size_t ideal_size =
+    std::max(storage_size<First> + storage_size<Second>, std::size_t{ 1 });
+
+template <typename P>
+std::ptrdiff_t offset_of_first(const P &pair) noexcept {
+    return reinterpret_cast<const char*>(std::addressof(pair.first()))
+           - reinterpret_cast<const char*>(std::addressof(pair));
+}
+
+template <typename P>
+std::ptrdiff_t offset_of_second(const P &pair) noexcept {
+    return reinterpret_cast<const char*>(std::addressof(pair.second()))
+           - reinterpret_cast<const char*>(std::addressof(pair));
+}
+
+// non-empty members are stored like the members of a plain struct, in
+// order. offsetof needs a standard-layout struct, and then neither member
+// has tail padding that a later one could reuse
+template <typename First, typename Second>
+void require_member_layout() {
+    if constexpr (!std::is_empty_v<First> && !std::is_empty_v<Second>) {
+        using NaiveT = Naive<First, Second>;
+
+        const gregjm::Pair<First, Second> pair{ };
+
+        INFO("offsets " << offset_of_first(pair) << " and "
+             << offset_of_second(pair));
+
+        REQUIRE(offset_of_first(pair) == 0);
+
+        if constexpr (std::is_standard_layout_v<NaiveT>) {
+            REQUIRE(sizeof(gregjm::Pair<First, Second>) == sizeof(NaiveT));
+            REQUIRE(offset_of_second(pair)
+                    == static_cast<std::ptrdiff_t>(
+                           offsetof(NaiveT, second)
+                       ));
+        } else {
+            REQUIRE(offset_of_second(pair) > 0);
+            REQUIRE(offset_of_second(pair)
+                    % static_cast<std::ptrdiff_t>(alignof(Second)) == 0);
+        }
+    }
+}
+
+template <typename First, typename ...Seconds>
+void require_member_layout_row() {
+    (require_member_layout<First, Seconds>(), ...);
+}
+
+template <typename First, typename Second>
+void require_parity_or_better() {
+    INFO("sizeof(Pair) = " << sizeof(gregjm::Pair<First, Second>)
+         << ", sizeof(Naive) = " << sizeof(Naive<First, Second>));
+
+    REQUIRE(sizeof(gregjm::Pair<First, Second>)
+            <= sizeof(Naive<First, Second>));
+    REQUIRE(sizeof(gregjm::Tuple<First, Second>)
+            <= sizeof(Naive<First, Second>));
+}
+
+template <typename First, typename ...Seconds>
+void require_row() {
+    (require_parity_or_better<First, Seconds>(), ...);
+}
+
+template <typename ...Ts>
+void require_matrix() {
+    (require_row<Ts, Ts...>(), ...);
+}
+
+// Pair declares converting constructors and assignment templates, none of
+// which may cost it the triviality of its members
+template <typename First, typename Second>
+constexpr bool is_trivial_pair() noexcept {
+    using PairT = gregjm::Pair<First, Second>;
+
+    static_assert(std::is_trivially_copyable_v<PairT>);
+    static_assert(std::is_trivially_default_constructible_v<PairT>);
+    static_assert(std::is_trivially_copy_constructible_v<PairT>);
+    static_assert(std::is_trivially_move_constructible_v<PairT>);
+    static_assert(std::is_trivially_copy_assignable_v<PairT>);
+    static_assert(std::is_trivially_move_assignable_v<PairT>);
+    static_assert(std::is_trivially_destructible_v<PairT>);
+    static_assert(gregjm::is_trivially_relocatable_v<PairT>);
+
+    static_assert(std::is_trivially_copyable_v<gregjm::Tuple<First, Second>>);
+
+    return true;
+}
+
+template <typename First, typename ...Seconds>
+constexpr bool is_trivial_row() noexcept {
+    return (is_trivial_pair<First, Seconds>() && ...);
+}
+
+template <typename ...Ts>
+constexpr bool is_trivial_matrix() noexcept {
+    return (is_trivial_row<Ts, Ts...>() && ...);
+}
+
+static_assert(is_trivial_matrix<Empty, OtherEmpty, FinalEmpty, Padded,
+                                FinalPadded, char, int, double, int*,
+                                std::less<>>());
+
+static_assert(is_trivial_pair<gregjm::Pair<int, Empty>, double>());
+
+static_assert(!std::is_polymorphic_v<gregjm::Pair<Polymorphic, int>>);
+static_assert(!std::is_polymorphic_v<gregjm::Tuple<int, Polymorphic>>);
+static_assert(std::is_polymorphic_v<gregjm::Pair<ForcedBase, int>>);
+static_assert(!std::is_convertible_v<gregjm::Pair<Padded, int>*, Padded*>);
+
+#if GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS
+static_assert(gregjm::storage_policy_v<Empty>
+              == gregjm::StorageKind::CompressedMember);
+#else
+static_assert(gregjm::storage_policy_v<Empty> == gregjm::StorageKind::Base);
+static_assert(gregjm::storage_policy_v<FinalEmpty>
+              == gregjm::StorageKind::Member);
+static_assert(gregjm::storage_policy_v<Padded>
+              == gregjm::StorageKind::Member);
+static_assert(gregjm::storage_policy_v<Polymorphic>
+              == gregjm::StorageKind::Member);
+#endif
+
+// checks the modeled layout of a Tuple against the addresses of its elements
+template <typename ...Ts, std::size_t ...Is>
+void require_modeled_layout(const gregjm::Tuple<Ts...> &tuple,
+                            std::index_sequence<Is...>) {
+    using LayoutT = gregjm::tuple_layout<gregjm::Tuple<Ts...>>;
+
+    const auto *const base = reinterpret_cast<const unsigned char*>(&tuple);
+    const std::size_t offsets[] = {
+        static_cast<std::size_t>(
+            reinterpret_cast<const unsigned char*>(&tuple.template get<Is>())
+            - base
+        )...
+    };
+    const bool empty[] = { std::is_empty_v<Ts>... };
+
+    REQUIRE(LayoutT::current.size == sizeof(tuple));
+
+    for (const gregjm::ElementLayout &element : LayoutT::current.elements) {
+        if (!empty[element.index]) {
+            REQUIRE(offsets[element.index] == element.offset);
+        }
+    }
+}
+
+template <typename ...Ts>
+void require_modeled_layout() {
+    const gregjm::Tuple<Ts...> tuple{ };
+
+    require_modeled_layout(tuple, std::index_sequence_for<Ts...>{ });
+}
+
+} // namespace
+
+TEST_CASE("Pair is never larger than a plain struct", "[Pair][layout]") {
+    require_matrix<Empty, OtherEmpty, FinalEmpty, Padded, FinalPadded, char,
+                   int, double, std::less<>, std::allocator<int>>();
+}
+
+TEST_CASE("Pair stores non-empty members as data members", "[Pair][layout]") {
+    SECTION("type matrix") {
+        require_member_layout_row<Padded, Padded, FinalPadded, char, int,
+                                  double, Polymorphic, LeftDerived>();
+        require_member_layout_row<char, Padded, FinalPadded, char, int,
+                                  double, Polymorphic, LeftDerived>();
+        require_member_layout_row<double, Padded, FinalPadded, char, int,
+                                  double, Polymorphic, LeftDerived>();
+        require_member_layout_row<Polymorphic, Padded, char, double,
+                                  Polymorphic>();
+        require_member_layout_row<LeftDerived, RightDerived, int>();
+    }
+
+    SECTION("polymorphic members") {
+        REQUIRE(sizeof(gregjm::Pair<Polymorphic, int>)
+                <= sizeof(Naive<Polymorphic, int>));
+
+        gregjm::Pair<Polymorphic, Polymorphic> pair;
+        pair.second().i = 3;
+
+        REQUIRE(pair.second().i == 3);
+        REQUIRE(&pair.first() != &pair.second());
+    }
+
+    SECTION("members that share a base class") {
+        gregjm::Pair<LeftDerived, RightDerived> pair;
+        pair.first().i = 1;
+        pair.second().i = 2;
+
+        REQUIRE(pair.first().i == 1);
+        REQUIRE(pair.second().i == 2);
+        REQUIRE(sizeof(pair) == 2 * sizeof(int));
+    }
+
+    SECTION("Pairs nested in Pairs") {
+        using Inner = gregjm::Pair<std::uint64_t, std::uint64_t>;
+
+        const gregjm::Pair<std::uint64_t, Inner> pair{ 1, Inner{ 2, 3 } };
+
+        REQUIRE(pair.first() == 1);
+        REQUIRE(pair.second().first() == 2);
+        REQUIRE(offset_of_second(pair) == sizeof(std::uint64_t));
+    }
+}
+
+TEST_CASE("storage_policy overrides the storage kind", "[Pair][layout]") {
+    SECTION("forced members are never compressed") {
+        REQUIRE(sizeof(gregjm::Pair<ForcedMember, int>)
+                == sizeof(Naive<ForcedMember, int>));
+        REQUIRE(sizeof(gregjm::Pair<int, ForcedMember>)
+                == sizeof(Naive<int, ForcedMember>));
+    }
+
+    SECTION("forced bases are inherited") {
+        REQUIRE(sizeof(gregjm::Pair<ForcedBase, int>)
+                <= sizeof(Naive<ForcedBase, int>));
+
+        const gregjm::Pair<ForcedBase, int> pair{ ForcedBase{ }, 4 };
+
+        REQUIRE(offset_of_first(pair) == 0);
+        REQUIRE(pair.second() == 4);
+    }
+}
+
+TEST_CASE("Pair compresses empty members", "[Pair][layout]") {
+    SECTION("non-final empty types") {
+        REQUIRE(sizeof(gregjm::Pair<Empty, int>) == sizeof(int));
+        REQUIRE(sizeof(gregjm::Pair<int, Empty>) == sizeof(int));
+        REQUIRE(sizeof(gregjm::Pair<Empty, OtherEmpty>) == 1);
+        REQUIRE(sizeof(gregjm::Pair<std::allocator<int>, int*>)
+                == sizeof(int*));
+        REQUIRE(sizeof(gregjm::Tuple<Empty, OtherEmpty, std::less<>, int>)
+                == sizeof(int));
+    }
+
+#if GREGJM_PAIR_USE_NO_UNIQUE_ADDRESS
+    SECTION("final empty types") {
+        REQUIRE(sizeof(gregjm::Pair<FinalEmpty, int>) == sizeof(int));
+        REQUIRE(sizeof(gregjm::Pair<int, FinalEmpty>) == sizeof(int));
+        REQUIRE(sizeof(gregjm::Tuple<FinalEmpty, Empty, int>)
+                == sizeof(int));
+    }
+
+    SECTION("members do not leak into name lookup") {
+        REQUIRE(LookupProbe::tag_size == sizeof(long));
+        REQUIRE_FALSE(std::is_base_of_v<Tagged, gregjm::Pair<Tagged, int>>);
+    }
+#else
+    SECTION("final empty types take storage") {
+        REQUIRE(sizeof(gregjm::Pair<FinalEmpty, int>)
+                == sizeof(Naive<FinalEmpty, int>));
+    }
+
+    SECTION("empty members are private bases") {
+        REQUIRE(std::is_base_of_v<Empty, gregjm::Pair<Empty, int>>);
+        REQUIRE_FALSE(std::is_convertible_v<gregjm::Pair<Empty, int>*,
+                                            Empty*>);
+    }
+#endif
+
+    SECTION("ideal sizes") {
+        REQUIRE(sizeof(gregjm::Pair<Empty, double>)
+                == ideal_size<Empty, double>);
+        REQUIRE(sizeof(gregjm::Pair<int, int>) == ideal_size<int, int>);
+    }
+}
+
+TEST_CASE("Empty members of the same type share storage", "[Pair][layout]") {
+    SECTION("Pair") {
+        REQUIRE(sizeof(gregjm::Pair<Empty, Empty>) == 1);
+        REQUIRE(std::is_empty_v<gregjm::Pair<Empty, Empty>>);
+        REQUIRE(sizeof(gregjm::Pair<std::less<>, std::less<>>) == 1);
+        REQUIRE(sizeof(gregjm::Pair<gregjm::Pair<Empty, Empty>, int>)
+                == sizeof(int));
+
+        gregjm::Pair<Empty, Empty> pair;
+        const auto &const_pair = pair;
+
+        REQUIRE(&pair.first() == &pair.second());
+        REQUIRE(&const_pair.first() == &const_pair.second());
+
+        gregjm::Pair<Empty, Empty> other;
+        pair = other;
+        swap(pair, other);
+    }
+
+    SECTION("Tuple") {
+        REQUIRE(sizeof(gregjm::Tuple<Empty, Empty, int>) == sizeof(int));
+        REQUIRE(sizeof(gregjm::Tuple<Empty, int, Empty, Empty>)
+                == sizeof(int));
+
+        gregjm::Tuple<Empty, int, Empty> tuple{ Empty{ }, 5, Empty{ } };
+
+        REQUIRE(&tuple.get<0>() == &tuple.get<2>());
+        REQUIRE(gregjm::get<1>(tuple) == 5);
+    }
+
+    SECTION("non-empty members of the same type are distinct") {
+        gregjm::Pair<int, int> pair{ 1, 2 };
+
+        REQUIRE(&pair.first() != &pair.second());
+        REQUIRE(pair.second() == 2);
+    }
+}
+
+TEST_CASE("Both backends give the same behavior", "[Pair][layout]") {
+    gregjm::Pair<FinalEmpty, int> pair{ FinalEmpty{ }, 5 };
+
+    REQUIRE(pair.second() == 5);
+    REQUIRE(std::is_same_v<decltype(pair.first()), FinalEmpty&>);
+
+    gregjm::Pair<std::less<>, int> less{ std::less<>{ }, 0 };
+
+    REQUIRE(less.first()(1, 2));
+    REQUIRE(std::is_empty_v<gregjm::Pair<Empty, OtherEmpty>>);
+}
+
+TEST_CASE("Tuple can be laid out by alignment", "[Tuple][layout]") {
+    using TupleT = gregjm::Tuple<char, double, char, int>;
+    using LayoutT = gregjm::tuple_layout<TupleT>;
+
+    static_assert(LayoutT::is_reordered);
+    static_assert(LayoutT::declared.size == 24);
+    static_assert(LayoutT::reordered.size == 16);
+    static_assert(LayoutT::reordered.elements[0].index == 1);
+    static_assert(LayoutT::reordered.elements[1].index == 3);
+
+    REQUIRE(sizeof(TupleT) == 16);
+    REQUIRE(sizeof(gregjm::Tuple<char, double, int, char>) == 24);
+    REQUIRE(sizeof(gregjm::Tuple<Empty, char, std::uint64_t, Empty,
+                                 std::uint16_t>) == 16);
+
+    SECTION("the model matches the real layout") {
+        require_modeled_layout<char, double, char, int>();
+        require_modeled_layout<char, double, int, char>();
+        require_modeled_layout<Empty, char, std::uint64_t, Empty,
+                               std::uint16_t>();
+        require_modeled_layout<Empty, OtherEmpty, int>();
+        require_modeled_layout<Padded, char, double>();
+    }
+
+    SECTION("elements keep their declared order") {
+        TupleT tuple{ 'a', 2.5, 'b', 4 };
+
+        REQUIRE(tuple.get<0>() == 'a');
+        REQUIRE(tuple.get<1>() == 2.5);
+        REQUIRE(tuple.get<2>() == 'b');
+        REQUIRE(tuple.get<3>() == 4);
+
+        REQUIRE(tuple < TupleT{ 'b', 0.0, 'a', 0 });
+        REQUIRE(TupleT{ 'a', 2.5, 'a', 9 } < tuple);
+
+        TupleT other{ 'z', 0.0, 'z', 0 };
+        tuple.swap(other);
+
+        REQUIRE(other == TupleT{ 'a', 2.5, 'b', 4 });
+        REQUIRE(tuple.get<0>() == 'z');
+    }
+
+    SECTION("the report shows both layouts") {
+        std::ostringstream oss;
+        gregjm::layout_report<TupleT>(oss);
+
+        REQUIRE(oss.str()
+                == "sizeof: 16\n"
+                   "declared order: 24 bytes\n"
+                   "  [0] offset 0, size 1\n"
+                   "  [1] offset 8, size 8, 7 bytes of padding before\n"
+                   "  [2] offset 16, size 1\n"
+                   "  [3] offset 20, size 4, 3 bytes of padding before\n"
+                   "by alignment: 16 bytes (current)\n"
+                   "  [1] offset 0, size 8\n"
+                   "  [3] offset 8, size 4\n"
+                   "  [0] offset 12, size 1\n"
+                   "  [2] offset 13, size 1\n"
+                   "  2 bytes of tail padding\n");
+    }
+}
@@ -0,0 +1,164 @@
+#include "packed_pair.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Index = gregjm::PackedPair<std::uint32_t, 20, std::uint32_t, 12>;
+
+enum class Color : std::uint8_t {
+    Red,
+    Green,
+    Blue
+};
+
+using Signed = gregjm::PackedPair<int, 5, std::int8_t, 3>;
+
+static_assert(sizeof(Index) == sizeof(std::uint32_t));
+static_assert(sizeof(gregjm::PackedPair<Color, 2, bool, 1>) == 1);
+static_assert(sizeof(gregjm::PackedPair<std::uint16_t, 9, std::uint8_t, 7>)
+              == 2);
+static_assert(sizeof(gregjm::PackedPair<std::uint64_t, 40, std::uint32_t, 24>)
+              == 8);
+static_assert(std::is_trivially_copyable_v<Index>);
+static_assert(gregjm::is_trivially_relocatable_v<Index>);
+static_assert(Index::is_word_ordered);
+static_assert(!Signed::is_word_ordered);
+
+static_assert(Index{ 0xabcde, 0xf12 }.word() == 0xabcdef12);
+static_assert(Index::from_word(0xabcdef12).first() == 0xabcde);
+static_assert(Index::from_word(0xabcdef12).second() == 0xf12);
+static_assert(Index::decode(Index::encode(7, 9)).second() == 9);
+static_assert(Index::fits(0xfffff, 0xfff));
+static_assert(!Index::fits(0x100000, 0));
+static_assert(!Index::fits(0, 0x1000));
+static_assert(Signed::fits(-16, -4));
+static_assert(!Signed::fits(16, 0));
+static_assert(!Signed::fits(0, -5));
+static_assert(Index{ 1, 0 } > Index{ 0, 0xfff });
+
+constexpr Index modified() noexcept {
+    Index index{ 1, 2 };
+    index.first() = 3;
+    index.second() = index.first();
+
+    return index;
+}
+
+static_assert(modified() == Index{ 3, 3 });
+
+} // namespace
+
+TEST_CASE("PackedPair stores both members in one word", "[PackedPair]") {
+    SECTION("unsigned") {
+        Index index{ 0xfffff, 0 };
+
+        REQUIRE(index.first() == 0xfffff);
+        REQUIRE(index.second() == 0);
+
+        index.second() = 0xfff;
+
+        REQUIRE(index.first() == 0xfffff);
+        REQUIRE(index.second() == 0xfff);
+
+        index.first() = 5;
+
+        REQUIRE(index.first() == 5);
+        REQUIRE(index.second() == 0xfff);
+        REQUIRE(index.word() == ((5u << 12) | 0xfff));
+    }
+
+    SECTION("signed") {
+        Signed pair{ -16, -4 };
+
+        REQUIRE(pair.first() == -16);
+        REQUIRE(pair.second() == -4);
+
+        pair.first() = 15;
+        pair.second() = 3;
+
+        REQUIRE(pair.first() == 15);
+        REQUIRE(pair.second() == 3);
+    }
+
+    SECTION("enums and bools") {
+        gregjm::PackedPair<Color, 2, bool, 1> pair{ Color::Blue, true };
+
+        REQUIRE(pair.first() == Color::Blue);
+        REQUIRE(pair.second());
+
+        pair.second() = false;
+
+        REQUIRE(pair.first() == Color::Blue);
+        REQUIRE_FALSE(pair.second());
+    }
+
+    SECTION("proxies") {
+        Index index{ 1, 2 };
+        Index other{ 3, 4 };
+
+        index.first() = other.second();
+
+        REQUIRE(index == Index{ 4, 2 });
+
+        const std::uint32_t first = index.first();
+        REQUIRE(first == 4);
+        REQUIRE(std::is_same_v<decltype(std::as_const(index).first()),
+                               std::uint32_t>);
+    }
+}
+
+TEST_CASE("PackedPair converts to and from Pair", "[PackedPair]") {
+    const gregjm::Pair<std::uint32_t, std::uint32_t> pair{ 17, 42 };
+    const Index index{ pair };
+
+    REQUIRE(static_cast<gregjm::Pair<std::uint32_t, std::uint32_t>>(index)
+            == pair);
+    REQUIRE(Index::decode(index.word()) == pair);
+
+    Index copy = index;
+    Index other{ 1, 1 };
+    swap(other, copy);
+
+    REQUIRE(other == index);
+    REQUIRE(copy == Index{ 1, 1 });
+}
+
+TEST_CASE("PackedPair orders like Pair", "[PackedPair]") {
+    SECTION("unsigned members compare as words") {
+        std::vector<Index> packed;
+        std::vector<gregjm::Pair<std::uint32_t, std::uint32_t>> pairs;
+
+        for (std::uint32_t i = 0; i < 64; ++i) {
+            const std::uint32_t first = (i * 2654435761u) % 97;
+            const std::uint32_t second = (i * 40503u) % 4096;
+
+            packed.emplace_back(first, second);
+            pairs.emplace_back(first, second);
+        }
+
+        std::sort(packed.begin(), packed.end());
+        std::sort(pairs.begin(), pairs.end());
+
+        for (std::size_t i = 0; i < pairs.size(); ++i) {
+            REQUIRE(static_cast<gregjm::Pair<std::uint32_t, std::uint32_t>>(
+                        packed[i]
+                    ) == pairs[i]);
+        }
+    }
+
+    SECTION("signed members compare member by member") {
+        REQUIRE(Signed{ -1, 0 } < Signed{ 0, 0 });
+        REQUIRE(Signed{ 0, -1 } < Signed{ 0, 0 });
+        REQUIRE(Signed{ 0, 3 } > Signed{ 0, -4 });
+        REQUIRE(Signed{ 2, 2 } <= Signed{ 2, 2 });
+        REQUIRE(Signed{ 2, 2 } >= Signed{ 2, 2 });
+        REQUIRE(Signed{ 2, 2 } != Signed{ 2, 1 });
+    }
+}
@@ -2,6 +2,7 @@
 
 #include "catch.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <set>
 #include <string>
@@ -180,6 +181,40 @@ TEST_CASE("Pair objects support all sorts of strange types", "[Pair]") {
         REQUIRE(&pair.second() == &d);
     }
 
+    SECTION("reference type assignment") {
+        int i = 15;
+        double d = 3.0;
+        int j = 20;
+        double e = 6.0;
+
+        gregjm::Pair<int&, double&> lhs{ i, d };
+        const gregjm::Pair<int&, double&> rhs{ j, e };
+
+        lhs = rhs;
+
+        REQUIRE(&lhs.first() == &i);
+        REQUIRE(i == 20);
+        REQUIRE(d == 6.0);
+
+        lhs = gregjm::Pair<int, double>{ 1, 2.0 };
+
+        REQUIRE(i == 1);
+        REQUIRE(d == 2.0);
+
+        swap(gregjm::Pair<int&, double&>{ i, d },
+             gregjm::Pair<int&, double&>{ j, e });
+
+        REQUIRE(i == 20);
+        REQUIRE(j == 1);
+
+        const gregjm::Pair<int, double> copy = lhs;
+
+        REQUIRE(copy.first() == 20);
+        REQUIRE_FALSE(std::is_copy_assignable_v<
+            gregjm::Pair<const int&, const double&>
+        >);
+    }
+
     SECTION("pointer type") {
         int i = 15;
         double d = 3.0;
@@ -390,3 +425,333 @@ TEST_CASE("Type traits carry through to Pair", "[Pair]") {
         >);
     }
 }
+
+TEST_CASE("Pair objects implement the tuple protocol", "[Pair]") {
+    SECTION("tuple_size and tuple_element") {
+        using PairT = gregjm::Pair<int, std::string>;
+
+        REQUIRE(std::tuple_size_v<PairT> == 2);
+        REQUIRE(std::is_same_v<std::tuple_element_t<0, PairT>, int>);
+        REQUIRE(std::is_same_v<std::tuple_element_t<1, PairT>, std::string>);
+    }
+
+    SECTION("structured bindings alias the members") {
+        gregjm::Pair<int, std::string> pair{ 5, "foo" };
+
+        auto &[key, value] = pair;
+
+        REQUIRE(&key == &pair.first());
+        REQUIRE(&value == &pair.second());
+
+        key = 10;
+        value = "bar";
+
+        REQUIRE(pair.first() == 10);
+        REQUIRE(pair.second() == "bar");
+
+        const auto &[const_key, const_value] = pair;
+
+        REQUIRE(&const_key == &pair.first());
+        REQUIRE(&const_value == &pair.second());
+    }
+
+    SECTION("get by index") {
+        gregjm::Pair<int, std::string> pair{ 5, "foo" };
+        const auto &const_pair = pair;
+
+        REQUIRE(&gregjm::get<0>(pair) == &pair.first());
+        REQUIRE(&gregjm::get<1>(const_pair) == &pair.second());
+
+        REQUIRE(std::is_same_v<decltype(gregjm::get<0>(pair)), int&>);
+        REQUIRE(std::is_same_v<decltype(gregjm::get<1>(const_pair)),
+                               const std::string&>);
+        REQUIRE(std::is_same_v<decltype(gregjm::get<1>(std::move(pair))),
+                               std::string&&>);
+
+        const std::string moved = gregjm::get<1>(std::move(pair));
+
+        REQUIRE(moved == "foo");
+    }
+
+    SECTION("get by type") {
+        gregjm::Pair<int, double> pair{ 5, 3.0 };
+
+        REQUIRE(&gregjm::get<int>(pair) == &pair.first());
+        REQUIRE(&gregjm::get<double>(pair) == &pair.second());
+    }
+
+    SECTION("reference members") {
+        int i = 15;
+        double d = 3.0;
+
+        gregjm::Pair<int&, double&> pair{ i, d };
+
+        auto [first, second] = pair;
+
+        REQUIRE(&first == &i);
+        REQUIRE(&second == &d);
+        REQUIRE(std::is_same_v<decltype(gregjm::get<0>(std::move(pair))),
+                               int&>);
+    }
+
+    SECTION("apply") {
+        const gregjm::Pair<int, std::string> pair{ 3, "foo" };
+
+        const auto repeated = gregjm::apply(
+            [](int count, const std::string &str) {
+                std::string result;
+
+                for (int i = 0; i < count; ++i) {
+                    result += str;
+                }
+
+                return result;
+            }, pair
+        );
+
+        REQUIRE(repeated == "foofoofoo");
+
+        gregjm::Pair<int, double> mutable_pair{ 1, 2.0 };
+
+        gregjm::apply([](int &first, double &second) {
+            first = 5;
+            second = 10.0;
+        }, mutable_pair);
+
+        REQUIRE(mutable_pair.first() == 5);
+        REQUIRE(mutable_pair.second() == 10.0);
+    }
+}
+
+namespace {
+
+struct CountingKey {
+    int value;
+    int *compares;
+    int *less_thans;
+
+    int compare(const CountingKey &other) const noexcept {
+        ++*compares;
+
+        return value - other.value;
+    }
+
+    bool operator==(const CountingKey &other) const noexcept {
+        return value == other.value;
+    }
+
+    bool operator!=(const CountingKey &other) const noexcept {
+        return value != other.value;
+    }
+
+    bool operator<(const CountingKey &other) const noexcept {
+        ++*less_thans;
+
+        return value < other.value;
+    }
+
+    bool operator<=(const CountingKey &other) const noexcept {
+        return !(other < *this);
+    }
+
+    bool operator>(const CountingKey &other) const noexcept {
+        return other < *this;
+    }
+
+    bool operator>=(const CountingKey &other) const noexcept {
+        return !(*this < other);
+    }
+
+    friend std::ostream& operator<<(std::ostream &os,
+                                    const CountingKey &key) {
+        return os << key.value;
+    }
+};
+
+// compare() here is an equality test, not a three-way comparison
+struct EqualityKey {
+    int value;
+
+    bool compare(const EqualityKey &other) const noexcept {
+        return value == other.value;
+    }
+
+    bool operator==(const EqualityKey &other) const noexcept {
+        return value == other.value;
+    }
+
+    bool operator!=(const EqualityKey &other) const noexcept {
+        return value != other.value;
+    }
+
+    bool operator<(const EqualityKey &other) const noexcept {
+        return value < other.value;
+    }
+
+    bool operator<=(const EqualityKey &other) const noexcept {
+        return value <= other.value;
+    }
+
+    bool operator>(const EqualityKey &other) const noexcept {
+        return value > other.value;
+    }
+
+    bool operator>=(const EqualityKey &other) const noexcept {
+        return value >= other.value;
+    }
+
+    friend std::ostream& operator<<(std::ostream &os, const EqualityKey &key) {
+        return os << key.value;
+    }
+};
+
+// compare() returns a difference that does not fit in an int
+struct WideKey {
+    long long value;
+
+    long long compare(const WideKey &other) const noexcept {
+        return value - other.value;
+    }
+
+    bool operator==(const WideKey &other) const noexcept {
+        return value == other.value;
+    }
+
+    bool operator!=(const WideKey &other) const noexcept {
+        return value != other.value;
+    }
+
+    bool operator<(const WideKey &other) const noexcept {
+        return value < other.value;
+    }
+
+    bool operator<=(const WideKey &other) const noexcept {
+        return value <= other.value;
+    }
+
+    bool operator>(const WideKey &other) const noexcept {
+        return value > other.value;
+    }
+
+    bool operator>=(const WideKey &other) const noexcept {
+        return value >= other.value;
+    }
+
+    friend std::ostream& operator<<(std::ostream &os, const WideKey &key) {
+        return os << key.value;
+    }
+};
+
+} // namespace
+
+TEST_CASE("Pair comparisons visit each member once", "[Pair]") {
+    SECTION("compare") {
+        using PairT = gregjm::Pair<std::string, int>;
+
+        REQUIRE(gregjm::compare(PairT{ "foo", 0 }, PairT{ "foo", 0 }) == 0);
+        REQUIRE(gregjm::compare(PairT{ "foo", 0 }, PairT{ "foo", 1 }) < 0);
+        REQUIRE(gregjm::compare(PairT{ "foo", 1 }, PairT{ "foo", 0 }) > 0);
+        REQUIRE(gregjm::compare(PairT{ "bar", 5 }, PairT{ "foo", 0 }) < 0);
+        REQUIRE(gregjm::compare(PairT{ "goo", 0 }, PairT{ "foo", 5 }) > 0);
+        REQUIRE(noexcept(gregjm::compare(
+            std::declval<const gregjm::Pair<int, double>&>(),
+            std::declval<const gregjm::Pair<int, double>&>()
+        )));
+    }
+
+    SECTION("relational operators use the three-way comparison") {
+        int compares = 0;
+        int less_thans = 0;
+
+        using PairT = gregjm::Pair<CountingKey, int>;
+
+        const PairT a{ CountingKey{ 0, &compares, &less_thans }, 1 };
+        const PairT b{ CountingKey{ 0, &compares, &less_thans }, 2 };
+        const PairT c{ CountingKey{ 1, &compares, &less_thans }, 0 };
+
+        REQUIRE(a < b);
+        REQUIRE(compares == 1);
+
+        REQUIRE(a < c);
+        REQUIRE(compares == 2);
+
+        REQUIRE(c > b);
+        REQUIRE(a <= b);
+        REQUIRE(c >= a);
+        REQUIRE(compares == 5);
+        REQUIRE(less_thans == 0);
+    }
+
+    SECTION("compare members that are not three-way comparisons") {
+        using EqualityPair = gregjm::Pair<EqualityKey, int>;
+
+        REQUIRE(EqualityPair{ EqualityKey{ 1 }, 0 }
+                < EqualityPair{ EqualityKey{ 2 }, 0 });
+        REQUIRE_FALSE(EqualityPair{ EqualityKey{ 2 }, 0 }
+                      < EqualityPair{ EqualityKey{ 1 }, 0 });
+        REQUIRE(gregjm::compare(EqualityPair{ EqualityKey{ 2 }, 0 },
+                                EqualityPair{ EqualityKey{ 1 }, 0 }) > 0);
+    }
+
+    SECTION("compare results wider than int") {
+        using WidePair = gregjm::Pair<WideKey, int>;
+
+        const WidePair low{ WideKey{ 0 }, 0 };
+        const WidePair high{ WideKey{ 1LL << 32 }, 0 };
+
+        REQUIRE(low < high);
+        REQUIRE_FALSE(high < low);
+        REQUIRE(gregjm::compare(high, low) > 0);
+    }
+
+    SECTION("sorting") {
+        std::vector<gregjm::Pair<std::string, int>> pairs;
+
+        for (int i = 0; i < 64; ++i) {
+            pairs.emplace_back(std::to_string(i % 7), 64 - i);
+        }
+
+        std::sort(pairs.begin(), pairs.end());
+
+        REQUIRE(std::is_sorted(pairs.begin(), pairs.end(),
+                               [](const auto &lhs, const auto &rhs) {
+                                   return gregjm::compare(lhs, rhs) < 0;
+                               }));
+        REQUIRE(pairs.front().first() == "0");
+        REQUIRE(pairs.front().second() == 1);
+    }
+}
+
+namespace {
+
+struct SwapToken { };
+
+struct OtherSwapToken { };
+
+int token_swaps = 0;
+
+template <typename T, typename U>
+constexpr bool is_token_pair_v =
+    std::is_same_v<std::decay_t<T>, SwapToken>
+    && std::is_same_v<std::decay_t<U>, OtherSwapToken>;
+
+// takes rvalues both ways round, as is_swappable_with requires
+template <typename T, typename U>
+std::enable_if_t<is_token_pair_v<T, U> || is_token_pair_v<U, T>>
+swap(T&&, U&&) noexcept {
+    ++token_swaps;
+}
+
+} // namespace
+
+TEST_CASE("Pair swaps an elided second once", "[Pair]") {
+    gregjm::Pair<SwapToken, SwapToken> lhs;
+    gregjm::Pair<OtherSwapToken, OtherSwapToken> rhs;
+
+    REQUIRE(sizeof(lhs) == 1);
+
+    token_swaps = 0;
+    lhs.swap(rhs);
+
+    REQUIRE(token_swaps == 1);
+}
@@ -0,0 +1,239 @@
+#include "pair_vector.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Empty {
+    constexpr bool operator==(const Empty&) const noexcept {
+        return true;
+    }
+
+    constexpr bool operator!=(const Empty&) const noexcept {
+        return false;
+    }
+
+    constexpr bool operator<(const Empty&) const noexcept {
+        return false;
+    }
+
+    constexpr bool operator<=(const Empty&) const noexcept {
+        return true;
+    }
+
+    constexpr bool operator>(const Empty&) const noexcept {
+        return false;
+    }
+
+    constexpr bool operator>=(const Empty&) const noexcept {
+        return true;
+    }
+};
+
+struct NoDefault {
+    int value;
+
+    explicit NoDefault(int x) noexcept : value{ x } { }
+};
+
+// copies throw once the countdown reaches zero
+struct ThrowingCopy {
+    static inline int copies_left = -1;
+
+    int value = 0;
+
+    ThrowingCopy() = default;
+
+    ThrowingCopy(const ThrowingCopy &other) : value{ other.value } {
+        if (copies_left == 0) {
+            throw 0;
+        }
+
+        --copies_left;
+    }
+
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+};
+
+} // namespace
+
+TEST_CASE("PairVector stores firsts and seconds separately", "[PairVector]") {
+    gregjm::PairVector<std::uint32_t, float> vec;
+
+    for (std::uint32_t i = 0; i < 16; ++i) {
+        vec.push_back({ i, static_cast<float>(i) * 0.5f });
+    }
+
+    REQUIRE(vec.size() == 16);
+    REQUIRE(vec.firsts().size() == 16);
+    REQUIRE(vec.seconds().size() == 16);
+
+    for (std::uint32_t i = 0; i < 16; ++i) {
+        REQUIRE(vec.firsts()[i] == i);
+        REQUIRE(vec.seconds()[i] == static_cast<float>(i) * 0.5f);
+        REQUIRE(&vec[i].first() == &vec.firsts()[i]);
+        REQUIRE(&vec[i].second() == &vec.seconds()[i]);
+    }
+
+    const auto sum = std::accumulate(vec.firsts().begin(),
+                                     vec.firsts().end(), std::uint32_t{ 0 });
+
+    REQUIRE(sum == 120);
+}
+
+TEST_CASE("PairVector elements are accessed through proxies",
+          "[PairVector]") {
+    gregjm::PairVector<int, std::string> vec{ { 1, "foo" }, { 2, "bar" } };
+
+    SECTION("writes go through the proxy") {
+        vec[0].first() = 5;
+        vec[1] = gregjm::Pair<int, std::string>{ 10, "baz" };
+
+        REQUIRE(vec.firsts()[0] == 5);
+        REQUIRE(vec.firsts()[1] == 10);
+        REQUIRE(vec.seconds()[1] == "baz");
+    }
+
+    SECTION("range for with structured bindings") {
+        for (auto [first, second] : vec) {
+            first *= 2;
+            second += "!";
+        }
+
+        REQUIRE(vec[0] == gregjm::Pair<int, std::string>{ 2, "foo!" });
+        REQUIRE(vec[1] == gregjm::Pair<int, std::string>{ 4, "bar!" });
+    }
+
+    SECTION("copying an element out") {
+        gregjm::Pair<int, std::string> copy = vec[1];
+
+        REQUIRE(copy.first() == 2);
+        REQUIRE(copy.second() == "bar");
+        REQUIRE(vec.seconds()[1] == "bar");
+    }
+
+    SECTION("swapping proxies swaps elements") {
+        using std::swap;
+
+        swap(vec[0], vec[1]);
+
+        REQUIRE(vec[0] == gregjm::Pair<int, std::string>{ 2, "bar" });
+        REQUIRE(vec[1] == gregjm::Pair<int, std::string>{ 1, "foo" });
+    }
+}
+
+TEST_CASE("PairVector works with standard algorithms", "[PairVector]") {
+    gregjm::PairVector<int, std::string> vec;
+    std::vector<gregjm::Pair<int, std::string>> expected;
+
+    for (int i = 0; i < 256; ++i) {
+        const int key = (i * 37) % 64;
+
+        vec.emplace_back(key, std::to_string(i));
+        expected.emplace_back(key, std::to_string(i));
+    }
+
+    SECTION("sort") {
+        std::sort(vec.begin(), vec.end());
+        std::sort(expected.begin(), expected.end());
+
+        REQUIRE(std::is_sorted(vec.begin(), vec.end()));
+        REQUIRE(std::equal(vec.begin(), vec.end(), expected.begin()));
+    }
+
+    SECTION("sort with a comparator") {
+        const auto by_first = [](const auto &lhs, const auto &rhs) {
+            return lhs.first() > rhs.first();
+        };
+
+        std::stable_sort(vec.begin(), vec.end(), by_first);
+        std::stable_sort(expected.begin(), expected.end(), by_first);
+
+        REQUIRE(std::equal(vec.begin(), vec.end(), expected.begin()));
+    }
+
+    SECTION("reverse") {
+        std::reverse(vec.begin(), vec.end());
+
+        REQUIRE(vec.front().second() == "255");
+        REQUIRE(vec.back().second() == "0");
+    }
+}
+
+TEST_CASE("PairVector does not store empty seconds", "[PairVector]") {
+    using VectorT = gregjm::PairVector<int, Empty>;
+
+    REQUIRE(sizeof(VectorT) == sizeof(std::vector<int>));
+
+    VectorT vec;
+
+    for (int i = 0; i < 8; ++i) {
+        vec.emplace_back(7 - i, Empty{ });
+    }
+
+    std::sort(vec.begin(), vec.end());
+
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(vec.firsts()[static_cast<std::size_t>(i)] == i);
+    }
+
+    REQUIRE(&vec[0].second() == &vec[7].second());
+}
+
+TEST_CASE("PairVector supports the usual vector operations",
+          "[PairVector]") {
+    gregjm::PairVector<int, double> vec(4, 1, 2.0);
+
+    REQUIRE(vec.size() == 4);
+    REQUIRE(vec[3] == gregjm::Pair<int, double>{ 1, 2.0 });
+
+    vec.resize(6);
+
+    REQUIRE(vec.size() == 6);
+    REQUIRE(vec.seconds().size() == 6);
+    REQUIRE(vec[5] == gregjm::Pair<int, double>{ 0, 0.0 });
+
+    vec.pop_back();
+
+    REQUIRE(vec.size() == 5);
+
+    gregjm::PairVector<int, double> other;
+    swap(vec, other);
+
+    REQUIRE(vec.empty());
+    REQUIRE(other.size() == 5);
+    REQUIRE(other != vec);
+
+    other.clear();
+
+    REQUIRE(other == vec);
+
+    const gregjm::PairVector<int, double> &const_vec = other;
+    REQUIRE(const_vec.begin() == const_vec.end());
+    REQUIRE(std::is_same_v<decltype(*const_vec.begin()),
+                           gregjm::Pair<const int&, const double&>>);
+}
+
+TEST_CASE("PairVector resize does not need a default-constructible first",
+          "[PairVector]") {
+    gregjm::PairVector<NoDefault, ThrowingCopy> vec(2, NoDefault{ 1 },
+                                                    ThrowingCopy{ });
+
+    REQUIRE(vec.size() == 2);
+
+    ThrowingCopy::copies_left = 1;
+    REQUIRE_THROWS(vec.resize(8, NoDefault{ 2 }, ThrowingCopy{ }));
+    ThrowingCopy::copies_left = -1;
+
+    REQUIRE(vec.size() == 2);
+    REQUIRE(vec.seconds().size() == 2);
+    REQUIRE(vec[1].first().value == 1);
+}
@@ -0,0 +1,147 @@
+#include "parallel_sort.hpp"
+#include "pair.hpp"
+#include "thread_pool.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using StringPair = gregjm::Pair<std::string, std::uint64_t>;
+
+std::uint64_t next_random(std::uint64_t &state) noexcept {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+// short strings from a small alphabet, so that many compare equal
+std::vector<StringPair> random_pairs(std::size_t size) {
+    std::uint64_t state = 0x9e3779b97f4a7c15;
+    std::vector<StringPair> pairs;
+    pairs.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        const std::uint64_t bits = next_random(state);
+        std::string key(bits % 3 + 1, 'a');
+
+        for (std::size_t j = 0; j < key.size(); ++j) {
+            key[j] = static_cast<char>('a' + ((bits >> (8 * j + 8)) % 4));
+        }
+
+        pairs.emplace_back(std::move(key), i);
+    }
+
+    return pairs;
+}
+
+bool first_less(const StringPair &lhs, const StringPair &rhs) {
+    return lhs.first() < rhs.first();
+}
+
+} // namespace
+
+TEST_CASE("parallel_sort sorts like std::sort", "[parallel_sort]") {
+    const std::vector<StringPair> input = random_pairs(50000);
+
+    std::vector<StringPair> expected = input;
+    std::sort(expected.begin(), expected.end());
+
+    for (const std::size_t num_threads : { 1, 2, 3, 8 }) {
+        gregjm::ThreadPool pool{ num_threads };
+        std::vector<StringPair> pairs = input;
+
+        gregjm::parallel_sort(pool, pairs.begin(), pairs.end());
+
+        REQUIRE(pairs == expected);
+    }
+
+    SECTION("small ranges") {
+        for (const std::size_t size : { 0, 1, 2, 100 }) {
+            std::vector<StringPair> pairs = random_pairs(size);
+            std::vector<StringPair> small_expected = pairs;
+            std::sort(small_expected.begin(), small_expected.end());
+
+            gregjm::parallel_sort(gregjm::parallel_t{ 2 }, pairs.begin(),
+                                  pairs.end());
+
+            REQUIRE(pairs == small_expected);
+        }
+    }
+
+    SECTION("custom comparison") {
+        std::vector<int> values(40000);
+
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] = static_cast<int>((i * 7919) % values.size());
+        }
+
+        gregjm::parallel_sort(gregjm::parallel_t{ 4 }, values.begin(),
+                              values.end(), std::greater<>{ });
+
+        REQUIRE(std::is_sorted(values.begin(), values.end(),
+                               std::greater<>{ }));
+    }
+}
+
+TEST_CASE("parallel_sort is stable and deterministic", "[parallel_sort]") {
+    const std::vector<StringPair> input = random_pairs(30000);
+
+    std::vector<StringPair> expected = input;
+    std::stable_sort(expected.begin(), expected.end(), first_less);
+
+    for (const std::size_t num_threads : { 1, 4, 7 }) {
+        std::vector<StringPair> pairs = input;
+
+        gregjm::parallel_sort(gregjm::parallel_t{ num_threads },
+                              pairs.begin(), pairs.end(), first_less);
+
+        REQUIRE(pairs == expected);
+    }
+}
+
+TEST_CASE("parallel_merge merges like std::merge", "[parallel_sort]") {
+    std::vector<StringPair> lhs = random_pairs(40000);
+    std::vector<StringPair> rhs = random_pairs(25000);
+
+    for (auto &pair : rhs) {
+        pair.second() += lhs.size();
+    }
+
+    std::stable_sort(lhs.begin(), lhs.end(), first_less);
+    std::stable_sort(rhs.begin(), rhs.end(), first_less);
+
+    std::vector<StringPair> expected(lhs.size() + rhs.size());
+    std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+               expected.begin(), first_less);
+
+    for (const std::size_t num_threads : { 1, 2, 5 }) {
+        gregjm::ThreadPool pool{ num_threads };
+        std::vector<StringPair> merged(lhs.size() + rhs.size());
+
+        const auto end = gregjm::parallel_merge(pool, lhs.begin(), lhs.end(),
+                                                rhs.begin(), rhs.end(),
+                                                merged.begin(), first_less);
+
+        REQUIRE(end == merged.end());
+        REQUIRE(merged == expected);
+    }
+
+    SECTION("one range empty") {
+        std::vector<StringPair> merged(lhs.size());
+
+        gregjm::parallel_merge(gregjm::parallel_t{ 3 }, lhs.begin(),
+                               lhs.end(), rhs.end(), rhs.end(),
+                               merged.begin(), first_less);
+
+        REQUIRE(merged == lhs);
+    }
+}
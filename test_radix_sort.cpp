@@ -0,0 +1,238 @@
+#include "radix_sort.hpp"
+#include "pair.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+enum class Level : std::int8_t {
+    Low = -1,
+    Middle,
+    High
+};
+
+std::ostream& operator<<(std::ostream &os, Level level) {
+    return os << static_cast<int>(level);
+}
+
+struct Payload final {
+    int index;
+    int tag;
+
+    friend bool operator==(const Payload &lhs, const Payload &rhs) noexcept {
+        return lhs.index == rhs.index && lhs.tag == rhs.tag;
+    }
+
+    friend bool operator!=(const Payload &lhs, const Payload &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend std::ostream& operator<<(std::ostream &os,
+                                    const Payload &payload) {
+        return os << '{' << payload.index << ", " << payload.tag << '}';
+    }
+};
+
+// deterministic, with many repeated values so that stability is visible
+std::uint64_t next_random(std::uint64_t &state) noexcept {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+template <typename P>
+std::vector<P> random_pairs(std::size_t size, std::uint64_t modulus) {
+    using First = typename P::first_type;
+    using Second = typename P::second_type;
+
+    std::uint64_t state = 0x9e3779b97f4a7c15;
+    std::vector<P> pairs;
+    pairs.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        pairs.emplace_back(
+            static_cast<First>(next_random(state) % modulus),
+            static_cast<Second>(next_random(state))
+        );
+    }
+
+    return pairs;
+}
+
+template <typename P>
+void require_sorts_like_std_sort(std::vector<P> pairs) {
+    std::vector<P> expected = pairs;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<P> parallel_pairs = pairs;
+
+    gregjm::radix_sort(pairs.begin(), pairs.end());
+    gregjm::radix_sort(gregjm::parallel_t{ 4 }, parallel_pairs.begin(),
+                       parallel_pairs.end());
+
+    REQUIRE(pairs == expected);
+    REQUIRE(parallel_pairs == expected);
+}
+
+template <typename P>
+void require_sorts_by_first_stably(std::vector<P> pairs) {
+    std::vector<P> expected = pairs;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const P &lhs, const P &rhs) {
+        return lhs.first() < rhs.first();
+    });
+
+    std::vector<P> parallel_pairs = pairs;
+
+    gregjm::radix_sort_by_first(pairs.begin(), pairs.end());
+    gregjm::radix_sort_by_first(gregjm::parallel_t{ 3 },
+                                parallel_pairs.begin(), parallel_pairs.end());
+
+    REQUIRE(pairs == expected);
+    REQUIRE(parallel_pairs == expected);
+}
+
+static_assert(gregjm::detail::is_radix_sortable_element_v<
+    gregjm::Pair<std::uint32_t, float>
+>);
+static_assert(!gregjm::detail::is_radix_sortable_element_v<
+    gregjm::Pair<std::uint32_t, long double>
+>);
+static_assert(gregjm::detail::is_radix_sortable_by_first_v<
+    gregjm::Pair<std::int64_t, Payload>
+>);
+
+// the sorters need a pointer to the range, so a deque is rejected
+static_assert(gregjm::detail::is_radix_sortable_range_v<std::uint32_t*>);
+static_assert(gregjm::detail::is_radix_sortable_range_v<
+    std::vector<std::uint32_t>::iterator
+>);
+static_assert(!gregjm::detail::is_radix_sortable_range_v<
+    std::deque<std::uint32_t>::iterator
+>);
+static_assert(!gregjm::detail::is_radix_sortable_range_v<
+    std::vector<bool>::iterator
+>);
+
+} // namespace
+
+TEST_CASE("radix_key preserves order", "[radix_sort]") {
+    using gregjm::detail::radix_key;
+
+    REQUIRE(radix_key(std::int32_t{ -1 }) < radix_key(std::int32_t{ 0 }));
+    REQUIRE(radix_key(std::numeric_limits<std::int64_t>::min())
+            < radix_key(std::int64_t{ -1 }));
+    REQUIRE(radix_key(Level::Low) < radix_key(Level::Middle));
+    REQUIRE(radix_key(-2.0) < radix_key(-1.0));
+    REQUIRE(radix_key(-1.0) < radix_key(-0.0));
+    REQUIRE(radix_key(-0.0) < radix_key(0.0));
+    REQUIRE(radix_key(0.0f) < radix_key(0.5f));
+    REQUIRE(radix_key(0.5f)
+            < radix_key(std::numeric_limits<float>::infinity()));
+    REQUIRE(radix_key(-std::numeric_limits<double>::infinity())
+            < radix_key(std::numeric_limits<double>::lowest()));
+}
+
+TEST_CASE("radix_sort sorts like std::sort", "[radix_sort]") {
+    SECTION("unsigned members") {
+        using PairT = gregjm::Pair<std::uint32_t, std::uint32_t>;
+
+        for (const std::size_t size : { 0, 1, 2, 63, 64, 65, 1000 }) {
+            require_sorts_like_std_sort(random_pairs<PairT>(size, 100));
+        }
+
+        require_sorts_like_std_sort(random_pairs<PairT>(300000, 1 << 20));
+    }
+
+    SECTION("signed and mixed-width members") {
+        using PairT = gregjm::Pair<std::int16_t, std::int64_t>;
+
+        require_sorts_like_std_sort(random_pairs<PairT>(5000, 1 << 16));
+        require_sorts_like_std_sort(random_pairs<PairT>(200000, 1 << 16));
+    }
+
+    SECTION("floating point members") {
+        using PairT = gregjm::Pair<double, float>;
+
+        std::vector<PairT> pairs;
+        std::uint64_t state = 1;
+
+        for (std::size_t i = 0; i < 140000; ++i) {
+            const auto value = static_cast<std::int64_t>(
+                next_random(state) % 2001
+            ) - 1000;
+
+            pairs.emplace_back(static_cast<double>(value) / 8.0,
+                               static_cast<float>(-value));
+        }
+
+        require_sorts_like_std_sort(pairs);
+    }
+
+    SECTION("enum members") {
+        using PairT = gregjm::Pair<Level, std::uint8_t>;
+
+        std::vector<PairT> pairs;
+
+        for (std::size_t i = 0; i < 500; ++i) {
+            pairs.emplace_back(static_cast<Level>(static_cast<int>(i % 3) - 1),
+                               static_cast<std::uint8_t>(i * 7));
+        }
+
+        require_sorts_like_std_sort(pairs);
+    }
+
+    SECTION("all elements equal") {
+        require_sorts_like_std_sort(std::vector<gregjm::Pair<int, int>>(
+            1000, gregjm::Pair<int, int>{ 4, -4 }
+        ));
+    }
+}
+
+TEST_CASE("radix_sort sorts arithmetic ranges", "[radix_sort]") {
+    std::vector<std::int32_t> values;
+    std::uint64_t state = 7;
+
+    for (std::size_t i = 0; i < 100000; ++i) {
+        values.push_back(static_cast<std::int32_t>(next_random(state)));
+    }
+
+    std::vector<std::int32_t> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    gregjm::radix_sort(values.data(), values.data() + values.size());
+
+    REQUIRE(values == expected);
+}
+
+TEST_CASE("radix_sort_by_first is stable", "[radix_sort]") {
+    SECTION("integral payload") {
+        using PairT = gregjm::Pair<std::uint16_t, std::uint64_t>;
+
+        require_sorts_by_first_stably(random_pairs<PairT>(1000, 50));
+        require_sorts_by_first_stably(random_pairs<PairT>(250000, 50));
+    }
+
+    SECTION("trivially copyable payload") {
+        using PairT = gregjm::Pair<std::int32_t, Payload>;
+
+        std::vector<PairT> pairs;
+
+        for (int i = 0; i < 2000; ++i) {
+            pairs.emplace_back(-(i % 17), Payload{ i, -i });
+        }
+
+        require_sorts_by_first_stably(pairs);
+    }
+}
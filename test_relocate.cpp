@@ -0,0 +1,124 @@
+#include "pair.hpp"
+#include "relocate.hpp"
+#include "tuple.hpp"
+
+#include "catch.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+// not trivially movable, but indifferent to its own address
+class Handle {
+public:
+    Handle() noexcept = default;
+
+    explicit Handle(int value) : ptr_{ std::make_unique<int>(value) } { }
+
+    int value() const noexcept {
+        return *ptr_;
+    }
+
+private:
+    std::unique_ptr<int> ptr_;
+};
+
+template <typename T>
+struct Storage {
+    std::allocator<T> alloc;
+    T *data;
+    std::size_t size;
+
+    explicit Storage(std::size_t n) : data{ alloc.allocate(n) }, size{ n } { }
+
+    ~Storage() {
+        alloc.deallocate(data, size);
+    }
+};
+
+} // namespace
+
+template <>
+struct gregjm::is_trivially_relocatable<Handle> : std::true_type { };
+
+TEST_CASE("is_trivially_relocatable propagates through Pair and Tuple",
+          "[relocate]") {
+    REQUIRE(gregjm::is_trivially_relocatable_v<int>);
+    REQUIRE(gregjm::is_trivially_relocatable_v<gregjm::Pair<int, double>>);
+    REQUIRE(gregjm::is_trivially_relocatable_v<gregjm::Pair<int&, int*>>);
+
+    REQUIRE_FALSE(std::is_trivially_copyable_v<gregjm::Pair<Handle, int>>);
+    REQUIRE(gregjm::is_trivially_relocatable_v<gregjm::Pair<Handle, int>>);
+    REQUIRE(gregjm::is_trivially_relocatable_v<
+        gregjm::Pair<gregjm::Pair<Handle, Handle>, gregjm::Tuple<int, Handle>>
+    >);
+
+    REQUIRE_FALSE(gregjm::is_trivially_relocatable_v<std::string>);
+    REQUIRE_FALSE(gregjm::is_trivially_relocatable_v<
+        gregjm::Pair<int, std::string>
+    >);
+    REQUIRE_FALSE(gregjm::is_trivially_relocatable_v<
+        gregjm::Tuple<int, Handle, std::string>
+    >);
+}
+
+TEST_CASE("relocate moves objects into uninitialized storage", "[relocate]") {
+    SECTION("trivially relocatable") {
+        using PairT = gregjm::Pair<Handle, int>;
+
+        Storage<PairT> source{ 4 };
+        Storage<PairT> dest{ 4 };
+
+        for (int i = 0; i < 4; ++i) {
+            ::new (static_cast<void*>(source.data + i)) PairT{ Handle{ i }, i };
+        }
+
+        REQUIRE(gregjm::relocate(source.data, source.data + 4, dest.data)
+                == dest.data + 4);
+
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(dest.data[i].first().value() == i);
+            REQUIRE(dest.data[i].second() == i);
+        }
+
+        std::destroy(dest.data, dest.data + 4);
+    }
+
+    SECTION("not trivially relocatable") {
+        using PairT = gregjm::Pair<std::string, int>;
+
+        Storage<PairT> source{ 3 };
+        Storage<PairT> dest{ 3 };
+
+        for (int i = 0; i < 3; ++i) {
+            ::new (static_cast<void*>(source.data + i))
+                PairT{ std::string(32, static_cast<char>('a' + i)), i };
+        }
+
+        REQUIRE(gregjm::relocate(source.data, source.data + 3, dest.data)
+                == dest.data + 3);
+
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(dest.data[i].first()
+                    == std::string(32, static_cast<char>('a' + i)));
+            REQUIRE(dest.data[i].second() == i);
+        }
+
+        std::destroy(dest.data, dest.data + 3);
+    }
+
+    SECTION("a single object") {
+        Storage<Handle> source{ 1 };
+        Storage<Handle> dest{ 1 };
+
+        ::new (static_cast<void*>(source.data)) Handle{ 42 };
+
+        REQUIRE(gregjm::relocate_at(source.data, dest.data) == dest.data);
+        REQUIRE(dest.data->value() == 42);
+
+        std::destroy_at(dest.data);
+    }
+}
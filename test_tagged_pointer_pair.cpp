@@ -0,0 +1,143 @@
+#include "tagged_pointer_pair.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct alignas(8) Node {
+    Node *next;
+    int value;
+};
+
+enum class Color : std::uint8_t {
+    Red,
+    Black
+};
+
+using Tagged = gregjm::TaggedPointerPair<Node*, std::uint8_t>;
+
+static_assert(Tagged::tag_bits == 3);
+static_assert(gregjm::TaggedPointerPair<std::uint32_t*, bool>::tag_bits == 2);
+static_assert(gregjm::TaggedPointerPair<Node*, Color, 1>::tag_bits == 1);
+static_assert(sizeof(Tagged) == sizeof(Node*));
+static_assert(sizeof(gregjm::Pair<Node*, std::uint8_t>) == 2 * sizeof(Node*));
+static_assert(std::is_trivially_copyable_v<Tagged>);
+static_assert(gregjm::is_trivially_relocatable_v<Tagged>);
+
+} // namespace
+
+TEST_CASE("TaggedPointerPair stores a tag in alignment bits",
+          "[TaggedPointerPair]") {
+    Node nodes[2]{ };
+
+    SECTION("access") {
+        Tagged pair{ &nodes[0], 7 };
+
+        REQUIRE(pair.first() == &nodes[0]);
+        REQUIRE(pair.second() == 7);
+
+        pair.second() = 2;
+
+        REQUIRE(pair.first() == &nodes[0]);
+        REQUIRE(pair.second() == 2);
+
+        pair.first() = &nodes[1];
+
+        REQUIRE(pair.first() == &nodes[1]);
+        REQUIRE(pair.second() == 2);
+
+        const Tagged &const_pair = pair;
+
+        REQUIRE(const_pair.first()->value == 0);
+        REQUIRE(std::is_same_v<decltype(const_pair.first()), Node*>);
+    }
+
+    SECTION("value-initialized") {
+        const Tagged pair{ };
+
+        REQUIRE(pair.first() == nullptr);
+        REQUIRE(pair.second() == 0);
+        REQUIRE(Tagged{ nullptr, 5 }.second() == 5);
+    }
+
+    SECTION("enum tags") {
+        gregjm::TaggedPointerPair<Node*, Color, 1> pair{ &nodes[1],
+                                                         Color::Black };
+
+        REQUIRE(pair.second() == Color::Black);
+
+        pair.second() = Color::Red;
+
+        REQUIRE(pair.first() == &nodes[1]);
+        REQUIRE(pair.second() == Color::Red);
+    }
+
+    SECTION("fits") {
+        REQUIRE(Tagged::fits(&nodes[0], 7));
+        REQUIRE_FALSE(Tagged::fits(&nodes[0], 8));
+        REQUIRE_FALSE(Tagged::fits(
+            reinterpret_cast<Node*>(reinterpret_cast<char*>(&nodes[0]) + 1),
+            0
+        ));
+    }
+
+    SECTION("conversion to and from Pair") {
+        const gregjm::Pair<Node*, std::uint8_t> unpacked{ &nodes[0],
+                                                          std::uint8_t{ 3 } };
+        const Tagged pair{ unpacked };
+
+        REQUIRE(static_cast<gregjm::Pair<Node*, std::uint8_t>>(pair)
+                == unpacked);
+    }
+}
+
+TEST_CASE("TaggedPointerPair behaves like Pair", "[TaggedPointerPair]") {
+    Node nodes[2]{ };
+
+    SECTION("comparison") {
+        REQUIRE(Tagged{ &nodes[0], 1 } == Tagged{ &nodes[0], 1 });
+        REQUIRE(Tagged{ &nodes[0], 1 } != Tagged{ &nodes[0], 2 });
+        REQUIRE(Tagged{ &nodes[0], 1 } != Tagged{ &nodes[1], 1 });
+        REQUIRE(Tagged{ &nodes[0], 7 } < Tagged{ &nodes[1], 0 });
+        REQUIRE(Tagged{ &nodes[0], 1 } < Tagged{ &nodes[0], 2 });
+        REQUIRE(Tagged{ &nodes[1], 0 } >= Tagged{ &nodes[0], 7 });
+    }
+
+    SECTION("swap") {
+        Tagged lhs{ &nodes[0], 1 };
+        Tagged rhs{ &nodes[1], 2 };
+
+        swap(lhs, rhs);
+
+        REQUIRE(lhs == Tagged{ &nodes[1], 2 });
+        REQUIRE(rhs == Tagged{ &nodes[0], 1 });
+
+        lhs.first() = rhs.first();
+
+        REQUIRE(lhs == Tagged{ &nodes[0], 2 });
+    }
+
+    SECTION("hash") {
+        std::unordered_set<Tagged> set;
+
+        for (std::uint8_t tag = 0; tag < 8; ++tag) {
+            set.emplace(&nodes[0], tag);
+            set.emplace(&nodes[1], tag);
+        }
+
+        set.emplace(&nodes[0], std::uint8_t{ 0 });
+
+        REQUIRE(set.size() == 16);
+        REQUIRE(set.count(Tagged{ &nodes[1], 4 }) == 1);
+        REQUIRE(std::hash<Tagged>{ }(Tagged{ &nodes[1], 4 })
+                == std::hash<Tagged>{ }(Tagged{ &nodes[1], 4 }));
+    }
+}
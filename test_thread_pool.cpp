@@ -0,0 +1,98 @@
+#include "thread_pool.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// sums [first, last) by splitting it in halves down to single elements
+void sum_range(gregjm::ThreadPool &pool, std::size_t first, std::size_t last,
+               std::atomic<std::size_t> &sum) {
+    if (last - first == 1) {
+        sum.fetch_add(first, std::memory_order_relaxed);
+
+        return;
+    }
+
+    const std::size_t middle = first + (last - first) / 2;
+
+    gregjm::TaskGroup group{ pool };
+    group.run([&pool, first, middle, &sum] {
+        sum_range(pool, first, middle, sum);
+    });
+    sum_range(pool, middle, last, sum);
+    group.wait();
+}
+
+} // namespace
+
+TEST_CASE("ThreadPool runs submitted tasks", "[ThreadPool]") {
+    SECTION("a zero thread count uses every hardware thread") {
+        const gregjm::ThreadPool pool;
+
+        REQUIRE(pool.num_threads()
+                == std::max(std::thread::hardware_concurrency(), 1u));
+    }
+
+    SECTION("the destructor runs remaining tasks") {
+        std::atomic<int> count{ 0 };
+
+        {
+            gregjm::ThreadPool pool{ 3 };
+
+            for (int i = 0; i < 100; ++i) {
+                pool.submit([&count] {
+                    count.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+        }
+
+        REQUIRE(count.load() == 100);
+    }
+
+    SECTION("a single thread runs tasks while waiting") {
+        gregjm::ThreadPool pool{ 1 };
+        std::atomic<std::size_t> sum{ 0 };
+
+        sum_range(pool, 0, 1000, sum);
+
+        REQUIRE(sum.load() == 999 * 1000 / 2);
+    }
+}
+
+TEST_CASE("TaskGroup waits for nested tasks", "[ThreadPool]") {
+    for (const std::size_t num_threads : { 2, 4, 8 }) {
+        gregjm::ThreadPool pool{ num_threads };
+        std::atomic<std::size_t> sum{ 0 };
+
+        sum_range(pool, 0, 10000, sum);
+
+        REQUIRE(sum.load() == 9999 * 10000 / 2);
+    }
+}
+
+TEST_CASE("TaskGroup rethrows the first exception", "[ThreadPool]") {
+    gregjm::ThreadPool pool{ 4 };
+    std::atomic<int> finished{ 0 };
+
+    gregjm::TaskGroup group{ pool };
+
+    for (int i = 0; i < 16; ++i) {
+        group.run([i, &finished] {
+            if (i == 5) {
+                throw std::runtime_error{ "task failed" };
+            }
+
+            finished.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    REQUIRE_THROWS_AS(group.wait(), std::runtime_error);
+    REQUIRE(finished.load() == 15);
+    REQUIRE_NOTHROW(group.wait());
+}
@@ -0,0 +1,215 @@
+#include "tuple.hpp"
+
+#include "catch.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Hasher {
+    std::size_t operator()(int i) const noexcept {
+        return static_cast<std::size_t>(i);
+    }
+};
+
+struct KeyEqual {
+    bool operator()(int lhs, int rhs) const noexcept {
+        return lhs == rhs;
+    }
+};
+
+} // namespace
+
+TEST_CASE("Tuple objects can be instantiated with builtin types", "[Tuple]") {
+    gregjm::Tuple<int, double, const char*> tuple{ 0, 5.0, "foo" };
+
+    REQUIRE(gregjm::get<0>(tuple) == 0);
+    REQUIRE(gregjm::get<1>(tuple) == 5.0);
+    REQUIRE_THAT(gregjm::get<2>(tuple), Catch::Matchers::Equals("foo"));
+
+    gregjm::get<0>(tuple) = 15;
+    tuple.get<1>() = 10.0;
+    gregjm::get<2>(tuple) = "bar";
+
+    REQUIRE(tuple.get<0>() == 15);
+    REQUIRE(tuple.get<1>() == 10.0);
+    REQUIRE_THAT(tuple.get<2>(), Catch::Matchers::Equals("bar"));
+}
+
+TEST_CASE("Tuple objects compress empty members", "[Tuple]") {
+    SECTION("stateless policies") {
+        using TupleT = gregjm::Tuple<Hasher, KeyEqual, std::allocator<int>,
+                                     int*>;
+
+        REQUIRE(sizeof(TupleT) == sizeof(int*));
+
+        const TupleT tuple{ Hasher{ }, KeyEqual{ }, std::allocator<int>{ },
+                            nullptr };
+
+        REQUIRE(gregjm::get<0>(tuple)(5) == 5);
+        REQUIRE(gregjm::get<1>(tuple)(3, 3));
+        REQUIRE(gregjm::get<3>(tuple) == nullptr);
+    }
+
+    SECTION("only empty members") {
+        REQUIRE(std::is_empty_v<gregjm::Tuple<Hasher, KeyEqual>>);
+    }
+
+    SECTION("final members") {
+        struct Final final {
+            int i;
+        };
+
+        const gregjm::Tuple<Final, Hasher, int> tuple{ Final{ 1 }, Hasher{ },
+                                                       2 };
+
+        REQUIRE(sizeof(tuple) == sizeof(Final) + sizeof(int));
+        REQUIRE(gregjm::get<0>(tuple).i == 1);
+        REQUIRE(gregjm::get<2>(tuple) == 2);
+    }
+}
+
+TEST_CASE("Tuple objects are constructed with perfect forwarding",
+          "[Tuple]") {
+    SECTION("piecewise construction") {
+        using TupleT = gregjm::Tuple<std::vector<int>, std::string, Hasher>;
+
+        const TupleT tuple{ std::piecewise_construct,
+                            std::forward_as_tuple(3, 1),
+                            std::forward_as_tuple(2, 'a'),
+                            std::forward_as_tuple() };
+
+        REQUIRE_THAT(gregjm::get<0>(tuple),
+                     Catch::Matchers::Equals(std::vector<int>{ 1, 1, 1 }));
+        REQUIRE(gregjm::get<1>(tuple) == "aa");
+    }
+
+    SECTION("rvalue access") {
+        gregjm::Tuple<std::string, int> tuple{ "foo", 0 };
+
+        const std::string moved = gregjm::get<0>(std::move(tuple));
+
+        REQUIRE(moved == "foo");
+        REQUIRE(std::is_same_v<decltype(gregjm::get<0>(std::move(tuple))),
+                               std::string&&>);
+    }
+
+    SECTION("reference members") {
+        int i = 15;
+        double d = 3.0;
+
+        const gregjm::Tuple<int&, double&> tuple{ i, d };
+
+        REQUIRE(&gregjm::get<0>(tuple) == &i);
+        REQUIRE(&gregjm::get<1>(tuple) == &d);
+    }
+
+    SECTION("converting construction") {
+        const gregjm::Tuple<int, const char*> tuple{ 1, "foo" };
+        const gregjm::Tuple<long, std::string> converted{ tuple };
+
+        REQUIRE(gregjm::get<0>(converted) == 1);
+        REQUIRE(gregjm::get<1>(converted) == "foo");
+
+        REQUIRE_FALSE(std::is_constructible_v<
+            gregjm::Tuple<int, int>, const gregjm::Tuple<int, const char*>&
+        >);
+        REQUIRE_FALSE(std::is_constructible_v<
+            gregjm::Tuple<int, int>, const gregjm::Tuple<int>&
+        >);
+    }
+
+    SECTION("make_tuple") {
+        int i = 0;
+        const auto tuple = gregjm::make_tuple(1, std::string{ "foo" },
+                                              std::ref(i));
+
+        REQUIRE(std::is_same_v<std::decay_t<decltype(tuple)>,
+                               gregjm::Tuple<int, std::string, int>>);
+    }
+}
+
+TEST_CASE("Tuple objects can be compared", "[Tuple]") {
+    using TupleT = gregjm::Tuple<int, std::string, double>;
+
+    const TupleT a{ 0, "foo", 1.0 };
+    const TupleT b{ 0, "foo", 2.0 };
+    const TupleT c{ 0, "goo", 0.0 };
+
+    REQUIRE(a == a);
+    REQUIRE(a != b);
+    REQUIRE(a < b);
+    REQUIRE(b < c);
+    REQUIRE(a <= a);
+    REQUIRE(c > a);
+    REQUIRE(c >= b);
+    REQUIRE_FALSE(b < a);
+
+    REQUIRE(gregjm::Tuple<int, long>{ 1, 2 }
+            == gregjm::Tuple<long, int>{ 1, 2 });
+}
+
+TEST_CASE("Tuple objects can be swapped", "[Tuple]") {
+    gregjm::Tuple<int, std::string> a{ 0, "foo" };
+    gregjm::Tuple<int, std::string> b{ 1, "bar" };
+
+    swap(a, b);
+
+    REQUIRE(gregjm::get<0>(a) == 1);
+    REQUIRE(gregjm::get<1>(a) == "bar");
+    REQUIRE(gregjm::get<0>(b) == 0);
+    REQUIRE(gregjm::get<1>(b) == "foo");
+
+    a = b;
+
+    REQUIRE(a == b);
+}
+
+TEST_CASE("Type traits carry through to Tuple", "[Tuple]") {
+    struct ThrowConstructible {
+        ThrowConstructible() { }
+    };
+
+    struct ThrowSwappable {
+        ThrowSwappable() = default;
+        ThrowSwappable(ThrowSwappable&&) { }
+        ThrowSwappable& operator=(ThrowSwappable&&) { return *this; }
+    };
+
+    SECTION("nothrow constructible") {
+        REQUIRE(std::is_nothrow_default_constructible_v<
+            gregjm::Tuple<int, Hasher, double>
+        >);
+        REQUIRE_FALSE(std::is_nothrow_default_constructible_v<
+            gregjm::Tuple<int, ThrowConstructible>
+        >);
+        REQUIRE(std::is_nothrow_constructible_v<
+            gregjm::Tuple<int, Hasher>, std::piecewise_construct_t,
+            std::tuple<int>, std::tuple<>
+        >);
+        REQUIRE_FALSE(std::is_nothrow_constructible_v<
+            gregjm::Tuple<int, ThrowConstructible>,
+            std::piecewise_construct_t, std::tuple<int>, std::tuple<>
+        >);
+    }
+
+    SECTION("nothrow swappable") {
+        REQUIRE(std::is_nothrow_swappable_v<gregjm::Tuple<int, double>>);
+        REQUIRE_FALSE(std::is_nothrow_swappable_v<
+            gregjm::Tuple<int, ThrowSwappable>
+        >);
+    }
+
+    SECTION("trivially destructible") {
+        REQUIRE(std::is_trivially_destructible_v<gregjm::Tuple<int, int>>);
+        REQUIRE_FALSE(std::is_trivially_destructible_v<
+            gregjm::Tuple<int, std::vector<int>>
+        >);
+    }
+}
@@ -0,0 +1,123 @@
+#include "pair.hpp"
+#include "tuple.hpp"
+#include "uninitialized.hpp"
+
+#include "catch.hpp"
+
+#include <list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct WithInitializer {
+    int value = 7;
+};
+
+struct Counted {
+    static inline int default_constructed = 0;
+
+    int value;
+
+    Counted() noexcept : value{ 1 } {
+        ++default_constructed;
+    }
+
+    explicit Counted(int v) noexcept : value{ v } { }
+};
+
+} // namespace
+
+TEST_CASE("Pair and Tuple can be default-initialized", "[uninitialized]") {
+    SECTION("non-trivial members are still constructed") {
+        gregjm::Pair<int, std::string> pair{ gregjm::uninitialized };
+        pair.first() = 5;
+
+        REQUIRE(pair.first() == 5);
+        REQUIRE(pair.second().empty());
+
+        gregjm::Pair<WithInitializer, double> with_init{
+            gregjm::uninitialized
+        };
+
+        REQUIRE(with_init.first().value == 7);
+
+        gregjm::Tuple<std::string, int> tuple{ gregjm::uninitialized };
+
+        REQUIRE(tuple.get<0>().empty());
+    }
+
+    SECTION("the tag is explicit and requires default constructible members") {
+        REQUIRE_FALSE(std::is_convertible_v<gregjm::uninitialized_t,
+                                            gregjm::Pair<int, int>>);
+        REQUIRE_FALSE(std::is_constructible_v<gregjm::Pair<int&, int>,
+                                              gregjm::uninitialized_t>);
+        REQUIRE_FALSE(std::is_constructible_v<gregjm::Tuple<int, int&>,
+                                              gregjm::uninitialized_t>);
+        REQUIRE(std::is_nothrow_constructible_v<gregjm::Pair<int, float>,
+                                                gregjm::uninitialized_t>);
+    }
+}
+
+TEST_CASE("make_uninitialized_array default-initializes its elements",
+          "[uninitialized]") {
+    auto array = gregjm::make_uninitialized_array<
+        gregjm::Pair<int, std::string>
+    >(16);
+
+    for (int i = 0; i < 16; ++i) {
+        REQUIRE(array[static_cast<std::size_t>(i)].second().empty());
+
+        array[static_cast<std::size_t>(i)] = { i, std::to_string(i) };
+    }
+
+    REQUIRE(array[15] == gregjm::Pair<int, std::string>{ 15, "15" });
+}
+
+TEST_CASE("DefaultInitAllocator default-initializes value constructions",
+          "[uninitialized]") {
+    SECTION("trivial pairs") {
+        using PairT = gregjm::Pair<int, float>;
+
+        std::vector<PairT, gregjm::DefaultInitAllocator<PairT>> vec(64);
+
+        for (int i = 0; i < 64; ++i) {
+            vec[static_cast<std::size_t>(i)] = { i, 0.5f };
+        }
+
+        vec.resize(128);
+
+        REQUIRE(vec.size() == 128);
+        REQUIRE(vec[63] == PairT{ 63, 0.5f });
+    }
+
+    SECTION("constructors still run") {
+        Counted::default_constructed = 0;
+
+        std::vector<Counted, gregjm::DefaultInitAllocator<Counted>> vec(4);
+
+        REQUIRE(Counted::default_constructed == 4);
+        REQUIRE(vec[3].value == 1);
+
+        vec.emplace_back(10);
+
+        REQUIRE(vec.back().value == 10);
+        REQUIRE(Counted::default_constructed == 4);
+
+        std::vector<WithInitializer,
+                    gregjm::DefaultInitAllocator<WithInitializer>> inits(2);
+
+        REQUIRE(inits[1].value == 7);
+    }
+
+    SECTION("rebinding") {
+        std::list<int, gregjm::DefaultInitAllocator<int>> list{ 1, 2, 3 };
+
+        list.emplace_back();
+        REQUIRE(list.size() == 4);
+        REQUIRE(list.front() == 1);
+        REQUIRE(gregjm::DefaultInitAllocator<int>{ }
+                == gregjm::DefaultInitAllocator<double>{ });
+    }
+}
@@ -0,0 +1,257 @@
+#include "unique_ptr.hpp"
+
+#include "catch.hpp"
+
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+struct FileCloser {
+    void operator()(std::FILE *file) const noexcept {
+        std::fclose(file);
+    }
+};
+
+struct Pool {
+    int returned = 0;
+};
+
+// stateless, but counts through a global so tests can observe deletions
+struct CountingDelete {
+    static inline int deleted = 0;
+
+    void operator()(int *ptr) const noexcept {
+        ++deleted;
+        delete ptr;
+    }
+};
+
+struct ArrayCountingDelete {
+    static inline int deleted = 0;
+
+    void operator()(int *ptr) const noexcept {
+        ++deleted;
+        delete[] ptr;
+    }
+};
+
+struct StatefulDelete {
+    Pool *pool;
+
+    void operator()(int *ptr) const noexcept {
+        ++pool->returned;
+        delete ptr;
+    }
+};
+
+struct ThrowingDelete {
+    void operator()(int *ptr) const {
+        delete ptr;
+    }
+};
+
+struct Base {
+    virtual ~Base() = default;
+};
+
+struct Derived : Base {
+    std::string name = "derived";
+};
+
+} // namespace
+
+TEST_CASE("UniquePtr stores stateless deleters in zero bytes",
+          "[UniquePtr]") {
+    REQUIRE(sizeof(gregjm::UniquePtr<int>) == sizeof(int*));
+    REQUIRE(sizeof(gregjm::UniquePtr<int[]>) == sizeof(int*));
+    REQUIRE(sizeof(gregjm::UniquePtr<std::FILE, FileCloser>)
+            == sizeof(std::FILE*));
+    REQUIRE(sizeof(gregjm::UniquePtr<int, CountingDelete>) == sizeof(int*));
+
+    REQUIRE(sizeof(gregjm::UniquePtr<int, StatefulDelete>)
+            == 2 * sizeof(int*));
+    REQUIRE(sizeof(gregjm::UniquePtr<int, void (*)(int*)>)
+            == 2 * sizeof(int*));
+
+    REQUIRE(gregjm::is_trivially_relocatable_v<gregjm::UniquePtr<int>>);
+}
+
+TEST_CASE("UniquePtr owns its object", "[UniquePtr]") {
+    CountingDelete::deleted = 0;
+
+    SECTION("destruction") {
+        {
+            gregjm::UniquePtr<int, CountingDelete> ptr{ new int{ 5 } };
+
+            REQUIRE(ptr);
+            REQUIRE(*ptr == 5);
+        }
+
+        REQUIRE(CountingDelete::deleted == 1);
+
+        {
+            gregjm::UniquePtr<int, CountingDelete> empty;
+            gregjm::UniquePtr<int, CountingDelete> null = nullptr;
+
+            REQUIRE_FALSE(empty);
+            REQUIRE(null == nullptr);
+        }
+
+        REQUIRE(CountingDelete::deleted == 1);
+    }
+
+    SECTION("moves transfer ownership") {
+        gregjm::UniquePtr<int, CountingDelete> ptr{ new int{ 5 } };
+        gregjm::UniquePtr<int, CountingDelete> other = std::move(ptr);
+
+        REQUIRE(ptr == nullptr);
+        REQUIRE(*other == 5);
+
+        gregjm::UniquePtr<int, CountingDelete> third{ new int{ 6 } };
+        third = std::move(other);
+
+        REQUIRE(CountingDelete::deleted == 1);
+        REQUIRE(*third == 5);
+
+        third = nullptr;
+
+        REQUIRE(CountingDelete::deleted == 2);
+    }
+
+    SECTION("release and reset") {
+        gregjm::UniquePtr<int, CountingDelete> ptr{ new int{ 5 } };
+        int *const raw = ptr.release();
+
+        REQUIRE(ptr == nullptr);
+        REQUIRE(CountingDelete::deleted == 0);
+
+        ptr.reset(raw);
+        REQUIRE(ptr.get() == raw);
+
+        ptr.reset(new int{ 6 });
+        REQUIRE(CountingDelete::deleted == 1);
+        REQUIRE(*ptr == 6);
+
+        gregjm::UniquePtr<int, CountingDelete> other;
+        swap(ptr, other);
+
+        REQUIRE(ptr == nullptr);
+        REQUIRE(*other == 6);
+        REQUIRE(ptr != other);
+    }
+
+    SECTION("stateful deleters") {
+        Pool pool;
+
+        {
+            gregjm::UniquePtr<int, StatefulDelete> ptr{
+                new int{ 1 }, StatefulDelete{ &pool }
+            };
+            gregjm::UniquePtr<int, StatefulDelete> moved = std::move(ptr);
+
+            REQUIRE(moved.get_deleter().pool == &pool);
+        }
+
+        REQUIRE(pool.returned == 1);
+
+        StatefulDelete deleter{ &pool };
+
+        {
+            gregjm::UniquePtr<int, StatefulDelete&> ptr{ new int{ 2 },
+                                                         deleter };
+
+            REQUIRE(&ptr.get_deleter() == &deleter);
+        }
+
+        REQUIRE(pool.returned == 2);
+    }
+
+    SECTION("conversions") {
+        gregjm::UniquePtr<Base> base = gregjm::make_unique<Derived>();
+
+        REQUIRE(dynamic_cast<Derived&>(*base).name == "derived");
+
+        base = gregjm::make_unique<Derived>();
+
+        REQUIRE(base != nullptr);
+        REQUIRE_FALSE(std::is_constructible_v<gregjm::UniquePtr<Derived>,
+                                              gregjm::UniquePtr<Base>&&>);
+        REQUIRE_FALSE(std::is_copy_constructible_v<gregjm::UniquePtr<int>>);
+        REQUIRE_FALSE(std::is_convertible_v<int*, gregjm::UniquePtr<int>>);
+    }
+}
+
+TEST_CASE("UniquePtr<T[]> owns an array", "[UniquePtr]") {
+    ArrayCountingDelete::deleted = 0;
+
+    {
+        gregjm::UniquePtr<int[], ArrayCountingDelete> ptr{ new int[4]{ } };
+        ptr[2] = 7;
+
+        REQUIRE(ptr[2] == 7);
+        REQUIRE(ptr[3] == 0);
+    }
+
+    REQUIRE(ArrayCountingDelete::deleted == 1);
+
+    auto array = gregjm::make_unique<std::string[]>(3);
+    array[1] = "foo";
+
+    REQUIRE(array[0].empty());
+    REQUIRE(array[1] == "foo");
+
+    auto values = gregjm::make_unique<int[]>(8);
+
+    REQUIRE(values[7] == 0);
+
+    auto overwrite = gregjm::make_unique_for_overwrite<int[]>(8);
+    overwrite[0] = 1;
+
+    REQUIRE(overwrite[0] == 1);
+}
+
+namespace {
+
+// delete[] must run through the pointer type the array was created as
+static_assert(std::is_constructible_v<gregjm::UniquePtr<Base[]>, Base*>);
+static_assert(std::is_constructible_v<gregjm::UniquePtr<const int[]>, int*>);
+static_assert(std::is_constructible_v<gregjm::UniquePtr<Base[]>,
+                                      std::nullptr_t>);
+static_assert(!std::is_constructible_v<gregjm::UniquePtr<Base[]>, Derived*>);
+static_assert(!std::is_constructible_v<
+    gregjm::UniquePtr<Base[]>, Derived*, gregjm::DefaultDelete<Base[]>
+>);
+static_assert(std::is_constructible_v<gregjm::UniquePtr<Base>, Derived*>);
+
+template <typename P, typename U, typename = void>
+struct CanReset : std::false_type { };
+
+template <typename P, typename U>
+struct CanReset<P, U, std::void_t<decltype(std::declval<P&>().reset(
+    std::declval<U>()
+))>> : std::true_type { };
+
+static_assert(CanReset<gregjm::UniquePtr<Base[]>, Base*>::value);
+static_assert(CanReset<gregjm::UniquePtr<Base[]>, std::nullptr_t>::value);
+static_assert(!CanReset<gregjm::UniquePtr<Base[]>, Derived*>::value);
+static_assert(CanReset<gregjm::UniquePtr<Base>, Derived*>::value);
+
+} // namespace
+
+TEST_CASE("UniquePtr propagates noexcept from its deleter", "[UniquePtr]") {
+    using NothrowT = gregjm::UniquePtr<int>;
+    using ThrowingT = gregjm::UniquePtr<int, ThrowingDelete>;
+
+    REQUIRE(std::is_nothrow_default_constructible_v<NothrowT>);
+    REQUIRE(std::is_nothrow_move_constructible_v<NothrowT>);
+    REQUIRE(std::is_nothrow_move_assignable_v<NothrowT>);
+    REQUIRE(noexcept(std::declval<NothrowT&>().reset()));
+
+    REQUIRE(std::is_nothrow_move_constructible_v<ThrowingT>);
+    REQUIRE_FALSE(std::is_nothrow_move_assignable_v<ThrowingT>);
+    REQUIRE_FALSE(noexcept(std::declval<ThrowingT&>().reset()));
+    REQUIRE_FALSE(noexcept(std::declval<ThrowingT&>() = nullptr));
+}
@@ -0,0 +1,380 @@
+#include "vector.hpp"
+#include "unique_ptr.hpp"
+
+#include "catch.hpp"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    static inline int allocations = 0;
+
+    CountingAllocator() noexcept = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept { }
+
+    T* allocate(std::size_t n) {
+        ++allocations;
+
+        return std::allocator<T>{ }.allocate(n);
+    }
+
+    void deallocate(T *ptr, std::size_t n) noexcept {
+        std::allocator<T>{ }.deallocate(ptr, n);
+    }
+
+    friend bool operator==(const CountingAllocator&,
+                           const CountingAllocator&) noexcept {
+        return true;
+    }
+
+    friend bool operator!=(const CountingAllocator&,
+                           const CountingAllocator&) noexcept {
+        return false;
+    }
+};
+
+struct Arena {
+    alignas(std::max_align_t) unsigned char buffer[4096];
+    std::size_t used = 0;
+};
+
+// stateful: allocators from different arenas do not compare equal
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    Arena *arena;
+
+    explicit ArenaAllocator(Arena &a) noexcept : arena{ &a } { }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+    : arena{ other.arena } { }
+
+    T* allocate(std::size_t n) {
+        const std::size_t bytes = (n * sizeof(T) + alignof(std::max_align_t)
+                                   - 1) & ~(alignof(std::max_align_t) - 1);
+
+        if (arena->used + bytes > sizeof(arena->buffer)) {
+            throw std::bad_alloc{ };
+        }
+
+        T *const ptr = reinterpret_cast<T*>(arena->buffer + arena->used);
+        arena->used += bytes;
+
+        return ptr;
+    }
+
+    void deallocate(T*, std::size_t) noexcept { }
+
+    friend bool operator==(const ArenaAllocator &lhs,
+                           const ArenaAllocator &rhs) noexcept {
+        return lhs.arena == rhs.arena;
+    }
+
+    friend bool operator!=(const ArenaAllocator &lhs,
+                           const ArenaAllocator &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+};
+
+// counts moves; Relocatable opts into trivial relocation
+template <bool Relocatable>
+struct Tracked {
+    static inline int moves = 0;
+
+    int value;
+
+    explicit Tracked(int v) noexcept : value{ v } { }
+
+    Tracked(const Tracked &other) noexcept : value{ other.value } { }
+
+    Tracked(Tracked &&other) noexcept : value{ other.value } {
+        ++moves;
+    }
+
+    Tracked& operator=(const Tracked&) noexcept = default;
+
+    ~Tracked() { }
+};
+
+// has a throwing move, so growth must copy to keep the strong guarantee
+struct ThrowingCopy {
+    static inline int copies_until_throw = -1;
+
+    int value;
+
+    explicit ThrowingCopy(int v) noexcept : value{ v } { }
+
+    ThrowingCopy(const ThrowingCopy &other) : value{ other.value } {
+        if (copies_until_throw == 0) {
+            throw std::runtime_error{ "copy" };
+        }
+
+        --copies_until_throw;
+    }
+
+    ThrowingCopy(ThrowingCopy &&other) : value{ other.value } { }
+
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+};
+
+} // namespace
+
+template <>
+struct gregjm::is_trivially_relocatable<Tracked<true>> : std::true_type { };
+
+TEST_CASE("Vector compresses stateless allocators", "[Vector]") {
+    REQUIRE(sizeof(gregjm::Vector<int>) == 3 * sizeof(void*));
+    REQUIRE(sizeof(gregjm::Vector<gregjm::Pair<int, float>>)
+            == 3 * sizeof(void*));
+    REQUIRE(sizeof(gregjm::Vector<int, CountingAllocator<int>>)
+            == 3 * sizeof(void*));
+    REQUIRE(sizeof(gregjm::Vector<int, ArenaAllocator<int>>)
+            == 4 * sizeof(void*));
+
+    REQUIRE(gregjm::is_trivially_relocatable_v<gregjm::Vector<std::string>>);
+    REQUIRE_FALSE(gregjm::is_trivially_relocatable_v<
+        gregjm::Vector<int, std::allocator<int>, 4>
+    >);
+}
+
+TEST_CASE("Vector supports the usual operations", "[Vector]") {
+    gregjm::Vector<std::string> vec;
+
+    REQUIRE(vec.empty());
+    REQUIRE(vec.data() == nullptr);
+
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(std::to_string(i));
+    }
+
+    REQUIRE(vec.size() == 100);
+    REQUIRE(vec.capacity() >= 100);
+    REQUIRE(vec.front() == "0");
+    REQUIRE(vec.back() == "99");
+    REQUIRE(vec.at(42) == "42");
+    REQUIRE_THROWS_AS(vec.at(100), std::out_of_range);
+
+    SECTION("erase") {
+        auto it = vec.erase(vec.begin() + 10, vec.begin() + 20);
+
+        REQUIRE(*it == "20");
+        REQUIRE(vec.size() == 90);
+
+        vec.erase(vec.cbegin());
+
+        REQUIRE(vec.front() == "1");
+    }
+
+    SECTION("resize") {
+        vec.resize(10);
+
+        REQUIRE(vec.size() == 10);
+        REQUIRE(vec.back() == "9");
+
+        vec.resize(12, "x");
+
+        REQUIRE(vec[11] == "x");
+
+        vec.resize(14);
+
+        REQUIRE(vec[13].empty());
+
+        vec.pop_back();
+
+        REQUIRE(vec.size() == 13);
+    }
+
+    SECTION("copy and move") {
+        gregjm::Vector<std::string> copy = vec;
+
+        REQUIRE(copy == vec);
+
+        gregjm::Vector<std::string> moved = std::move(copy);
+
+        REQUIRE(copy.empty());
+        REQUIRE(moved == vec);
+
+        copy = moved;
+        moved.clear();
+
+        REQUIRE(copy == vec);
+        REQUIRE(moved != vec);
+
+        moved = std::move(copy);
+
+        REQUIRE(moved == vec);
+    }
+
+    SECTION("construction from ranges") {
+        const std::list<int> list{ 3, 1, 4, 1, 5 };
+        const gregjm::Vector<int> from_list(list.begin(), list.end());
+        const gregjm::Vector<int> from_init{ 3, 1, 4, 1, 5 };
+        const gregjm::Vector<int> filled(5, 1);
+
+        REQUIRE(from_list == from_init);
+        REQUIRE(filled[4] == 1);
+        REQUIRE(gregjm::Vector<int>(3).back() == 0);
+    }
+
+    SECTION("pushing an element of the same vector") {
+        gregjm::Vector<std::string> small{ "foo-past-the-small-buffer" };
+
+        for (int i = 0; i < 8; ++i) {
+            small.push_back(small[0]);
+        }
+
+        REQUIRE(small.back() == "foo-past-the-small-buffer");
+    }
+}
+
+TEST_CASE("Vector relocates trivially relocatable elements in bulk",
+          "[Vector]") {
+    Tracked<true>::moves = 0;
+    Tracked<false>::moves = 0;
+
+    gregjm::Vector<Tracked<true>> relocatable;
+    gregjm::Vector<Tracked<false>> other;
+
+    for (int i = 0; i < 64; ++i) {
+        relocatable.emplace_back(i);
+        other.emplace_back(i);
+    }
+
+    REQUIRE(Tracked<true>::moves == 0);
+    REQUIRE(Tracked<false>::moves > 0);
+    REQUIRE(relocatable[63].value == 63);
+
+    gregjm::Vector<gregjm::UniquePtr<int>> owners;
+
+    for (int i = 0; i < 64; ++i) {
+        owners.push_back(gregjm::make_unique<int>(i));
+    }
+
+    REQUIRE(*owners[40] == 40);
+}
+
+TEST_CASE("Vector growth keeps the strong exception guarantee",
+          "[Vector]") {
+    gregjm::Vector<ThrowingCopy> vec;
+    vec.reserve(4);
+
+    for (int i = 0; i < 4; ++i) {
+        vec.emplace_back(i);
+    }
+
+    ThrowingCopy::copies_until_throw = 2;
+
+    REQUIRE_THROWS_AS(vec.emplace_back(4), std::runtime_error);
+    REQUIRE(vec.size() == 4);
+    REQUIRE(vec.capacity() == 4);
+    REQUIRE(vec[3].value == 3);
+
+    ThrowingCopy::copies_until_throw = -1;
+}
+
+TEST_CASE("Vector works with stateful allocators", "[Vector]") {
+    Arena first;
+    Arena second;
+
+    using VectorT = gregjm::Vector<int, ArenaAllocator<int>>;
+
+    VectorT vec{ ArenaAllocator<int>{ first } };
+
+    for (int i = 0; i < 32; ++i) {
+        vec.push_back(i);
+    }
+
+    REQUIRE(first.used > 0);
+    REQUIRE(vec.get_allocator().arena == &first);
+
+    VectorT other{ ArenaAllocator<int>{ second } };
+    other = std::move(vec);
+
+    REQUIRE(other.get_allocator().arena == &second);
+    REQUIRE(second.used > 0);
+    REQUIRE(other.size() == 32);
+    REQUIRE(other[31] == 31);
+
+    VectorT copy = other;
+
+    REQUIRE(copy.get_allocator().arena == &second);
+}
+
+TEST_CASE("Vector supports bulk ingest", "[Vector]") {
+    gregjm::Vector<gregjm::Pair<int, float>> vec;
+
+    for (int chunk = 0; chunk < 4; ++chunk) {
+        gregjm::Pair<int, float> *const out = vec.reserve_uninitialized(256);
+
+        for (int i = 0; i < 256; ++i) {
+            ::new (static_cast<void*>(out + i))
+                gregjm::Pair<int, float>{ chunk * 256 + i, 0.5f };
+        }
+
+        REQUIRE(vec.append_uninitialized(256) == out);
+    }
+
+    REQUIRE(vec.size() == 1024);
+
+    for (int i = 0; i < 1024; ++i) {
+        REQUIRE(vec[static_cast<std::size_t>(i)].first() == i);
+    }
+}
+
+TEST_CASE("Vector stores small sequences inline", "[Vector]") {
+    using VectorT = gregjm::Vector<std::string, CountingAllocator<std::string>,
+                                   4>;
+
+    CountingAllocator<std::string>::allocations = 0;
+
+    VectorT vec;
+
+    REQUIRE(vec.is_inline());
+    REQUIRE(vec.capacity() == 4);
+
+    for (int i = 0; i < 4; ++i) {
+        vec.push_back(std::to_string(i));
+    }
+
+    REQUIRE(vec.is_inline());
+    REQUIRE(CountingAllocator<std::string>::allocations == 0);
+
+    SECTION("moving an inline vector moves its elements") {
+        VectorT moved = std::move(vec);
+
+        REQUIRE(moved.is_inline());
+        REQUIRE(moved.back() == "3");
+        REQUIRE(vec.empty());
+    }
+
+    SECTION("spilling to the heap") {
+        vec.push_back("4");
+
+        REQUIRE_FALSE(vec.is_inline());
+        REQUIRE(CountingAllocator<std::string>::allocations == 1);
+        REQUIRE(vec[4] == "4");
+        REQUIRE(vec[0] == "0");
+
+        VectorT small{ "a" };
+        swap(vec, small);
+
+        REQUIRE(vec.size() == 1);
+        REQUIRE(vec.is_inline());
+        REQUIRE(small.size() == 5);
+        REQUIRE(small[4] == "4");
+    }
+}
@@ -0,0 +1,146 @@
+#include "zip.hpp"
+#include "pair.hpp"
+#include "span.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using ZipT = gregjm::ZipView<std::vector<int>, std::vector<std::string>>;
+
+static_assert(std::is_same_v<ZipT::reference,
+                             gregjm::Pair<int&, std::string&>>);
+static_assert(std::is_same_v<ZipT::value_type,
+                             gregjm::Pair<int, std::string>>);
+static_assert(std::is_same_v<
+    std::iterator_traits<ZipT::iterator>::iterator_category,
+    std::random_access_iterator_tag
+>);
+static_assert(std::is_same_v<
+    gregjm::ZipView<const std::vector<int>, std::vector<double>>::reference,
+    gregjm::Pair<const int&, double&>
+>);
+
+} // namespace
+
+TEST_CASE("zip refers to both ranges", "[zip]") {
+    std::vector<int> keys{ 3, 1, 2 };
+    std::array<std::string, 4> names{ "three", "one", "two", "unused" };
+
+    auto zipped = gregjm::zip(keys, names);
+
+    REQUIRE(zipped.size() == 3);
+    REQUIRE_FALSE(zipped.empty());
+    REQUIRE(std::distance(zipped.begin(), zipped.end()) == 3);
+    REQUIRE(&zipped[1].first() == &keys[1]);
+    REQUIRE(&zipped[1].second() == &names[1]);
+    REQUIRE(zipped.begin()->second() == "three");
+
+    SECTION("assignment writes through") {
+        zipped[0] = gregjm::Pair<int, std::string>{ 7, "seven" };
+
+        REQUIRE(keys[0] == 7);
+        REQUIRE(names[0] == "seven");
+
+        zipped[1] = zipped[2];
+
+        REQUIRE(keys[1] == 2);
+        REQUIRE(names[1] == "two");
+    }
+
+    SECTION("swap writes through") {
+        using std::swap;
+
+        swap(zipped[0], zipped[2]);
+
+        REQUIRE(keys == std::vector<int>{ 2, 1, 3 });
+        REQUIRE(names[0] == "two");
+        REQUIRE(names[2] == "three");
+    }
+
+    SECTION("values are copied out") {
+        const gregjm::Pair<int, std::string> copy = *zipped.begin();
+        keys[0] = 0;
+
+        REQUIRE(copy.first() == 3);
+        REQUIRE(copy.second() == "three");
+    }
+}
+
+TEST_CASE("standard algorithms rearrange zipped ranges", "[zip]") {
+    std::vector<int> keys;
+    std::vector<std::size_t> positions;
+
+    for (std::size_t i = 0; i < 500; ++i) {
+        keys.push_back(static_cast<int>((i * 37) % 101));
+        positions.push_back(i);
+    }
+
+    const std::vector<int> original_keys = keys;
+    auto zipped = gregjm::zip(keys, positions);
+
+    const auto require_consistent = [&original_keys, &keys, &positions] {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            REQUIRE(original_keys[positions[i]] == keys[i]);
+        }
+    };
+
+    SECTION("std::sort") {
+        std::sort(zipped.begin(), zipped.end());
+
+        REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+        REQUIRE(std::is_sorted(zipped.begin(), zipped.end()));
+        require_consistent();
+    }
+
+    SECTION("std::stable_sort") {
+        std::stable_sort(zipped.begin(), zipped.end(),
+                         [](const auto &lhs, const auto &rhs) {
+            return lhs.first() < rhs.first();
+        });
+
+        REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+        require_consistent();
+
+        for (std::size_t i = 1; i < keys.size(); ++i) {
+            if (keys[i - 1] == keys[i]) {
+                REQUIRE(positions[i - 1] < positions[i]);
+            }
+        }
+    }
+
+    SECTION("std::partition") {
+        const auto is_even = [](const auto &pair) {
+            return pair.first() % 2 == 0;
+        };
+
+        const auto middle = std::partition(zipped.begin(), zipped.end(),
+                                           is_even);
+
+        REQUIRE(std::is_partitioned(zipped.begin(), zipped.end(), is_even));
+        REQUIRE(std::all_of(middle, zipped.end(), [](const auto &pair) {
+            return pair.first() % 2 != 0;
+        }));
+        require_consistent();
+    }
+
+    SECTION("std::reverse over Spans") {
+        gregjm::Span<int> key_span{ keys };
+        gregjm::Span<std::size_t> position_span{ positions };
+        auto span_zipped = gregjm::zip(key_span, position_span);
+
+        std::reverse(span_zipped.begin(), span_zipped.end());
+
+        REQUIRE(positions.front() == 499);
+        require_consistent();
+    }
+}
@@ -0,0 +1,261 @@
+#ifndef GREGJM_THREAD_POOL_HPP
+#define GREGJM_THREAD_POOL_HPP
+
+#include <algorithm> // std::max
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <deque>
+#include <exception> // std::exception_ptr, std::current_exception
+#include <functional> // std::function
+#include <memory> // std::unique_ptr, std::make_unique
+#include <mutex>
+#include <thread>
+#include <utility> // std::forward, std::move
+#include <vector>
+
+namespace gregjm {
+
+// selects the multi-threaded overloads of the sorting algorithms. zero
+// threads means one per hardware thread
+struct parallel_t {
+    std::size_t num_threads = 0;
+};
+
+static constexpr inline parallel_t parallel{ };
+
+class ThreadPool;
+
+namespace detail {
+
+// the pool and queue of the worker running on this thread, if any
+struct WorkerIdentity {
+    const ThreadPool *pool;
+    std::size_t index;
+};
+
+inline thread_local WorkerIdentity current_worker{ nullptr, 0 };
+
+} // namespace detail
+
+// a fixed set of worker threads with one task queue each. workers take the
+// newest task from their own queue and steal the oldest from the others, so
+// recursively split work stays local until another worker runs dry. tasks
+// submitted from outside the pool go to a queue of their own.
+// a pool of n threads starts n - 1 workers: the thread that waits on a
+// TaskGroup runs tasks too, and is the last one
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(std::size_t num_threads = 0)
+    : num_threads_{ num_threads == 0
+                        ? std::max(std::thread::hardware_concurrency(), 1u)
+                        : num_threads } {
+        queues_.reserve(num_threads_);
+
+        for (std::size_t i = 0; i < num_threads_; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+
+        workers_.reserve(num_threads_ - 1);
+
+        for (std::size_t i = 0; i + 1 < num_threads_; ++i) {
+            workers_.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // runs every task already submitted, then joins the workers
+    ~ThreadPool() {
+        {
+            const std::lock_guard<std::mutex> lock{ sleep_mutex_ };
+            stopping_ = true;
+        }
+
+        wake_.notify_all();
+
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+
+        while (try_run_one()) { }
+    }
+
+    std::size_t num_threads() const noexcept {
+        return num_threads_;
+    }
+
+    // f must be copy constructible and must not throw; TaskGroup collects
+    // exceptions instead
+    template <typename F>
+    void submit(F &&f) {
+        Queue &queue = *queues_[own_queue()];
+
+        {
+            const std::lock_guard<std::mutex> lock{ queue.mutex };
+            queue.tasks.emplace_back(std::forward<F>(f));
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock{ sleep_mutex_ };
+            ++queued_;
+        }
+
+        wake_.notify_one();
+    }
+
+    // runs one queued task on the calling thread. returns false if there were
+    // none to run
+    bool try_run_one() {
+        Task task;
+
+        if (!pop(own_queue(), task)) {
+            return false;
+        }
+
+        task();
+
+        return true;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // workers own the first num_threads - 1 queues; every other thread
+    // shares the last one
+    std::size_t own_queue() const noexcept {
+        if (detail::current_worker.pool == this) {
+            return detail::current_worker.index;
+        }
+
+        return num_threads_ - 1;
+    }
+
+    bool pop(std::size_t index, Task &task) {
+        {
+            Queue &own = *queues_[index];
+            const std::lock_guard<std::mutex> lock{ own.mutex };
+
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                --queued_;
+
+                return true;
+            }
+        }
+
+        for (std::size_t i = 1; i < num_threads_; ++i) {
+            Queue &victim = *queues_[(index + i) % num_threads_];
+            const std::lock_guard<std::mutex> lock{ victim.mutex };
+
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                --queued_;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void work(std::size_t index) {
+        detail::current_worker = detail::WorkerIdentity{ this, index };
+
+        while (true) {
+            if (try_run_one()) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{ sleep_mutex_ };
+
+            // a task can be counted before it is in a queue, or popped
+            // before it is counted, so a nonzero count is only a hint
+            wake_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+
+            if (stopping_ && queued_ <= 0) {
+                return;
+            }
+        }
+    }
+
+    std::size_t num_threads_;
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<std::ptrdiff_t> queued_{ 0 };
+    bool stopping_ = false;
+};
+
+// tasks that are waited for together. wait runs queued tasks of the pool,
+// not only this group's, until every task of this group has finished, then
+// rethrows the first exception any of them threw
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &pool) noexcept : pool_{ &pool } { }
+
+    TaskGroup(const TaskGroup&) = delete;
+
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup() {
+        join();
+    }
+
+    // f must be copy constructible
+    template <typename F>
+    void run(F &&f) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+
+        pool_->submit([this, f = std::forward<F>(f)]() mutable {
+            try {
+                f();
+            } catch (...) {
+                const std::lock_guard<std::mutex> lock{ error_mutex_ };
+
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+
+            pending_.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void wait() {
+        join();
+
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+private:
+    void join() noexcept {
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            if (!pool_->try_run_one()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    ThreadPool *pool_;
+    std::atomic<std::size_t> pending_{ 0 };
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,771 @@
+#ifndef GREGJM_TUPLE_HPP
+#define GREGJM_TUPLE_HPP
+
+#include "pair_detail.hpp"
+#include "relocate.hpp"
+#include "uninitialized.hpp"
+
+#include <algorithm> // std::max
+#include <array> // std::array
+#include <cstddef> // std::size_t
+#include <iostream> // std::basic_ostream
+#include <tuple> // std::tuple_size, std::tuple_element, std::tuple
+#include <type_traits>
+#include <utility> // std::forward, std::index_sequence, std::swap
+
+// with 1, every Tuple lays out its elements by decreasing alignment instead
+// of in declaration order, which removes the padding between them. defaults
+// to 0; define it to override, or specialize reorder_tuple_members to choose
+// for one Tuple. the macro and the specializations change the layout of
+// Tuple, so every translation unit of a program must see the same ones; a
+// Tuple passed between objects that disagree is an ODR violation
+#ifndef GREGJM_TUPLE_REORDER_MEMBERS
+#define GREGJM_TUPLE_REORDER_MEMBERS 0
+#endif
+
+namespace gregjm {
+
+template <typename ...Ts>
+class Tuple;
+
+// whether Tuple<Ts...> is laid out by decreasing alignment. only the layout
+// changes: get<I>, comparisons and constructor arguments keep declaration
+// order. elements are constructed and destroyed in layout order, like any
+// other subobjects
+template <typename ...Ts>
+struct reorder_tuple_members
+: std::bool_constant<GREGJM_TUPLE_REORDER_MEMBERS != 0> { };
+
+template <typename ...Ts>
+static constexpr inline bool reorder_tuple_members_v =
+    reorder_tuple_members<Ts...>::value;
+
+namespace detail {
+
+template <typename ...Ts>
+struct TypeList { };
+
+template <template <typename, typename> class Trait, typename Ts,
+          typename Us, typename = void>
+struct AllPairwise : std::false_type { };
+
+template <template <typename, typename> class Trait, typename ...Ts,
+          typename ...Us>
+struct AllPairwise<Trait, TypeList<Ts...>, TypeList<Us...>,
+                   std::enable_if_t<sizeof...(Ts) == sizeof...(Us)>>
+: std::conjunction<Trait<Ts, Us>...> { };
+
+template <template <typename, typename> class Trait, typename Ts,
+          typename Us>
+static constexpr inline bool all_pairwise_v =
+    AllPairwise<Trait, Ts, Us>::value;
+
+template <typename Self, typename ...Us>
+struct IsNotSelf : std::true_type { };
+
+template <typename Self, typename U>
+struct IsNotSelf<Self, U>
+: std::negation<std::is_same<
+      Self, std::remove_cv_t<std::remove_reference_t<U>>
+  >> { };
+
+template <typename T, typename ...Ts>
+constexpr std::size_t index_of() noexcept {
+    constexpr bool matches[] = { std::is_same_v<T, Ts>... };
+
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+
+    return sizeof...(Ts);
+}
+
+// like Pair, an empty element that repeats the type of an earlier element
+// shares that element's storage
+template <std::size_t I, typename List>
+struct TupleElementStorage;
+
+template <std::size_t I, typename ...Ts>
+struct TupleElementStorage<I, TypeList<Ts...>> {
+    using ElementT = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    static constexpr inline std::size_t shared_index =
+        index_of<ElementT, Ts...>();
+
+    static constexpr inline bool is_shared =
+        std::is_empty_v<ElementT> && shared_index < I;
+
+    using TypeT = std::conditional_t<is_shared, Elided<ElementT, I>,
+                                     MemberStorageT<ElementT, I>>;
+};
+
+template <std::size_t I, typename ...Ts>
+using TupleElementStorageT =
+    typename TupleElementStorage<I, TypeList<Ts...>>::TypeT;
+
+template <std::size_t I, typename ...Ts>
+using NthTypeT = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+template <std::size_t I, typename ...Ts>
+constexpr NthTypeT<I, Ts&&...> forward_nth(Ts &&...args) noexcept {
+    return std::get<I>(std::forward_as_tuple(std::forward<Ts>(args)...));
+}
+
+// Order lists the element indices in the order that the elements are laid
+// out. constructor arguments and element<I>() still use the declared
+// indices, so a permuted Order only changes where each element lives
+template <typename Order, typename ...Ts>
+struct TupleStorage;
+
+template <std::size_t ...Is, typename ...Ts>
+struct TupleStorage<std::index_sequence<Is...>, Ts...>
+: TupleElementStorageT<Is, Ts...>... {
+    constexpr TupleStorage() = default;
+
+    template <typename ...Us>
+    constexpr explicit TupleStorage(std::in_place_t, Us &&...args)
+    noexcept((std::is_nothrow_constructible_v<
+        TupleElementStorageT<Is, Ts...>, NthTypeT<Is, Us...>
+    > && ...))
+    : TupleElementStorageT<Is, Ts...>(
+          forward_nth<Is>(std::forward<Us>(args)...)
+      )... { }
+
+    template <typename ...ArgTuples>
+    constexpr TupleStorage(std::piecewise_construct_t, ArgTuples &&...args)
+    noexcept((std::is_nothrow_constructible_v<
+        TupleElementStorageT<Is, Ts...>, FromTupleT,
+        NthTypeT<Is, ArgTuples...>,
+        std::make_index_sequence<std::tuple_size_v<
+            std::remove_reference_t<NthTypeT<Is, ArgTuples...>>
+        >>
+    > && ...))
+    : TupleElementStorageT<Is, Ts...>(
+          from_tuple, forward_nth<Is>(std::forward<ArgTuples>(args)...),
+          std::make_index_sequence<std::tuple_size_v<
+              std::remove_reference_t<NthTypeT<Is, ArgTuples...>>
+          >>{ }
+      )... { }
+
+    template <std::size_t I>
+    constexpr inline NthTypeT<I, Ts...>& element() noexcept {
+        using ElementStorage = TupleElementStorage<I, TypeList<Ts...>>;
+
+        if constexpr (ElementStorage::is_shared) {
+            return element<ElementStorage::shared_index>();
+        } else {
+            return static_cast<typename ElementStorage::TypeT&>(*this)
+                .as_base();
+        }
+    }
+
+    template <std::size_t I>
+    constexpr inline const NthTypeT<I, Ts...>& element() const noexcept {
+        using ElementStorage = TupleElementStorage<I, TypeList<Ts...>>;
+
+        if constexpr (ElementStorage::is_shared) {
+            return element<ElementStorage::shared_index>();
+        } else {
+            return static_cast<const typename ElementStorage::TypeT&>(*this)
+                .as_base();
+        }
+    }
+};
+
+// a stable sort of the indices of Alignments by decreasing alignment. since
+// every size is a multiple of its alignment, laying elements out in this
+// order leaves no padding between them
+template <std::size_t ...Alignments>
+constexpr std::array<std::size_t, sizeof...(Alignments)>
+alignment_order() noexcept {
+    constexpr std::array<std::size_t, sizeof...(Alignments)> alignments{
+        Alignments...
+    };
+    std::array<std::size_t, sizeof...(Alignments)> order{ };
+
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        std::size_t j = i;
+
+        for (; j > 0 && alignments[order[j - 1]] < alignments[i]; --j) {
+            order[j] = order[j - 1];
+        }
+
+        order[j] = i;
+    }
+
+    return order;
+}
+
+template <typename List, typename Indices>
+struct AlignmentOrder;
+
+template <typename ...Ts, std::size_t ...Is>
+struct AlignmentOrder<TypeList<Ts...>, std::index_sequence<Is...>> {
+    static constexpr inline std::array<std::size_t, sizeof...(Ts)> order =
+        alignment_order<alignof(TupleElementStorageT<Is, Ts...>)...>();
+
+    using type = std::index_sequence<order[Is]...>;
+};
+
+// the layout order of Ts that minimizes padding
+template <typename ...Ts>
+using AlignmentOrderT = typename AlignmentOrder<
+    TypeList<Ts...>, std::index_sequence_for<Ts...>
+>::type;
+
+template <typename ...Ts>
+using TupleOrderT = std::conditional_t<reorder_tuple_members_v<Ts...>,
+                                       AlignmentOrderT<Ts...>,
+                                       std::index_sequence_for<Ts...>>;
+
+template <typename ...Ts>
+using TupleStorageT = TupleStorage<TupleOrderT<Ts...>, Ts...>;
+
+} // namespace detail
+
+template <typename ...Ts>
+class Tuple : private detail::TupleStorageT<Ts...> {
+private:
+    using StorageT = detail::TupleStorageT<Ts...>;
+
+    template <std::size_t I>
+    using ElementT = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    template <std::size_t I>
+    using ElementStorage = detail::TupleElementStorage<I,
+                                                       detail::TypeList<Ts...>>;
+
+    template <typename ...Us>
+    friend class Tuple;
+
+public:
+    constexpr Tuple()
+    noexcept((std::is_nothrow_default_constructible_v<Ts> && ...)) = default;
+
+    // default-initializes every element; unlike Tuple{ }, this leaves trivial
+    // elements indeterminate
+    template <bool B = (std::is_default_constructible_v<Ts> && ...),
+              typename = std::enable_if_t<B>>
+    explicit Tuple(uninitialized_t)
+    noexcept((std::is_nothrow_default_constructible_v<Ts> && ...)) { }
+
+    template <typename ...Us,
+              typename = std::enable_if_t<
+                  sizeof...(Us) != 0
+                  && detail::IsNotSelf<Tuple, Us...>::value
+                  && detail::all_pairwise_v<std::is_constructible,
+                                            detail::TypeList<Ts...>,
+                                            detail::TypeList<Us&&...>>
+              >>
+    constexpr Tuple(Us &&...args)
+    noexcept(detail::all_pairwise_v<std::is_nothrow_constructible,
+                                    detail::TypeList<Ts...>,
+                                    detail::TypeList<Us&&...>>)
+    : StorageT(std::in_place, std::forward<Us>(args)...) { }
+
+    template <typename ...Us,
+              typename = std::enable_if_t<
+                  detail::all_pairwise_v<std::is_constructible,
+                                         detail::TypeList<Ts...>,
+                                         detail::TypeList<const Us&...>>
+              >>
+    explicit constexpr Tuple(const Tuple<Us...> &other)
+    noexcept(detail::all_pairwise_v<std::is_nothrow_constructible,
+                                    detail::TypeList<Ts...>,
+                                    detail::TypeList<const Us&...>>)
+    : Tuple(other, std::index_sequence_for<Us...>{ }) { }
+
+    template <typename ...Us,
+              typename = std::enable_if_t<
+                  detail::all_pairwise_v<std::is_constructible,
+                                         detail::TypeList<Ts...>,
+                                         detail::TypeList<Us&&...>>
+              >>
+    explicit constexpr Tuple(Tuple<Us...> &&other)
+    noexcept(detail::all_pairwise_v<std::is_nothrow_constructible,
+                                    detail::TypeList<Ts...>,
+                                    detail::TypeList<Us&&...>>)
+    : Tuple(std::move(other), std::index_sequence_for<Us...>{ }) { }
+
+    template <typename ...ArgTuples,
+              typename = std::enable_if_t<
+                  sizeof...(ArgTuples) == sizeof...(Ts)
+              >,
+              typename = std::void_t<decltype(
+                  std::tuple_size<std::remove_reference_t<ArgTuples>>::value
+              )...>>
+    constexpr Tuple(std::piecewise_construct_t, ArgTuples &&...args)
+    noexcept(std::is_nothrow_constructible_v<
+        StorageT, std::piecewise_construct_t, ArgTuples...
+    >)
+    : StorageT(std::piecewise_construct, std::forward<ArgTuples>(args)...)
+    { }
+
+    template <typename ...Us,
+              typename = std::enable_if_t<
+                  detail::all_pairwise_v<std::is_assignable,
+                                         detail::TypeList<Ts&...>,
+                                         detail::TypeList<const Us&...>>
+              >>
+    constexpr Tuple& operator=(const Tuple<Us...> &other)
+    noexcept(detail::all_pairwise_v<std::is_nothrow_assignable,
+                                    detail::TypeList<Ts&...>,
+                                    detail::TypeList<const Us&...>>) {
+        assign(other, std::index_sequence_for<Ts...>{ });
+
+        return *this;
+    }
+
+    template <typename ...Us,
+              typename = std::enable_if_t<
+                  detail::all_pairwise_v<std::is_assignable,
+                                         detail::TypeList<Ts&...>,
+                                         detail::TypeList<Us&&...>>
+              >>
+    constexpr Tuple& operator=(Tuple<Us...> &&other)
+    noexcept(detail::all_pairwise_v<std::is_nothrow_assignable,
+                                    detail::TypeList<Ts&...>,
+                                    detail::TypeList<Us&&...>>) {
+        assign(std::move(other), std::index_sequence_for<Ts...>{ });
+
+        return *this;
+    }
+
+    template <std::size_t I>
+    constexpr inline ElementT<I>& get() & noexcept {
+        return StorageT::template element<I>();
+    }
+
+    template <std::size_t I>
+    constexpr inline const ElementT<I>& get() const & noexcept {
+        return StorageT::template element<I>();
+    }
+
+    template <std::size_t I>
+    constexpr inline ElementT<I>&& get() && noexcept {
+        return std::forward<ElementT<I>>(get<I>());
+    }
+
+    template <std::size_t I>
+    constexpr inline const ElementT<I>&& get() const && noexcept {
+        return std::forward<const ElementT<I>>(get<I>());
+    }
+
+    constexpr void swap(Tuple &other)
+    noexcept((std::is_nothrow_swappable_v<Ts> && ...)) {
+        swap_elements(other, std::index_sequence_for<Ts...>{ });
+    }
+
+    template <typename ...Us,
+              typename = std::enable_if_t<
+                  detail::all_pairwise_v<std::is_swappable_with,
+                                         detail::TypeList<Ts&...>,
+                                         detail::TypeList<Us&...>>
+              >>
+    constexpr void swap(Tuple<Us...> &other)
+    noexcept(detail::all_pairwise_v<std::is_nothrow_swappable_with,
+                                    detail::TypeList<Ts&...>,
+                                    detail::TypeList<Us&...>>) {
+        swap_elements(other, std::index_sequence_for<Ts...>{ });
+    }
+
+private:
+    template <typename Other, std::size_t ...Is>
+    constexpr Tuple(Other &&other, std::index_sequence<Is...>)
+    noexcept(noexcept(StorageT(
+        std::in_place, std::forward<Other>(other).template get<Is>()...
+    )))
+    : StorageT(std::in_place, std::forward<Other>(other).template get<Is>()...)
+    { }
+
+    template <typename Other, std::size_t ...Is>
+    constexpr void assign(Other &&other, std::index_sequence<Is...>) {
+        ((get<Is>() = std::forward<Other>(other).template get<Is>()), ...);
+    }
+
+    template <typename Other, std::size_t ...Is>
+    constexpr void swap_elements(Other &other, std::index_sequence<Is...>) {
+        (swap_element<Is>(other), ...);
+    }
+
+    template <std::size_t I, typename Other>
+    constexpr void swap_element(Other &other) {
+        if constexpr (!ElementStorage<I>::is_shared) {
+            detail::swap_values(get<I>(), other.template get<I>());
+        }
+    }
+};
+
+template <std::size_t I, typename ...Ts>
+constexpr inline std::tuple_element_t<I, std::tuple<Ts...>>&
+get(Tuple<Ts...> &tuple) noexcept {
+    return tuple.template get<I>();
+}
+
+template <std::size_t I, typename ...Ts>
+constexpr inline const std::tuple_element_t<I, std::tuple<Ts...>>&
+get(const Tuple<Ts...> &tuple) noexcept {
+    return tuple.template get<I>();
+}
+
+template <std::size_t I, typename ...Ts>
+constexpr inline std::tuple_element_t<I, std::tuple<Ts...>>&&
+get(Tuple<Ts...> &&tuple) noexcept {
+    return std::move(tuple).template get<I>();
+}
+
+template <std::size_t I, typename ...Ts>
+constexpr inline const std::tuple_element_t<I, std::tuple<Ts...>>&&
+get(const Tuple<Ts...> &&tuple) noexcept {
+    return std::move(tuple).template get<I>();
+}
+
+namespace detail {
+
+template <typename T, typename U, typename = void>
+struct IsTupleEqualityComparable : std::false_type { };
+
+template <typename ...Ts, typename ...Us>
+struct IsTupleEqualityComparable<
+    Tuple<Ts...>, Tuple<Us...>,
+    std::enable_if_t<sizeof...(Ts) == sizeof...(Us)>
+> : std::conjunction<IsEqualityComparable<Ts, Us>...> { };
+
+template <typename T, typename U, typename = void>
+struct IsTupleLessThanComparable : std::false_type { };
+
+template <typename ...Ts, typename ...Us>
+struct IsTupleLessThanComparable<
+    Tuple<Ts...>, Tuple<Us...>,
+    std::enable_if_t<sizeof...(Ts) == sizeof...(Us)>
+> : std::conjunction<IsLessThanComparable<Ts, Us>...> { };
+
+template <typename T, typename U>
+static constexpr inline bool is_tuple_equality_comparable_v =
+    IsTupleEqualityComparable<T, U>::value;
+
+template <typename T, typename U>
+static constexpr inline bool is_tuple_less_than_comparable_v =
+    IsTupleLessThanComparable<T, U>::value;
+
+template <typename T, typename U, std::size_t ...Is>
+constexpr bool tuple_equal(const T &lhs, const U &rhs,
+                           std::index_sequence<Is...>)
+noexcept(noexcept(((gregjm::get<Is>(lhs) == gregjm::get<Is>(rhs)) && ...))) {
+    return ((gregjm::get<Is>(lhs) == gregjm::get<Is>(rhs)) && ...);
+}
+
+template <std::size_t I, std::size_t N, typename T, typename U>
+constexpr bool tuple_less(const T &lhs, const U &rhs) {
+    if constexpr (I == N) {
+        return false;
+    } else {
+        if constexpr (I + 1 == N) {
+            return gregjm::get<I>(lhs) < gregjm::get<I>(rhs);
+        } else {
+            if (const int result = compare_three_way(gregjm::get<I>(lhs),
+                                                     gregjm::get<I>(rhs));
+                result != 0) {
+                return result < 0;
+            }
+
+            return tuple_less<I + 1, N>(lhs, rhs);
+        }
+    }
+}
+
+template <typename T, typename U, typename Indices>
+struct IsNothrowTupleLessThanComparable;
+
+template <typename T, typename U, std::size_t ...Is>
+struct IsNothrowTupleLessThanComparable<T, U, std::index_sequence<Is...>>
+: std::bool_constant<(
+    is_nothrow_three_way_comparable_v<std::tuple_element_t<Is, T>,
+                                      std::tuple_element_t<Is, U>>
+    && ...
+)> { };
+
+template <typename CharT, typename Traits, typename T, std::size_t ...Is>
+std::basic_ostream<CharT, Traits>&
+print_tuple(std::basic_ostream<CharT, Traits> &os, const T &tuple,
+            std::index_sequence<Is...>) {
+    os << '(';
+    ((os << (Is == 0 ? "" : ", ") << gregjm::get<Is>(tuple)), ...);
+
+    return os << ')';
+}
+
+} // namespace detail
+
+template <typename CharT, typename Traits, typename ...Ts>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits> &os, const Tuple<Ts...> &tuple) {
+    return detail::print_tuple(os, tuple, std::index_sequence_for<Ts...>{ });
+}
+
+template <typename ...Ts>
+constexpr inline void swap(Tuple<Ts...> &lhs, Tuple<Ts...> &rhs)
+noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <typename ...Ts, typename ...Us>
+constexpr inline void swap(Tuple<Ts...> &lhs, Tuple<Us...> &rhs)
+noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <typename ...Ts, typename ...Us,
+          typename = std::enable_if_t<
+              detail::is_tuple_equality_comparable_v<Tuple<Ts...>,
+                                                     Tuple<Us...>>
+          >>
+constexpr inline bool operator==(
+    const Tuple<Ts...> &lhs, const Tuple<Us...> &rhs
+) noexcept(noexcept(detail::tuple_equal(lhs, rhs,
+                                        std::index_sequence_for<Ts...>{ }))) {
+    return detail::tuple_equal(lhs, rhs, std::index_sequence_for<Ts...>{ });
+}
+
+template <typename ...Ts, typename ...Us,
+          typename = std::enable_if_t<
+              detail::is_tuple_equality_comparable_v<Tuple<Ts...>,
+                                                     Tuple<Us...>>
+          >>
+constexpr inline bool operator!=(
+    const Tuple<Ts...> &lhs, const Tuple<Us...> &rhs
+) noexcept(noexcept(lhs == rhs)) {
+    return !(lhs == rhs);
+}
+
+template <typename ...Ts, typename ...Us,
+          typename = std::enable_if_t<
+              detail::is_tuple_less_than_comparable_v<Tuple<Ts...>,
+                                                      Tuple<Us...>>
+          >>
+constexpr inline bool operator<(
+    const Tuple<Ts...> &lhs, const Tuple<Us...> &rhs
+) noexcept(detail::IsNothrowTupleLessThanComparable<
+               Tuple<Ts...>, Tuple<Us...>, std::index_sequence_for<Ts...>
+           >::value) {
+    return detail::tuple_less<0, sizeof...(Ts)>(lhs, rhs);
+}
+
+template <typename ...Ts, typename ...Us,
+          typename = std::enable_if_t<
+              detail::is_tuple_less_than_comparable_v<Tuple<Ts...>,
+                                                      Tuple<Us...>>
+          >>
+constexpr inline bool operator<=(
+    const Tuple<Ts...> &lhs, const Tuple<Us...> &rhs
+) noexcept(noexcept(rhs < lhs)) {
+    return !(rhs < lhs);
+}
+
+template <typename ...Ts, typename ...Us,
+          typename = std::enable_if_t<
+              detail::is_tuple_less_than_comparable_v<Tuple<Ts...>,
+                                                      Tuple<Us...>>
+          >>
+constexpr inline bool operator>(
+    const Tuple<Ts...> &lhs, const Tuple<Us...> &rhs
+) noexcept(noexcept(rhs < lhs)) {
+    return rhs < lhs;
+}
+
+template <typename ...Ts, typename ...Us,
+          typename = std::enable_if_t<
+              detail::is_tuple_less_than_comparable_v<Tuple<Ts...>,
+                                                      Tuple<Us...>>
+          >>
+constexpr inline bool operator>=(
+    const Tuple<Ts...> &lhs, const Tuple<Us...> &rhs
+) noexcept(noexcept(lhs < rhs)) {
+    return !(lhs < rhs);
+}
+
+template <typename ...Ts>
+constexpr gregjm::Tuple<detail::UnwrapDecayT<Ts>...>
+make_tuple(Ts &&...args) {
+    using TupleT = gregjm::Tuple<detail::UnwrapDecayT<Ts>...>;
+
+    return TupleT{ std::forward<Ts>(args)... };
+}
+
+// where one element of a Tuple is placed. an element that takes no space,
+// such as an empty element, has offset and size 0
+struct ElementLayout {
+    std::size_t index;
+    std::size_t offset;
+    std::size_t size;
+    std::size_t padding;
+};
+
+// the elements of a Tuple in the order they are laid out, each with the
+// padding in front of it, and the padding after the last one
+template <std::size_t N>
+struct TupleLayout {
+    std::array<ElementLayout, N> elements;
+    std::size_t size;
+    std::size_t tail_padding;
+};
+
+namespace detail {
+
+constexpr std::size_t align_up(std::size_t offset,
+                               std::size_t alignment) noexcept {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// models how the Itanium ABI places the element bases in order: empty bases
+// at offset 0 and every other base at the next offset suited to its
+// alignment. the model assumes that no element's tail padding is reused,
+// which holds for elements of trivial types
+template <std::size_t N>
+constexpr TupleLayout<N> model_layout(
+    const std::array<std::size_t, N> &order,
+    const std::array<std::size_t, N> &sizes,
+    const std::array<std::size_t, N> &alignments,
+    const std::array<bool, N> &empty
+) noexcept {
+    TupleLayout<N> layout{ };
+    std::size_t end = 0;
+    std::size_t alignment = 1;
+
+    for (std::size_t i = 0; i < N; ++i) {
+        const std::size_t index = order[i];
+        ElementLayout &element = layout.elements[i];
+        element.index = index;
+
+        if (empty[index]) {
+            continue;
+        }
+
+        element.offset = align_up(end, alignments[index]);
+        element.size = sizes[index];
+        element.padding = element.offset - end;
+        end = element.offset + element.size;
+        alignment = std::max(alignment, alignments[index]);
+    }
+
+    layout.size = align_up(std::max(end, std::size_t{ 1 }), alignment);
+    layout.tail_padding = layout.size - end;
+
+    return layout;
+}
+
+template <typename T, typename Indices>
+struct TupleLayouts;
+
+template <typename ...Ts, std::size_t ...Is>
+struct TupleLayouts<Tuple<Ts...>, std::index_sequence<Is...>> {
+    static constexpr inline std::size_t size = sizeof...(Ts);
+
+    static constexpr inline std::array<std::size_t, size> sizes{
+        sizeof(TupleElementStorageT<Is, Ts...>)...
+    };
+
+    static constexpr inline std::array<std::size_t, size> alignments{
+        alignof(TupleElementStorageT<Is, Ts...>)...
+    };
+
+    static constexpr inline std::array<bool, size> empty{
+        std::is_empty_v<TupleElementStorageT<Is, Ts...>>...
+    };
+
+    static constexpr inline std::array<std::size_t, size> declared_order{
+        Is...
+    };
+
+    static constexpr inline std::array<std::size_t, size> reordered_order =
+        AlignmentOrder<TypeList<Ts...>, std::index_sequence<Is...>>::order;
+};
+
+template <typename CharT, typename Traits, std::size_t N>
+void print_layout(std::basic_ostream<CharT, Traits> &os,
+                  const TupleLayout<N> &layout) {
+    for (const ElementLayout &element : layout.elements) {
+        os << "  [" << element.index << "] offset " << element.offset
+           << ", size " << element.size;
+
+        if (element.padding != 0) {
+            os << ", " << element.padding << " bytes of padding before";
+        }
+
+        os << '\n';
+    }
+
+    if (layout.tail_padding != 0) {
+        os << "  " << layout.tail_padding << " bytes of tail padding\n";
+    }
+}
+
+} // namespace detail
+
+// the layouts of a Tuple in declaration order and by decreasing alignment,
+// as modeled at compile time; current is the one that the Tuple uses
+template <typename T>
+struct tuple_layout;
+
+template <typename ...Ts>
+struct tuple_layout<Tuple<Ts...>> {
+private:
+    using LayoutsT = detail::TupleLayouts<Tuple<Ts...>,
+                                          std::index_sequence_for<Ts...>>;
+
+public:
+    static constexpr inline TupleLayout<sizeof...(Ts)> declared =
+        detail::model_layout(LayoutsT::declared_order, LayoutsT::sizes,
+                             LayoutsT::alignments, LayoutsT::empty);
+
+    static constexpr inline TupleLayout<sizeof...(Ts)> reordered =
+        detail::model_layout(LayoutsT::reordered_order, LayoutsT::sizes,
+                             LayoutsT::alignments, LayoutsT::empty);
+
+    static constexpr inline bool is_reordered =
+        reorder_tuple_members_v<Ts...>;
+
+    static constexpr inline TupleLayout<sizeof...(Ts)> current =
+        is_reordered ? reordered : declared;
+};
+
+// prints the offset, size and leading padding of every element of Tuple T
+// in both layouts, and which of the two T uses
+template <typename T, typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+layout_report(std::basic_ostream<CharT, Traits> &os) {
+    using LayoutT = tuple_layout<T>;
+
+    os << "sizeof: " << sizeof(T) << '\n';
+    os << "declared order: " << LayoutT::declared.size << " bytes"
+       << (LayoutT::is_reordered ? "" : " (current)") << '\n';
+    detail::print_layout(os, LayoutT::declared);
+    os << "by alignment: " << LayoutT::reordered.size << " bytes"
+       << (LayoutT::is_reordered ? " (current)" : "") << '\n';
+    detail::print_layout(os, LayoutT::reordered);
+
+    return os;
+}
+
+template <typename ...Ts>
+struct is_trivially_relocatable<Tuple<Ts...>>
+: std::bool_constant<(is_trivially_relocatable_v<Ts> && ...)> { };
+
+} // namespace gregjm
+
+namespace std {
+
+template <typename ...Ts>
+struct tuple_size<gregjm::Tuple<Ts...>>
+: std::integral_constant<std::size_t, sizeof...(Ts)> { };
+
+template <std::size_t I, typename ...Ts>
+struct tuple_element<I, gregjm::Tuple<Ts...>> {
+    using type = std::tuple_element_t<I, std::tuple<Ts...>>;
+};
+
+} // namespace std
+
+#endif
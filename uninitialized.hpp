@@ -0,0 +1,86 @@
+#ifndef GREGJM_UNINITIALIZED_HPP
+#define GREGJM_UNINITIALIZED_HPP
+
+#include "relocate.hpp"
+
+#include <cstddef> // std::size_t
+#include <memory> // std::allocator_traits, std::unique_ptr
+#include <new> // ::new
+#include <type_traits>
+#include <utility> // std::forward
+
+namespace gregjm {
+
+// selects the constructor of Pair and Tuple that default-initializes every
+// member, so trivial members are left indeterminate instead of zeroed
+struct uninitialized_t {
+    explicit constexpr uninitialized_t() noexcept = default;
+};
+
+static constexpr inline uninitialized_t uninitialized{ };
+
+// like std::make_unique_for_overwrite: allocates size default-initialized
+// objects, so arrays of trivial types are not zero filled first
+template <typename T>
+std::unique_ptr<T[]> make_uninitialized_array(std::size_t size) {
+    return std::unique_ptr<T[]>{ new T[size] };
+}
+
+// adapts Alloc so that construct(p) with no arguments default-initializes
+// instead of value-initializing. with it, std::vector<T>(n) and resize(n) do
+// not zero fill arrays of trivial types; all other constructions are
+// forwarded to Alloc
+template <typename T, typename Alloc = std::allocator<T>>
+class DefaultInitAllocator : public Alloc {
+private:
+    using Traits = std::allocator_traits<Alloc>;
+
+public:
+    template <typename U>
+    struct rebind {
+        using other = DefaultInitAllocator<
+            U, typename Traits::template rebind_alloc<U>
+        >;
+    };
+
+    using Alloc::Alloc;
+
+    DefaultInitAllocator() = default;
+
+    template <typename U, typename A>
+    DefaultInitAllocator(const DefaultInitAllocator<U, A> &other)
+    noexcept(std::is_nothrow_constructible_v<Alloc, const A&>)
+    : Alloc(static_cast<const A&>(other)) { }
+
+    template <typename U>
+    void construct(U *ptr)
+    noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new (static_cast<void*>(ptr)) U;
+    }
+
+    template <typename U, typename ...Args>
+    void construct(U *ptr, Args &&...args) {
+        Traits::construct(static_cast<Alloc&>(*this), ptr,
+                          std::forward<Args>(args)...);
+    }
+};
+
+template <typename T, typename A, typename U, typename B>
+bool operator==(const DefaultInitAllocator<T, A> &lhs,
+                const DefaultInitAllocator<U, B> &rhs) noexcept {
+    return static_cast<const A&>(lhs) == static_cast<const B&>(rhs);
+}
+
+template <typename T, typename A, typename U, typename B>
+bool operator!=(const DefaultInitAllocator<T, A> &lhs,
+                const DefaultInitAllocator<U, B> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc>
+struct is_trivially_relocatable<DefaultInitAllocator<T, Alloc>>
+: is_trivially_relocatable<Alloc> { };
+
+} // namespace gregjm
+
+#endif
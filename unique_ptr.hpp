@@ -0,0 +1,363 @@
+#ifndef GREGJM_UNIQUE_PTR_HPP
+#define GREGJM_UNIQUE_PTR_HPP
+
+#include "pair.hpp"
+
+#include <cstddef> // std::size_t, std::nullptr_t
+#include <tuple> // std::tuple, std::forward_as_tuple
+#include <type_traits>
+#include <utility> // std::forward, std::move, std::declval, std::swap
+
+namespace gregjm {
+
+template <typename T>
+struct DefaultDelete {
+    constexpr DefaultDelete() noexcept = default;
+
+    template <typename U,
+              typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    constexpr DefaultDelete(const DefaultDelete<U>&) noexcept { }
+
+    void operator()(T *ptr) const noexcept {
+        static_assert(sizeof(T) > 0, "cannot delete an incomplete type");
+
+        delete ptr;
+    }
+};
+
+template <typename T>
+struct DefaultDelete<T[]> {
+    constexpr DefaultDelete() noexcept = default;
+
+    template <typename U,
+              typename = std::enable_if_t<std::is_convertible_v<U(*)[],
+                                                                T(*)[]>>>
+    constexpr DefaultDelete(const DefaultDelete<U[]>&) noexcept { }
+
+    void operator()(T *ptr) const noexcept {
+        static_assert(sizeof(T) > 0, "cannot delete an incomplete type");
+
+        delete[] ptr;
+    }
+};
+
+namespace detail {
+
+template <typename T, typename Deleter, typename = void>
+struct UniquePtrPointer {
+    using type = T*;
+};
+
+template <typename T, typename Deleter>
+struct UniquePtrPointer<
+    T, Deleter, std::void_t<typename std::remove_reference_t<Deleter>::pointer>
+> {
+    using type = typename std::remove_reference_t<Deleter>::pointer;
+};
+
+template <typename T, typename Deleter>
+using UniquePtrPointerT = typename UniquePtrPointer<T, Deleter>::type;
+
+// a deleter held by reference can only be initialized from an lvalue of that
+// exact type; otherwise any deleter that converts will do
+template <typename Deleter, typename E>
+static constexpr inline bool is_deleter_convertible_v =
+    std::is_reference_v<Deleter> ? std::is_same_v<Deleter, E>
+                                 : std::is_convertible_v<E, Deleter>;
+
+// the raw pointers that UniquePtr<T> takes ownership of: anything that
+// converts to Pointer
+template <typename T, typename Pointer, typename U>
+static constexpr inline bool is_unique_ptr_source_v =
+    std::is_convertible_v<U, Pointer>;
+
+// like std::unique_ptr<T[]>, an array only takes Pointer, nullptr, or a U*
+// where U(*)[] converts to T(*)[]. a Derived* would convert to Base*, but
+// delete[] of a Derived array through Base* is undefined
+template <typename T, typename Pointer, typename U>
+static constexpr inline bool is_unique_ptr_source_v<T[], Pointer, U> =
+    std::is_same_v<U, Pointer> || std::is_same_v<U, std::nullptr_t>
+    || (std::is_same_v<Pointer, T*> && std::is_pointer_v<U>
+        && std::is_convertible_v<std::remove_pointer_t<U>(*)[], T(*)[]>);
+
+// everything UniquePtr and UniquePtr<T[]> have in common. the deleter is the
+// first member of a Pair, so a stateless deleter takes no space
+template <typename T, typename Pointer, typename Deleter>
+class UniquePtrImpl {
+public:
+    using pointer = Pointer;
+    using deleter_type = Deleter;
+
+    static constexpr inline bool is_nothrow_delete =
+        noexcept(std::declval<Deleter&>()(std::declval<Pointer>()));
+
+    template <typename D = Deleter,
+              std::enable_if_t<std::is_default_constructible_v<D>
+                               && !std::is_pointer_v<D>, int> = 0>
+    constexpr UniquePtrImpl()
+    noexcept(std::is_nothrow_default_constructible_v<Deleter>)
+    : data_{ } { }
+
+    template <typename D = Deleter,
+              std::enable_if_t<std::is_default_constructible_v<D>
+                               && !std::is_pointer_v<D>, int> = 0>
+    constexpr UniquePtrImpl(std::nullptr_t)
+    noexcept(std::is_nothrow_default_constructible_v<Deleter>)
+    : data_{ } { }
+
+    template <typename U, typename D = Deleter,
+              std::enable_if_t<is_unique_ptr_source_v<T, Pointer, U>
+                               && std::is_default_constructible_v<D>
+                               && !std::is_pointer_v<D>, int> = 0>
+    constexpr explicit UniquePtrImpl(U ptr)
+    noexcept(std::is_nothrow_default_constructible_v<Deleter>)
+    : data_(std::piecewise_construct, std::tuple<>{ },
+            std::forward_as_tuple(ptr)) { }
+
+    template <typename U, typename D,
+              std::enable_if_t<is_unique_ptr_source_v<T, Pointer, U>
+                               && std::is_constructible_v<Deleter, D>,
+                               int> = 0>
+    constexpr UniquePtrImpl(U ptr, D &&deleter)
+    noexcept(std::is_nothrow_constructible_v<Deleter, D>)
+    : data_(std::forward<D>(deleter), ptr) { }
+
+    UniquePtrImpl(const UniquePtrImpl &other) = delete;
+
+    constexpr UniquePtrImpl(UniquePtrImpl &&other)
+    noexcept(std::is_nothrow_move_constructible_v<Deleter>)
+    : data_(std::forward<Deleter>(other.get_deleter()), other.release()) { }
+
+    ~UniquePtrImpl() {
+        reset();
+    }
+
+    UniquePtrImpl& operator=(const UniquePtrImpl &other) = delete;
+
+    constexpr UniquePtrImpl& operator=(UniquePtrImpl &&other)
+    noexcept(std::is_nothrow_move_assignable_v<Deleter> && is_nothrow_delete) {
+        reset(other.release());
+        get_deleter() = std::forward<Deleter>(other.get_deleter());
+
+        return *this;
+    }
+
+    constexpr UniquePtrImpl& operator=(std::nullptr_t)
+    noexcept(is_nothrow_delete) {
+        reset();
+
+        return *this;
+    }
+
+    constexpr Pointer get() const noexcept {
+        return data_.second();
+    }
+
+    constexpr Deleter& get_deleter() noexcept {
+        return data_.first();
+    }
+
+    constexpr const Deleter& get_deleter() const noexcept {
+        return data_.first();
+    }
+
+    constexpr explicit operator bool() const noexcept {
+        return get() != nullptr;
+    }
+
+    constexpr Pointer release() noexcept {
+        const Pointer ptr = get();
+        data_.second() = nullptr;
+
+        return ptr;
+    }
+
+    // the stored pointer is replaced before the old one is deleted, so a
+    // deleter that reaches back into this object sees the new state
+    template <typename U = Pointer,
+              typename = std::enable_if_t<is_unique_ptr_source_v<T, Pointer,
+                                                                 U>>>
+    constexpr void reset(U ptr = U()) noexcept(is_nothrow_delete) {
+        const Pointer old = get();
+        data_.second() = ptr;
+
+        if (old != nullptr) {
+            get_deleter()(old);
+        }
+    }
+
+    constexpr void swap(UniquePtrImpl &other)
+    noexcept(std::is_nothrow_swappable_v<Deleter>) {
+        using std::swap;
+
+        swap(data_, other.data_);
+    }
+
+private:
+    Pair<Deleter, Pointer> data_;
+};
+
+} // namespace detail
+
+// sole owner of an object, destroyed through Deleter. when Deleter is
+// stateless, a UniquePtr is the size of a pointer whether or not the
+// standard library's std::unique_ptr makes the same guarantee
+template <typename T, typename Deleter = DefaultDelete<T>>
+class UniquePtr
+: public detail::UniquePtrImpl<T, detail::UniquePtrPointerT<T, Deleter>,
+                               Deleter> {
+private:
+    using Impl = detail::UniquePtrImpl<
+        T, detail::UniquePtrPointerT<T, Deleter>, Deleter
+    >;
+
+public:
+    using typename Impl::pointer;
+    using typename Impl::deleter_type;
+    using element_type = T;
+
+    using Impl::Impl;
+    using Impl::operator=;
+
+    template <typename U, typename E,
+              std::enable_if_t<
+                  std::is_convertible_v<typename UniquePtr<U, E>::pointer,
+                                        pointer>
+                  && !std::is_array_v<U>
+                  && detail::is_deleter_convertible_v<Deleter, E>,
+                  int
+              > = 0>
+    constexpr UniquePtr(UniquePtr<U, E> &&other)
+    noexcept(std::is_nothrow_constructible_v<Deleter, E&&>)
+    : Impl(other.release(), std::forward<E>(other.get_deleter())) { }
+
+    template <typename U, typename E,
+              std::enable_if_t<
+                  std::is_convertible_v<typename UniquePtr<U, E>::pointer,
+                                        pointer>
+                  && !std::is_array_v<U>
+                  && std::is_assignable_v<Deleter&, E&&>,
+                  int
+              > = 0>
+    constexpr UniquePtr& operator=(UniquePtr<U, E> &&other)
+    noexcept(std::is_nothrow_assignable_v<Deleter&, E&&>
+             && Impl::is_nothrow_delete) {
+        this->reset(other.release());
+        this->get_deleter() = std::forward<E>(other.get_deleter());
+
+        return *this;
+    }
+
+    constexpr std::add_lvalue_reference_t<T> operator*() const
+    noexcept(noexcept(*std::declval<pointer>())) {
+        return *this->get();
+    }
+
+    constexpr pointer operator->() const noexcept {
+        return this->get();
+    }
+};
+
+template <typename T, typename Deleter>
+class UniquePtr<T[], Deleter>
+: public detail::UniquePtrImpl<T[], detail::UniquePtrPointerT<T, Deleter>,
+                               Deleter> {
+private:
+    using Impl = detail::UniquePtrImpl<
+        T[], detail::UniquePtrPointerT<T, Deleter>, Deleter
+    >;
+
+public:
+    using typename Impl::pointer;
+    using typename Impl::deleter_type;
+    using element_type = T;
+
+    using Impl::Impl;
+    using Impl::operator=;
+
+    constexpr T& operator[](std::size_t index) const noexcept {
+        return this->get()[index];
+    }
+};
+
+template <typename T, typename Deleter>
+constexpr void swap(UniquePtr<T, Deleter> &lhs, UniquePtr<T, Deleter> &rhs)
+noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <typename T, typename D, typename U, typename E>
+constexpr bool operator==(const UniquePtr<T, D> &lhs,
+                          const UniquePtr<U, E> &rhs) noexcept {
+    return lhs.get() == rhs.get();
+}
+
+template <typename T, typename D, typename U, typename E>
+constexpr bool operator!=(const UniquePtr<T, D> &lhs,
+                          const UniquePtr<U, E> &rhs) noexcept {
+    return lhs.get() != rhs.get();
+}
+
+template <typename T, typename D>
+constexpr bool operator==(const UniquePtr<T, D> &lhs,
+                          std::nullptr_t) noexcept {
+    return !lhs;
+}
+
+template <typename T, typename D>
+constexpr bool operator==(std::nullptr_t,
+                          const UniquePtr<T, D> &rhs) noexcept {
+    return !rhs;
+}
+
+template <typename T, typename D>
+constexpr bool operator!=(const UniquePtr<T, D> &lhs,
+                          std::nullptr_t) noexcept {
+    return static_cast<bool>(lhs);
+}
+
+template <typename T, typename D>
+constexpr bool operator!=(std::nullptr_t,
+                          const UniquePtr<T, D> &rhs) noexcept {
+    return static_cast<bool>(rhs);
+}
+
+template <typename T, typename ...Args,
+          typename = std::enable_if_t<!std::is_array_v<T>>>
+UniquePtr<T> make_unique(Args &&...args) {
+    return UniquePtr<T>{ new T(std::forward<Args>(args)...) };
+}
+
+// value-initializes every element, like std::make_unique<T[]>
+template <typename T,
+          typename = std::enable_if_t<std::is_array_v<T>
+                                      && std::extent_v<T> == 0>>
+UniquePtr<T> make_unique(std::size_t size) {
+    return UniquePtr<T>{ new std::remove_extent_t<T>[size]() };
+}
+
+template <typename T,
+          typename = std::enable_if_t<!std::is_array_v<T>>>
+UniquePtr<T> make_unique_for_overwrite() {
+    return UniquePtr<T>{ new T };
+}
+
+// default-initializes every element, so arrays of trivial types are not
+// zero filled
+template <typename T,
+          typename = std::enable_if_t<std::is_array_v<T>
+                                      && std::extent_v<T> == 0>>
+UniquePtr<T> make_unique_for_overwrite(std::size_t size) {
+    return UniquePtr<T>{ new std::remove_extent_t<T>[size] };
+}
+
+template <typename T, typename Deleter>
+struct is_trivially_relocatable<UniquePtr<T, Deleter>>
+: std::bool_constant<is_trivially_relocatable_v<Deleter>
+                     && is_trivially_relocatable_v<
+                         typename UniquePtr<T, Deleter>::pointer
+                     >> { };
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,682 @@
+#ifndef GREGJM_VECTOR_HPP
+#define GREGJM_VECTOR_HPP
+
+#include "pair.hpp"
+#include "relocate.hpp"
+#include "uninitialized.hpp"
+
+#include <algorithm> // std::equal, std::max, std::min, std::move
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <initializer_list>
+#include <iterator> // std::reverse_iterator, std::iterator_traits
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator, std::allocator_traits
+#include <new> // ::new
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <type_traits>
+#include <utility> // std::forward, std::move, std::move_if_noexcept
+
+namespace gregjm {
+namespace detail {
+
+// raw storage for N elements of T, left uninitialized on construction
+template <typename T, std::size_t N>
+struct InlineBuffer {
+    alignas(T) unsigned char bytes[N * sizeof(T)];
+
+    T* data() noexcept {
+        return reinterpret_cast<T*>(bytes);
+    }
+
+    const T* data() const noexcept {
+        return reinterpret_cast<const T*>(bytes);
+    }
+};
+
+template <typename T>
+struct InlineBuffer<T, 0> {
+    constexpr T* data() const noexcept {
+        return nullptr;
+    }
+};
+
+template <typename It>
+using IteratorCategoryT = typename std::iterator_traits<It>::iterator_category;
+
+template <typename It, typename Category, typename = void>
+struct IsIteratorOf : std::false_type { };
+
+template <typename It, typename Category>
+struct IsIteratorOf<It, Category, std::void_t<IteratorCategoryT<It>>>
+: std::is_base_of<Category, IteratorCategoryT<It>> { };
+
+template <typename It, typename Category>
+static constexpr inline bool is_iterator_of_v =
+    IsIteratorOf<It, Category>::value;
+
+} // namespace detail
+
+// a contiguous sequence container. the allocator shares a Pair with the
+// begin pointer, so a stateless allocator adds no space and Vector<T> is
+// three pointers wide, while stateful allocators such as arenas still work.
+//
+// growth moves trivially relocatable elements with a single memcpy. with
+// InlineCapacity > 0, up to that many elements are stored inside the Vector
+// itself before anything is allocated; such a Vector is not trivially
+// relocatable, since its begin pointer may point into itself.
+//
+// Allocator must use raw pointers
+template <typename T, typename Allocator = std::allocator<T>,
+          std::size_t InlineCapacity = 0>
+class Vector {
+private:
+    using Traits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename Traits::value_type, T>,
+                  "Allocator::value_type must be T");
+    static_assert(std::is_same_v<typename Traits::pointer, T*>,
+                  "Allocator::pointer must be T*");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr inline size_type inline_capacity = InlineCapacity;
+
+    Vector() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+    : Vector(Allocator()) { }
+
+    explicit Vector(const Allocator &alloc) noexcept
+    : alloc_and_begin_(alloc, nullptr), size_{ 0 },
+      capacity_and_buffer_(uninitialized) {
+        begin_ptr() = inline_data();
+        capacity_ref() = InlineCapacity;
+    }
+
+    // value-initializes count elements, or default-initializes them when
+    // Allocator is a DefaultInitAllocator
+    explicit Vector(size_type count, const Allocator &alloc = Allocator())
+    : Vector(alloc) {
+        resize(count);
+    }
+
+    Vector(size_type count, const T &value,
+           const Allocator &alloc = Allocator())
+    : Vector(alloc) {
+        resize(count, value);
+    }
+
+    template <typename InputIt,
+              typename = std::enable_if_t<
+                  detail::is_iterator_of_v<InputIt, std::input_iterator_tag>
+              >>
+    Vector(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+    : Vector(alloc) {
+        append(first, last);
+    }
+
+    Vector(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+    : Vector(init.begin(), init.end(), alloc) { }
+
+    Vector(const Vector &other)
+    : Vector(Traits::select_on_container_copy_construction(
+          other.allocator()
+      )) {
+        append(other.begin(), other.end());
+    }
+
+    Vector(Vector &&other)
+    noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)
+    : Vector(other.allocator()) {
+        take_contents(other);
+    }
+
+    ~Vector() {
+        clear();
+        release_storage();
+    }
+
+    Vector& operator=(const Vector &other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (Traits::propagate_on_container_copy_assignment::value) {
+            if (allocator() != other.allocator()) {
+                clear();
+                release_storage();
+            }
+
+            allocator() = other.allocator();
+        }
+
+        assign(other.begin(), other.end());
+
+        return *this;
+    }
+
+    Vector& operator=(Vector &&other)
+    noexcept((Traits::propagate_on_container_move_assignment::value
+              || Traits::is_always_equal::value)
+             && (InlineCapacity == 0
+                 || std::is_nothrow_move_constructible_v<T>)) {
+        if (this == &other) {
+            return *this;
+        }
+
+        clear();
+
+        if constexpr (Traits::propagate_on_container_move_assignment::value) {
+            release_storage();
+            allocator() = std::move(other.allocator());
+            take_contents(other);
+        } else if (allocator() == other.allocator()) {
+            release_storage();
+            take_contents(other);
+        } else {
+            append(std::make_move_iterator(other.begin()),
+                   std::make_move_iterator(other.end()));
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    Vector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+
+        return *this;
+    }
+
+    template <typename InputIt,
+              typename = std::enable_if_t<
+                  detail::is_iterator_of_v<InputIt, std::input_iterator_tag>
+              >>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        append(first, last);
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator();
+    }
+
+    T& operator[](size_type index) noexcept {
+        return data()[index];
+    }
+
+    const T& operator[](size_type index) const noexcept {
+        return data()[index];
+    }
+
+    T& at(size_type index) {
+        check_index(index);
+
+        return data()[index];
+    }
+
+    const T& at(size_type index) const {
+        check_index(index);
+
+        return data()[index];
+    }
+
+    T& front() noexcept {
+        return data()[0];
+    }
+
+    const T& front() const noexcept {
+        return data()[0];
+    }
+
+    T& back() noexcept {
+        return data()[size_ - 1];
+    }
+
+    const T& back() const noexcept {
+        return data()[size_ - 1];
+    }
+
+    T* data() noexcept {
+        return alloc_and_begin_.second();
+    }
+
+    const T* data() const noexcept {
+        return alloc_and_begin_.second();
+    }
+
+    iterator begin() noexcept {
+        return data();
+    }
+
+    const_iterator begin() const noexcept {
+        return data();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return data();
+    }
+
+    iterator end() noexcept {
+        return data() + size_;
+    }
+
+    const_iterator end() const noexcept {
+        return data() + size_;
+    }
+
+    const_iterator cend() const noexcept {
+        return data() + size_;
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator{ end() };
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator{ end() };
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator{ begin() };
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator{ begin() };
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    size_type capacity() const noexcept {
+        return capacity_and_buffer_.first();
+    }
+
+    size_type max_size() const noexcept {
+        return std::min<size_type>(
+            Traits::max_size(allocator()),
+            static_cast<size_type>(std::numeric_limits<difference_type>::max())
+                / sizeof(T)
+        );
+    }
+
+    // true while the elements live in the inline buffer
+    bool is_inline() const noexcept {
+        if constexpr (InlineCapacity == 0) {
+            return false;
+        } else {
+            return data() == capacity_and_buffer_.second().data();
+        }
+    }
+
+    void reserve(size_type new_capacity) {
+        if (new_capacity > capacity()) {
+            if (new_capacity > max_size()) {
+                throw std::length_error{ "gregjm::Vector::reserve" };
+            }
+
+            reallocate(new_capacity);
+        }
+    }
+
+    void clear() noexcept {
+        destroy(data(), data() + size_);
+        size_ = 0;
+    }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    template <typename ...Args>
+    T& emplace_back(Args &&...args) {
+        if (size_ == capacity()) {
+            return grow_and_emplace_back(std::forward<Args>(args)...);
+        }
+
+        T *const slot = data() + size_;
+        Traits::construct(allocator(), slot, std::forward<Args>(args)...);
+        ++size_;
+
+        return *slot;
+    }
+
+    void pop_back() noexcept {
+        --size_;
+        Traits::destroy(allocator(), data() + size_);
+    }
+
+    iterator erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T *const begin_erase = data() + (first - cbegin());
+        T *const end_erase = data() + (last - cbegin());
+
+        T *const new_end = std::move(end_erase, end(), begin_erase);
+        destroy(new_end, end());
+        size_ = static_cast<size_type>(new_end - data());
+
+        return begin_erase;
+    }
+
+    void resize(size_type count) {
+        if (count <= size_) {
+            truncate(count);
+        } else {
+            reserve(count);
+            construct_back(count - size_);
+        }
+    }
+
+    void resize(size_type count, const T &value) {
+        if (count <= size_) {
+            truncate(count);
+        } else if (count > capacity()) {
+            // value may refer to an element that reallocation would move
+            const T copy = value;
+
+            reserve(count);
+            construct_back(count - size_, copy);
+        } else {
+            construct_back(count - size_, value);
+        }
+    }
+
+    // ensures there is room for count more elements and returns a pointer
+    // to the uninitialized storage that follows the last element. for bulk
+    // ingest, write up to count elements there and then publish them with
+    // append_uninitialized. only for trivially default constructible T,
+    // whose elements can be published without constructing them again
+    T* reserve_uninitialized(size_type count) {
+        static_assert(std::is_trivially_default_constructible_v<T>,
+                      "use emplace_back for T with a nontrivial default "
+                      "constructor");
+
+        reserve_back(count);
+
+        return data() + size_;
+    }
+
+    // grows the vector by count elements without writing to them and
+    // returns a pointer to the first of them, so values stored through
+    // reserve_uninitialized are kept
+    T* append_uninitialized(size_type count) {
+        static_assert(std::is_trivially_default_constructible_v<T>,
+                      "use emplace_back for T with a nontrivial default "
+                      "constructor");
+
+        reserve_back(count);
+
+        T *const first = data() + size_;
+        size_ += count;
+
+        return first;
+    }
+
+    void swap(Vector &other)
+    noexcept((Traits::propagate_on_container_swap::value
+              || Traits::is_always_equal::value)
+             && (InlineCapacity == 0
+                 || std::is_nothrow_move_constructible_v<T>)) {
+        if (is_inline() || other.is_inline()) {
+            Vector temp = std::move(other);
+            other = std::move(*this);
+            *this = std::move(temp);
+
+            return;
+        }
+
+        using std::swap;
+
+        if constexpr (Traits::propagate_on_container_swap::value) {
+            swap(alloc_and_begin_, other.alloc_and_begin_);
+        } else {
+            swap(begin_ptr(), other.begin_ptr());
+        }
+
+        swap(size_, other.size_);
+        swap(capacity_ref(), other.capacity_ref());
+    }
+
+private:
+    Allocator& allocator() noexcept {
+        return alloc_and_begin_.first();
+    }
+
+    const Allocator& allocator() const noexcept {
+        return alloc_and_begin_.first();
+    }
+
+    T*& begin_ptr() noexcept {
+        return alloc_and_begin_.second();
+    }
+
+    size_type& capacity_ref() noexcept {
+        return capacity_and_buffer_.first();
+    }
+
+    T* inline_data() noexcept {
+        return capacity_and_buffer_.second().data();
+    }
+
+    void check_index(size_type index) const {
+        if (index >= size_) {
+            throw std::out_of_range{ "gregjm::Vector::at" };
+        }
+    }
+
+    void destroy(T *first, T *last) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (; first != last; ++first) {
+                Traits::destroy(allocator(), first);
+            }
+        }
+    }
+
+    void truncate(size_type count) noexcept {
+        destroy(data() + count, data() + size_);
+        size_ = count;
+    }
+
+    size_type next_capacity(size_type required) const {
+        const size_type max = max_size();
+
+        if (required > max) {
+            throw std::length_error{ "gregjm::Vector" };
+        }
+
+        if (capacity() > max / 2) {
+            return max;
+        }
+
+        return std::max({ required, 2 * capacity(), size_type{ 4 } });
+    }
+
+    // like reserve(size() + count), but grows geometrically
+    void reserve_back(size_type count) {
+        if (count > capacity() - size_) {
+            if (count > max_size() - size_) {
+                throw std::length_error{ "gregjm::Vector" };
+            }
+
+            reallocate(next_capacity(size_ + count));
+        }
+    }
+
+    template <typename ...Args>
+    void construct_back(size_type count, const Args &...args) {
+        for (size_type i = 0; i < count; ++i) {
+            Traits::construct(allocator(), data() + size_, args...);
+            ++size_;
+        }
+    }
+
+    template <typename InputIt>
+    void append(InputIt first, InputIt last) {
+        if constexpr (detail::is_iterator_of_v<InputIt,
+                                               std::forward_iterator_tag>) {
+            const auto count = std::distance(first, last);
+            reserve_back(static_cast<size_type>(count));
+        }
+
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    // moves the elements into dest, which has room for at least size()
+    // elements, and destroys the originals. if a move throws, both ranges
+    // are left as they were
+    void relocate_elements(T *dest) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            relocate(data(), data() + size_, dest);
+        } else {
+            size_type constructed = 0;
+
+            try {
+                for (; constructed < size_; ++constructed) {
+                    Traits::construct(allocator(), dest + constructed,
+                                      std::move_if_noexcept(
+                                          data()[constructed]
+                                      ));
+                }
+            } catch (...) {
+                destroy(dest, dest + constructed);
+
+                throw;
+            }
+
+            destroy(data(), data() + size_);
+        }
+    }
+
+    void release_storage() noexcept {
+        if (!is_inline() && data() != nullptr) {
+            Traits::deallocate(allocator(), data(), capacity());
+        }
+
+        begin_ptr() = inline_data();
+        capacity_ref() = InlineCapacity;
+    }
+
+    void adopt_storage(T *new_begin, size_type new_capacity) noexcept {
+        release_storage();
+        begin_ptr() = new_begin;
+        capacity_ref() = new_capacity;
+    }
+
+    void reallocate(size_type new_capacity) {
+        T *const new_begin = Traits::allocate(allocator(), new_capacity);
+
+        try {
+            relocate_elements(new_begin);
+        } catch (...) {
+            Traits::deallocate(allocator(), new_begin, new_capacity);
+
+            throw;
+        }
+
+        adopt_storage(new_begin, new_capacity);
+    }
+
+    // the new element is constructed before the old ones are moved, since
+    // args may refer to one of them
+    template <typename ...Args>
+    T& grow_and_emplace_back(Args &&...args) {
+        const size_type new_capacity = next_capacity(size_ + 1);
+        T *const new_begin = Traits::allocate(allocator(), new_capacity);
+        T *const slot = new_begin + size_;
+
+        try {
+            Traits::construct(allocator(), slot, std::forward<Args>(args)...);
+        } catch (...) {
+            Traits::deallocate(allocator(), new_begin, new_capacity);
+
+            throw;
+        }
+
+        try {
+            relocate_elements(new_begin);
+        } catch (...) {
+            Traits::destroy(allocator(), slot);
+            Traits::deallocate(allocator(), new_begin, new_capacity);
+
+            throw;
+        }
+
+        adopt_storage(new_begin, new_capacity);
+        ++size_;
+
+        return *slot;
+    }
+
+    // other must use an allocator equal to ours and this must be empty and
+    // hold no allocation
+    void take_contents(Vector &other) {
+        if (other.is_inline()) {
+            other.relocate_elements(inline_data());
+            size_ = other.size_;
+            other.size_ = 0;
+        } else {
+            begin_ptr() = other.begin_ptr();
+            size_ = other.size_;
+            capacity_ref() = other.capacity();
+
+            other.begin_ptr() = other.inline_data();
+            other.size_ = 0;
+            other.capacity_ref() = InlineCapacity;
+        }
+    }
+
+    Pair<Allocator, T*> alloc_and_begin_;
+    size_type size_;
+    Pair<size_type, detail::InlineBuffer<T, InlineCapacity>>
+        capacity_and_buffer_;
+};
+
+template <typename T, typename A, std::size_t N>
+void swap(Vector<T, A, N> &lhs, Vector<T, A, N> &rhs)
+noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <typename T, typename A, std::size_t N, typename B, std::size_t M>
+bool operator==(const Vector<T, A, N> &lhs, const Vector<T, B, M> &rhs) {
+    return lhs.size() == rhs.size()
+           && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename A, std::size_t N, typename B, std::size_t M>
+bool operator!=(const Vector<T, A, N> &lhs, const Vector<T, B, M> &rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Allocator, std::size_t InlineCapacity>
+struct is_trivially_relocatable<Vector<T, Allocator, InlineCapacity>>
+: std::bool_constant<InlineCapacity == 0
+                     && is_trivially_relocatable_v<Allocator>> { };
+
+} // namespace gregjm
+
+#endif
@@ -0,0 +1,239 @@
+#ifndef GREGJM_ZIP_HPP
+#define GREGJM_ZIP_HPP
+
+#include "pair.hpp"
+
+#include <algorithm> // std::min
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <iterator> // std::iterator_traits, std::next, std::size
+#include <type_traits>
+#include <utility> // std::move, std::declval
+
+namespace gregjm {
+namespace detail {
+
+template <typename Iter>
+using IteratorReferenceT = typename std::iterator_traits<Iter>::reference;
+
+template <typename Iter>
+using IteratorValueTypeT = typename std::iterator_traits<Iter>::value_type;
+
+template <typename Iter>
+using IteratorCategoryT =
+    typename std::iterator_traits<Iter>::iterator_category;
+
+// iterates over two ranges in step. dereferencing yields a Pair of the two
+// iterators' references, which assigns and swaps through to the ranges, so
+// sorting the zipped range sorts both ranges together. only the first
+// iterator is compared, so both must be advanced from matching positions
+template <typename Iter1, typename Iter2>
+class ZipIterator {
+public:
+    using iterator_category = std::common_type_t<IteratorCategoryT<Iter1>,
+                                                 IteratorCategoryT<Iter2>>;
+    using value_type = Pair<IteratorValueTypeT<Iter1>,
+                            IteratorValueTypeT<Iter2>>;
+    using difference_type = std::ptrdiff_t;
+    using reference = Pair<IteratorReferenceT<Iter1>,
+                           IteratorReferenceT<Iter2>>;
+    using pointer = ArrowProxy<reference>;
+
+    static_assert(std::is_reference_v<IteratorReferenceT<Iter1>>
+                  && std::is_reference_v<IteratorReferenceT<Iter2>>,
+                  "ZipIterator needs iterators that dereference to "
+                  "references");
+
+    constexpr ZipIterator() = default;
+
+    constexpr ZipIterator(Iter1 first, Iter2 second)
+    noexcept(std::is_nothrow_move_constructible_v<Iter1>
+             && std::is_nothrow_move_constructible_v<Iter2>)
+    : first_{ std::move(first) }, second_{ std::move(second) } { }
+
+    template <typename I1, typename I2,
+              typename = std::enable_if_t<std::is_convertible_v<I1, Iter1>
+                                          && std::is_convertible_v<I2,
+                                                                   Iter2>>>
+    constexpr ZipIterator(const ZipIterator<I1, I2> &other)
+    : first_{ other.first_ }, second_{ other.second_ } { }
+
+    constexpr Iter1 first() const {
+        return first_;
+    }
+
+    constexpr Iter2 second() const {
+        return second_;
+    }
+
+    constexpr reference operator*() const {
+        return reference{ *first_, *second_ };
+    }
+
+    constexpr pointer operator->() const {
+        return pointer{ **this };
+    }
+
+    constexpr reference operator[](difference_type offset) const {
+        return *(*this + offset);
+    }
+
+    constexpr ZipIterator& operator+=(difference_type offset) {
+        first_ += offset;
+        second_ += offset;
+
+        return *this;
+    }
+
+    constexpr ZipIterator& operator-=(difference_type offset) {
+        return *this += -offset;
+    }
+
+    constexpr ZipIterator& operator++() {
+        ++first_;
+        ++second_;
+
+        return *this;
+    }
+
+    constexpr ZipIterator operator++(int) {
+        const ZipIterator previous = *this;
+        ++*this;
+
+        return previous;
+    }
+
+    constexpr ZipIterator& operator--() {
+        --first_;
+        --second_;
+
+        return *this;
+    }
+
+    constexpr ZipIterator operator--(int) {
+        const ZipIterator previous = *this;
+        --*this;
+
+        return previous;
+    }
+
+    friend constexpr ZipIterator operator+(ZipIterator iter,
+                                           difference_type offset) {
+        return iter += offset;
+    }
+
+    friend constexpr ZipIterator operator+(difference_type offset,
+                                           ZipIterator iter) {
+        return iter += offset;
+    }
+
+    friend constexpr ZipIterator operator-(ZipIterator iter,
+                                           difference_type offset) {
+        return iter -= offset;
+    }
+
+    friend constexpr difference_type operator-(const ZipIterator &lhs,
+                                               const ZipIterator &rhs) {
+        return static_cast<difference_type>(lhs.first_ - rhs.first_);
+    }
+
+    friend constexpr bool operator==(const ZipIterator &lhs,
+                                     const ZipIterator &rhs) {
+        return lhs.first_ == rhs.first_;
+    }
+
+    friend constexpr bool operator!=(const ZipIterator &lhs,
+                                     const ZipIterator &rhs) {
+        return lhs.first_ != rhs.first_;
+    }
+
+    friend constexpr bool operator<(const ZipIterator &lhs,
+                                    const ZipIterator &rhs) {
+        return lhs.first_ < rhs.first_;
+    }
+
+    friend constexpr bool operator<=(const ZipIterator &lhs,
+                                     const ZipIterator &rhs) {
+        return lhs.first_ <= rhs.first_;
+    }
+
+    friend constexpr bool operator>(const ZipIterator &lhs,
+                                    const ZipIterator &rhs) {
+        return lhs.first_ > rhs.first_;
+    }
+
+    friend constexpr bool operator>=(const ZipIterator &lhs,
+                                     const ZipIterator &rhs) {
+        return lhs.first_ >= rhs.first_;
+    }
+
+private:
+    template <typename I1, typename I2>
+    friend class ZipIterator;
+
+    Iter1 first_{ };
+    Iter2 second_{ };
+};
+
+template <typename Range>
+using RangeIteratorT = decltype(std::begin(std::declval<Range&>()));
+
+} // namespace detail
+
+// a view of two ranges as one range of Pair<T&, U&>, as long as the shorter
+// of the two. the view refers to the ranges and does not own them, so they
+// must outlive it
+template <typename Range1, typename Range2>
+class ZipView {
+public:
+    using iterator = detail::ZipIterator<detail::RangeIteratorT<Range1>,
+                                         detail::RangeIteratorT<Range2>>;
+    using value_type = typename iterator::value_type;
+    using reference = typename iterator::reference;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr ZipView(Range1 &first, Range2 &second)
+    : size_{ std::min<size_type>(std::size(first), std::size(second)) },
+      begin_{ std::begin(first), std::begin(second) },
+      end_{ std::next(std::begin(first),
+                      static_cast<difference_type>(size_)),
+            std::next(std::begin(second),
+                      static_cast<difference_type>(size_)) } { }
+
+    constexpr iterator begin() const {
+        return begin_;
+    }
+
+    constexpr iterator end() const {
+        return end_;
+    }
+
+    constexpr size_type size() const noexcept {
+        return size_;
+    }
+
+    constexpr bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr reference operator[](size_type index) const {
+        return begin_[static_cast<difference_type>(index)];
+    }
+
+private:
+    size_type size_;
+    iterator begin_;
+    iterator end_;
+};
+
+// zips two sized ranges, such as arrays, std::vectors or Spans. the
+// elements are not copied; assigning or swapping the view's elements writes
+// to both ranges
+template <typename Range1, typename Range2>
+constexpr ZipView<Range1, Range2> zip(Range1 &first, Range2 &second) {
+    return ZipView<Range1, Range2>{ first, second };
+}
+
+} // namespace gregjm
+
+#endif